@@ -12,6 +12,7 @@
 
 #include <iterator>
 #include <vector>
+#include <string>
 #include <algorithm>
 
 #include <boost/config.hpp>
@@ -182,28 +183,124 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         void output(T const& /*value*/) {}
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  The character type used to buffer output. If we know which character
+    //  type the underlying sink stores we buffer exactly that type (anything
+    //  wider would be truncated by the sink anyway). Otherwise the buffer has
+    //  to be wide enough for any character.
+    ///////////////////////////////////////////////////////////////////////////
+
+    // wchar_t is only 16-bits on Windows. If BOOST_SPIRIT_UNICODE is
+    // defined, the character type is 32-bits wide so we need to make
+    // sure the buffer is at least that wide.
+#if (defined(_WIN32) || defined(__CYGWIN__)) && defined(BOOST_SPIRIT_UNICODE)
+    typedef spirit::char_encoding::unicode::char_type wide_buffer_char_type;
+#else
+    typedef wchar_t wide_buffer_char_type;
+#endif
+
+    template <typename Char>
+    struct select_buffer_char
+    {
+        typedef wide_buffer_char_type type;
+    };
+
+    template <>
+    struct select_buffer_char<char>
+    {
+        typedef char type;
+    };
+
+    template <>
+    struct select_buffer_char<wchar_t>
+    {
+        typedef wchar_t type;
+    };
+
+    template <typename OutputIterator>
+    struct buffer_char_type
+    {
+        typedef wide_buffer_char_type type;
+    };
+
+    template <typename T>
+    struct buffer_char_type<T*>
+      : select_buffer_char<T> {};
+
+    template <typename Container>
+    struct buffer_char_type<std::back_insert_iterator<Container> >
+      : select_buffer_char<typename Container::value_type> {};
+
+    template <typename Elem, typename Traits>
+    struct buffer_char_type<std::ostreambuf_iterator<Elem, Traits> >
+      : select_buffer_char<Elem> {};
+
+    // ostream iterators convert everything to T before streaming it
+    template <typename T, typename Elem, typename Traits>
+    struct buffer_char_type<std::ostream_iterator<T, Elem, Traits> >
+      : select_buffer_char<T> {};
+
+    template <typename T, typename Elem, typename Traits>
+    struct buffer_char_type<karma::ostream_iterator<T, Elem, Traits> >
+      : select_buffer_char<T> {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  A small stack of released buffers kept by the output iterator, so that
+    //  buffering directives applied over and over again (alignment for each
+    //  element of a list, for instance) reuse the memory of the previous
+    //  buffer instead of allocating their own.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Char>
+    class buffer_pool
+    {
+    public:
+        typedef std::basic_string<Char> buffer_type;
+
+        buffer_pool() : count(0) {}
+
+        // buffers are never shared between iterators
+        buffer_pool(buffer_pool const&) : count(0) {}
+        buffer_pool& operator=(buffer_pool const&) { return *this; }
+
+        void acquire(buffer_type& buffer)
+        {
+            if (count != 0)
+                buffer.swap(spare[--count]);
+        }
+
+        void release(buffer_type& buffer)
+        {
+            buffer.clear();
+            if (count != max_spare_buffers)
+                spare[count++].swap(buffer);
+        }
+
+    private:
+        enum { max_spare_buffers = 4 };
+
+        buffer_type spare[max_spare_buffers];
+        std::size_t count;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     //  The following classes are used to intercept the output into a buffer
     //  allowing to do things like alignment, character escaping etc.
     ///////////////////////////////////////////////////////////////////////////
+    template <typename Char>
     class buffer_sink : boost::noncopyable
     {
-       // wchar_t is only 16-bits on Windows. If BOOST_SPIRIT_UNICODE is
-       // defined, the character type is 32-bits wide so we need to make
-       // sure the buffer is at least that wide.
-#if (defined(_WIN32) || defined(__CYGWIN__)) && defined(BOOST_SPIRIT_UNICODE)
-       typedef spirit::char_encoding::unicode::char_type buffer_char_type;
-#else
-       typedef wchar_t buffer_char_type;
-#endif
+        typedef std::basic_string<Char> buffer_type;
 
     public:
-        buffer_sink()
-          : width(0) {}
+        explicit buffer_sink(buffer_pool<Char>& pool_)
+          : width(0), pool(pool_)
+        {
+            pool.acquire(buffer);
+        }
 
         ~buffer_sink() 
         {
-            tidy(); 
+            pool.release(buffer);
         }
 
         void enable(std::size_t width_) 
@@ -222,8 +319,10 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         template <typename T>
         void output(T const& value)
         {
-            BOOST_STATIC_ASSERT(sizeof(T) <= sizeof(buffer_char_type));
-            buffer.push_back(value);
+            // a narrow buffer is only used for a sink storing the same
+            // narrow characters
+            BOOST_STATIC_ASSERT(sizeof(T) <= sizeof(wide_buffer_char_type));
+            buffer.push_back(static_cast<Char>(value));
         }
 
         template <typename OutputIterator_>
@@ -233,7 +332,7 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 #pragma warning(push)
 #pragma warning(disable: 4267)
 #endif
-            typename std::basic_string<buffer_char_type>::const_iterator end = 
+            typename buffer_type::const_iterator end = 
                 buffer.begin() + (std::min)(buffer.size(), maxwidth);
 
 #if defined(BOOST_MSVC)
@@ -249,7 +348,7 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 #pragma warning(push)
 #pragma warning(disable: 4267)
 #endif
-            typename std::basic_string<buffer_char_type>::const_iterator begin = 
+            typename buffer_type::const_iterator begin = 
                 buffer.begin() + (std::min)(buffer.size(), start_at);
 
 #if defined(BOOST_MSVC)
@@ -266,20 +365,25 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 
     private:
         std::size_t width;
-        std::basic_string<buffer_char_type> buffer;
+        buffer_type buffer;
+        buffer_pool<Char>& pool;
     };
 
     ///////////////////////////////////////////////////////////////////////////
+    template <typename Char>
     struct buffering_policy
     {
     public:
+        typedef buffer_sink<Char> buffer_sink_type;
+
         buffering_policy() : buffer(NULL) {}
-        buffering_policy(buffering_policy const& rhs) : buffer(rhs.buffer) {}
+        buffering_policy(buffering_policy const& rhs) 
+          : buffer(rhs.buffer), pool(rhs.pool) {}
 
         // functions related to buffering
-        buffer_sink* chain_buffering(buffer_sink* buffer_data)
+        buffer_sink_type* chain_buffering(buffer_sink_type* buffer_data)
         {
-            buffer_sink* prev_buffer = buffer;
+            buffer_sink_type* prev_buffer = buffer;
             buffer = buffer_data;
             return prev_buffer;
         }
@@ -297,8 +401,11 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 
         bool has_buffer() const { return NULL != buffer; }
 
+        buffer_pool<Char>& get_buffer_pool() { return pool; }
+
     private:
-        buffer_sink* buffer;
+        buffer_sink_type* buffer;
+        buffer_pool<Char> pool;
     };
 
     struct no_buffering_policy
@@ -392,7 +499,9 @@ namespace boost { namespace spirit { namespace karma { namespace detail
 
         typedef typename mpl::if_c<
             (properties & generator_properties::buffering) ? true : false
-          , buffering_policy, no_buffering_policy
+          , buffering_policy<
+                typename buffer_char_type<OutputIterator>::type>
+          , no_buffering_policy
         >::type buffering_type;
 
         typedef typename mpl::if_c<
@@ -548,7 +657,8 @@ namespace boost { namespace spirit { namespace karma { namespace detail
     {
         enable_buffering(OutputIterator& sink_
               , std::size_t width = std::size_t(-1))
-          : sink(sink_), prev_buffer(NULL), enabled(false)
+          : sink(sink_), buffer_data(sink_.get_buffer_pool())
+          , prev_buffer(NULL), enabled(false)
         {
             buffer_data.enable(width);
             prev_buffer = sink.chain_buffering(&buffer_data);
@@ -599,9 +709,11 @@ namespace boost { namespace spirit { namespace karma { namespace detail
         }
 
     private:
+        typedef typename OutputIterator::buffer_sink_type buffer_sink_type;
+
         OutputIterator& sink;
-        buffer_sink buffer_data;    // for buffering
-        buffer_sink* prev_buffer;   // previous buffer in chain
+        buffer_sink_type buffer_data;   // for buffering
+        buffer_sink_type* prev_buffer;  // previous buffer in chain
         bool enabled;
     };
 
@@ -16,6 +16,8 @@
 
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
 #include <boost/spirit/home/support/char_class.hpp>
 #include <boost/spirit/home/support/unused.hpp>
 #include <boost/spirit/home/support/numeric_traits.hpp>
@@ -562,6 +564,59 @@ namespace boost { namespace spirit { namespace traits
 
 namespace boost { namespace spirit { namespace karma
 {
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        //  The decimal representations of 00 .. 99, used to generate two
+        //  decimal digits per division.
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Dummy = void>
+        struct decimal_digit_pairs
+        {
+            static char const table[201];
+        };
+
+        template <typename Dummy>
+        char const decimal_digit_pairs<Dummy>::table[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        // number of decimal digits of n (at least one)
+        template <typename T>
+        inline int count_decimal_digits(T n)
+        {
+            int count = 1;
+            for (;;)
+            {
+                if (n < 10)
+                    return count;
+                if (n < 100)
+                    return count + 1;
+                if (n < 1000)
+                    return count + 2;
+                if (n < 10000)
+                    return count + 3;
+                n /= 10000u;
+                count += 4;
+            }
+        }
+
+        // radix 10 output of integral types uses decimal_digit_pairs
+        template <unsigned Radix, typename T>
+        struct use_decimal_digit_pairs
+          : mpl::bool_<Radix == 10 && is_integral<T>::value
+              && !is_same<T, bool>::value>
+        {};
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     //
     //  The int_inserter template takes care of the integer to string
@@ -622,10 +677,60 @@ namespace boost { namespace spirit { namespace karma
         template <typename OutputIterator, typename T>
         static bool
         call(OutputIterator& sink, T n)
+        {
+            return call(sink, n
+              , detail::use_decimal_digit_pairs<Radix, T>());
+        }
+
+        template <typename OutputIterator, typename T>
+        static bool
+        call(OutputIterator& sink, T n, mpl::false_)
         {
             return call(sink, n, n, 0);
         }
 
+        //  Radix 10 integers: the number of digits is known up front, so
+        //  the digits are put into a buffer back to front two at a time,
+        //  and then written to the sink in order.
+        template <typename OutputIterator, typename T>
+        static bool
+        call(OutputIterator& sink, T n, mpl::true_)
+        {
+            typedef typename make_unsigned<T>::type unsigned_type;
+            typedef detail::decimal_digit_pairs<> digit_pairs;
+
+            unsigned_type u = static_cast<unsigned_type>(n);
+            int const digits = detail::count_decimal_digits(u);
+
+            // at most 3 decimal digits per byte
+            char buffer[sizeof(unsigned_type) * 3];
+            char* p = buffer + digits;
+            while (u >= 100)
+            {
+                unsigned const i = static_cast<unsigned>(u % 100) * 2;
+                u /= 100;
+                *--p = digit_pairs::table[i + 1];
+                *--p = digit_pairs::table[i];
+            }
+            if (u >= 10)
+            {
+                unsigned const i = static_cast<unsigned>(u) * 2;
+                *--p = digit_pairs::table[i + 1];
+                *--p = digit_pairs::table[i];
+            }
+            else
+            {
+                *--p = char('0' + u);
+            }
+
+            for (int i = 0; i != digits; ++i)
+            {
+                *sink = buffer[i];
+                ++sink;
+            }
+            return true;
+        }
+
     private:
         // helper function returning the biggest number representable either in
         // a boost::long_long_type (if this does exist) or in a plain long
@@ -653,7 +758,7 @@ namespace boost { namespace spirit { namespace karma
             if (std::fabs(n) < max_long())
             {
                 biggest_long_type l((biggest_long_type)n);
-                return call(sink, l, l, 0);
+                return call(sink, l);
             }
             return call(sink, n, n, 0);
         }
@@ -664,7 +769,7 @@ namespace boost { namespace spirit { namespace karma
             if (std::fabs(n) < max_long())
             {
                 biggest_long_type l((biggest_long_type)n);
-                return call(sink, l, l, 0);
+                return call(sink, l);
             }
             return call(sink, n, n, 0);
         }
@@ -675,7 +780,7 @@ namespace boost { namespace spirit { namespace karma
             if (std::fabs(n) < max_long())
             {
                 biggest_long_type l((biggest_long_type)n);
-                return call(sink, l, l, 0);
+                return call(sink, l);
             }
             return call(sink, n, n, 0);
         }
@@ -704,7 +809,7 @@ namespace boost { namespace spirit { namespace karma
         {
             typedef typename traits::absolute_value<T>::type type;
             type un = type(n);
-            return base_type::call(sink, un, un, 0);
+            return base_type::call(sink, un);
         }
     };
 
@@ -14,6 +14,9 @@
 #include <boost/config/no_tr1/cmath.hpp>
 #include <boost/detail/workaround.hpp>
 #include <boost/limits.hpp>
+#include <boost/mpl/bool.hpp>
+
+#include <algorithm>
 
 #include <boost/spirit/home/support/char_class.hpp>
 #include <boost/spirit/home/support/unused.hpp>
@@ -22,6 +25,7 @@
 #include <boost/spirit/home/karma/detail/generate_to.hpp>
 #include <boost/spirit/home/karma/detail/string_generate.hpp>
 #include <boost/spirit/home/karma/numeric/detail/numeric_utils.hpp>
+#include <boost/spirit/home/karma/numeric/detail/shortest_real.hpp>
 
 namespace boost { namespace spirit { namespace karma 
 { 
@@ -182,6 +186,124 @@ namespace boost { namespace spirit { namespace karma
             return r;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        //  Generate the shortest decimal representation which reads back
+        //  as the same value (see shortest_real_policies). The layout
+        //  follows call_n: the policies decide about the sign, the format,
+        //  the dot and the exponent, but all significant digits are
+        //  generated, regardless of precision() and trailing_zeros().
+        //  The digits are written directly, bypassing integer_part() and
+        //  fraction_part(): these take the parts as values of type U,
+        //  which cannot hold all the digits exactly.
+        ///////////////////////////////////////////////////////////////////////
+        template <typename OutputIterator, typename U>
+        static bool
+        call_shortest (OutputIterator& sink, U n, Policies const& p)
+        {
+            return call_shortest(sink, n, p, detail::has_shortest_decimal<U>());
+        }
+
+        template <typename OutputIterator, typename U>
+        static bool
+        call_shortest (OutputIterator& sink, U n, Policies const& p, mpl::false_)
+        {
+            // no shortest conversion for this type, use the precision
+            return call_n(sink, n, p);
+        }
+
+        template <typename OutputIterator, typename U>
+        static bool
+        call_shortest (OutputIterator& sink, U n, Policies const& p, mpl::true_)
+        {
+            bool force_sign = p.force_sign(n);
+            bool sign_val = traits::test_negative(n);
+            int flags = p.floatfield(n);
+            if (sign_val)
+                n = -n;
+
+        // get the significant digits, most significant first
+            char digits[20];
+            int ndigits = 0;
+            int dim = 0;
+            if (traits::test_zero(n))
+            {
+                digits[ndigits++] = '0';
+                sign_val = false;     // result is zero, no sign please
+                force_sign = false;
+            }
+            else
+            {
+                boost::uint64_t value;
+                int exp;
+                detail::shortest_decimal(n, value, exp);
+                for (/**/; value != 0; value /= 10)
+                    digits[ndigits++] = char('0' + value % 10);
+                for (int i = 0; i < ndigits / 2; ++i)
+                    std::swap(digits[i], digits[ndigits - 1 - i]);
+                dim = exp + ndigits - 1;     // n == d.ddd * 10^dim
+            }
+
+        // split the digits into the integer and the fractional part, the
+        // positions are relative to the first significant digit
+            int int_digits = 1;         // digits before the dot
+            int leading_zeros = 0;      // zeros after the dot
+            if (Policies::fmtflags::fixed & flags)
+            {
+                if (dim >= 0)
+                    int_digits = dim + 1;
+                else
+                {
+                    int_digits = 0;
+                    leading_zeros = -dim - 1;
+                }
+            }
+            int const frac_digits = (std::max)(ndigits - int_digits, 0);
+
+        // generate sign and integer part
+            bool r = sign_inserter::call(sink, int_digits == 0 ||
+                traits::test_zero(n), sign_val, force_sign, force_sign);
+            if (r && int_digits == 0)
+            {
+                *sink = '0';
+                ++sink;
+            }
+            for (int i = 0; r && i < int_digits; ++i)
+            {
+                *sink = i < ndigits ? digits[i] : '0';
+                ++sink;
+            }
+
+        // generate decimal point, passing the fractional digits and their
+        // number as the precision
+            unsigned const precision = unsigned(leading_zeros + frac_digits);
+            U frac_part = 0;
+            for (int i = int_digits; i < ndigits; ++i)
+                frac_part = frac_part * 10 + (digits[i] - '0');
+            r = r && p.dot(sink, frac_part, precision == 0 ? 1 : precision);
+
+        // generate fractional part, at least one digit
+            if (r && precision == 0)
+            {
+                *sink = '0';
+                ++sink;
+            }
+            for (int i = 0; r && i < leading_zeros; ++i)
+            {
+                *sink = '0';
+                ++sink;
+            }
+            for (int i = int_digits; r && i < ndigits; ++i)
+            {
+                *sink = digits[i];
+                ++sink;
+            }
+
+            if (r && 0 == (Policies::fmtflags::fixed & flags)) {
+                return p.template exponent<CharEncoding, Tag>(sink, long(dim));
+            }
+            return r;
+        }
+
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1400)
 # pragma warning(pop)
 #endif 
@@ -0,0 +1,282 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_KARMA_SHORTEST_REAL_OCT_17_2026_0310PM)
+#define BOOST_SPIRIT_KARMA_SHORTEST_REAL_OCT_17_2026_0310PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/spirit/home/karma/numeric/detail/pow10_significands.hpp>
+#include <cstring>
+
+#if defined(BOOST_MSVC) && defined(_M_X64)
+# include <intrin.h>
+#endif
+
+namespace boost { namespace spirit { namespace karma { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Shortest round trip conversion of float and double to decimal.
+    //
+    //  shortest_decimal(n, digits, exponent) finds the decimal number
+    //  digits * 10^exponent with the fewest significant digits that reads
+    //  back as n (n must be finite and greater than zero). If there are
+    //  several, it picks the one closest to n. The digits have no trailing
+    //  zeros.
+    //
+    //  This is R. Giulietti's Schubfach algorithm: it needs only a few
+    //  multiplications by a 128-bit approximation of a power of ten, no
+    //  loops over the digits and no big integers.
+    //
+    //  See R. Giulietti, "The Schubfach way to render doubles", 2020.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct has_shortest_decimal : mpl::false_ {};
+
+    template <>
+    struct has_shortest_decimal<float> : mpl::true_ {};
+
+    template <>
+    struct has_shortest_decimal<double> : mpl::true_ {};
+
+    // floor(log2(10^e)) for e in [-1233, 1233]
+    inline int floor_log2_pow10(int e)
+    {
+        return (e * 1741647) >> 19;
+    }
+
+    // floor(log10(2^e)) for e in [-2620, 2620]
+    inline int floor_log10_pow2(int e)
+    {
+        return (e * 1262611) >> 22;
+    }
+
+    // floor(log10(3/4 * 2^e)) for e in [-2985, 2936]
+    inline int floor_log10_three_quarters_pow2(int e)
+    {
+        return (e * 1262611 - 524031) >> 22;
+    }
+
+    inline void multiply_64x64(boost::uint64_t a, boost::uint64_t b
+      , boost::uint64_t& high, boost::uint64_t& low)
+    {
+#if defined(BOOST_HAS_INT128)
+        boost::uint128_type const p = boost::uint128_type(a) * b;
+        high = boost::uint64_t(p >> 64);
+        low = boost::uint64_t(p);
+#elif defined(BOOST_MSVC) && defined(_M_X64)
+        low = _umul128(a, b, &high);
+#else
+        boost::uint64_t const a_lo = a & 0xffffffffu, a_hi = a >> 32;
+        boost::uint64_t const b_lo = b & 0xffffffffu, b_hi = b >> 32;
+        boost::uint64_t const lo_lo = a_lo * b_lo;
+        boost::uint64_t const hi_lo = a_hi * b_lo;
+        boost::uint64_t const lo_hi = a_lo * b_hi;
+        boost::uint64_t const hi_hi = a_hi * b_hi;
+        boost::uint64_t const cross =
+            (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+        high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        low = (cross << 32) | (lo_lo & 0xffffffffu);
+#endif
+    }
+
+    // The integer part of g * cp / 2^128, with its lowest bit set if the
+    // result is inexact (g is the 128-bit g1:g0).
+    inline boost::uint64_t round_to_odd(
+        boost::uint64_t g1, boost::uint64_t g0, boost::uint64_t cp)
+    {
+        boost::uint64_t x1, x0, y1, y0;
+        multiply_64x64(g0, cp, x1, x0);
+        multiply_64x64(g1, cp, y1, y0);
+        boost::uint64_t const z = y0 + x1;
+        y1 += (z < y0); // carry
+        return y1 | (z > 1);
+    }
+
+    // The integer part of g * cp / 2^64, with its lowest bit set if the
+    // result is inexact. As cp < 2^32, the error of g only shows in the
+    // lower half of the fraction.
+    inline boost::uint32_t round_to_odd(boost::uint64_t g, boost::uint32_t cp)
+    {
+        boost::uint64_t y1, y0;
+        multiply_64x64(g, cp, y1, y0);
+        return boost::uint32_t(y1 | ((y0 >> 32) > 1));
+    }
+
+    // The two halves of the Schubfach search: given the scaled bounds of
+    // the rounding interval [lower, upper] and the scaled value vb (all
+    // four times the decimal value at 10^k), pick the shortest decimal
+    // inside the interval.
+    template <typename UInt>
+    inline void shortest_in_interval(UInt vb, UInt lower, UInt upper, int k
+      , boost::uint64_t& digits, int& exponent)
+    {
+        UInt const s = vb / 4;
+        if (s >= 10)
+        {
+            // try one digit less first
+            UInt const sp = s / 10;
+            bool const u_inside = lower <= 40 * sp;
+            bool const w_inside = 40 * sp + 40 <= upper;
+            if (u_inside != w_inside)
+            {
+                digits = w_inside ? sp + 1 : sp;
+                exponent = k + 1;
+                return;
+            }
+        }
+
+        bool const u_inside = lower <= 4 * s;
+        bool const w_inside = 4 * s + 4 <= upper;
+        if (u_inside != w_inside)
+        {
+            digits = w_inside ? s + 1 : s;
+            exponent = k;
+            return;
+        }
+
+        // both s and s + 1 are inside: take the closer one (or the even
+        // one if there is a tie)
+        UInt const mid = 4 * s + 2;
+        bool const round_up = vb > mid || (vb == mid && (s & 1) != 0);
+        digits = round_up ? s + 1 : s;
+        exponent = k;
+    }
+
+    inline void remove_trailing_zeros(boost::uint64_t& digits, int& exponent)
+    {
+        while (digits % 10 == 0)
+        {
+            digits /= 10;
+            ++exponent;
+        }
+    }
+
+    inline void shortest_decimal(double n
+      , boost::uint64_t& digits, int& exponent)
+    {
+        typedef pow10_significands_128<> pow10;
+
+        boost::uint64_t bits;
+        std::memcpy(&bits, &n, sizeof(bits));
+        boost::uint64_t const significand = bits & ((boost::uint64_t(1) << 52) - 1);
+        int const biased_exponent = int(bits >> 52) & 0x7ff;
+
+        boost::uint64_t c;
+        int q;
+        if (biased_exponent != 0)
+        {
+            c = significand | (boost::uint64_t(1) << 52);
+            q = biased_exponent - 1075;
+
+            // small integers are their own shortest representation
+            if (q <= 0 && -q < 53 && (c & ((boost::uint64_t(1) << -q) - 1)) == 0)
+            {
+                digits = c >> -q;
+                exponent = 0;
+                remove_trailing_zeros(digits, exponent);
+                return;
+            }
+        }
+        else
+        {
+            c = significand;
+            q = 1 - 1075;
+        }
+
+        bool const is_even = (c % 2) == 0;
+        bool const lower_boundary_is_closer = significand == 0 && biased_exponent > 1;
+
+        boost::uint64_t const cbl = 4 * c - 2 + lower_boundary_is_closer;
+        boost::uint64_t const cb = 4 * c;
+        boost::uint64_t const cbr = 4 * c + 2;
+
+        int const k = lower_boundary_is_closer
+          ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+        int const h = q + floor_log2_pow10(-k) + 1;
+
+        int const index = 2 * (-k - pow10::smallest_power);
+        boost::uint64_t const g1 = pow10::table[index];
+        boost::uint64_t const g0 = pow10::table[index + 1];
+
+        boost::uint64_t const vbl = round_to_odd(g1, g0, cbl << h);
+        boost::uint64_t const vb = round_to_odd(g1, g0, cb << h);
+        boost::uint64_t const vbr = round_to_odd(g1, g0, cbr << h);
+
+        // the bounds belong to the interval if the significand is even
+        boost::uint64_t const lower = vbl + !is_even;
+        boost::uint64_t const upper = vbr - !is_even;
+
+        shortest_in_interval(vb, lower, upper, k, digits, exponent);
+        remove_trailing_zeros(digits, exponent);
+    }
+
+    inline void shortest_decimal(float n
+      , boost::uint64_t& digits, int& exponent)
+    {
+        typedef pow10_significands_128<> pow10;
+
+        boost::uint32_t bits;
+        std::memcpy(&bits, &n, sizeof(bits));
+        boost::uint32_t const significand = bits & ((boost::uint32_t(1) << 23) - 1);
+        int const biased_exponent = int(bits >> 23) & 0xff;
+
+        boost::uint32_t c;
+        int q;
+        if (biased_exponent != 0)
+        {
+            c = significand | (boost::uint32_t(1) << 23);
+            q = biased_exponent - 150;
+
+            // small integers are their own shortest representation
+            if (q <= 0 && -q < 24 && (c & ((boost::uint32_t(1) << -q) - 1)) == 0)
+            {
+                digits = c >> -q;
+                exponent = 0;
+                remove_trailing_zeros(digits, exponent);
+                return;
+            }
+        }
+        else
+        {
+            c = significand;
+            q = 1 - 150;
+        }
+
+        bool const is_even = (c % 2) == 0;
+        bool const lower_boundary_is_closer = significand == 0 && biased_exponent > 1;
+
+        boost::uint32_t const cbl = 4 * c - 2 + lower_boundary_is_closer;
+        boost::uint32_t const cb = 4 * c;
+        boost::uint32_t const cbr = 4 * c + 2;
+
+        int const k = lower_boundary_is_closer
+          ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+        int const h = q + floor_log2_pow10(-k) + 1;
+
+        // floor(10^-k * 2^-r) + 1 with r normalizing to [2^63, 2^64): the
+        // upper half of the 128-bit entry, rounded up
+        int const index = 2 * (-k - pow10::smallest_power);
+        boost::uint64_t const g =
+            pow10::table[index] + (pow10::table[index + 1] != 0);
+
+        boost::uint32_t const vbl = round_to_odd(g, cbl << h);
+        boost::uint32_t const vb = round_to_odd(g, cb << h);
+        boost::uint32_t const vbr = round_to_odd(g, cbr << h);
+
+        boost::uint32_t const lower = vbl + !is_even;
+        boost::uint32_t const upper = vbr - !is_even;
+
+        shortest_in_interval(vb, lower, upper, k, digits, exponent);
+        remove_trailing_zeros(digits, exponent);
+    }
+}}}}
+
+#endif
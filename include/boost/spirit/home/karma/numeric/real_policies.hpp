@@ -329,6 +329,40 @@ namespace boost { namespace spirit { namespace karma
                    string_inserter<CharEncoding, Tag>::call(sink, "inf");
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //
+    //  shortest_real_policies generate the shortest decimal representation
+    //  of a float or double that reads back as exactly the same value,
+    //  e.g. 0.1 for 0.1 and 1.0000000000000002 for the double following
+    //  1.0, with no need to pick a precision() up front:
+    //
+    //      typedef 
+    //          karma::real_generator<double, shortest_real_policies<double> > 
+    //      shortest_type;
+    //
+    //      karma::generate(sink, shortest_type(), 0.3); // will output: 0.3
+    //
+    //  The digits are computed with integer arithmetic only, which is
+    //  faster than the default conversion as well. All other
+    //  functions (sign, format, dot, exponent, nan and inf) are used as 
+    //  for real_policies and may be overloaded the same way. precision(),
+    //  trailing_zeros(), integer_part() and fraction_part() are bypassed
+    //  for float and double: the digits are written directly, as the
+    //  parts passed to these may not hold all of them exactly. Other
+    //  types are generated as for real_policies.
+    //
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct shortest_real_policies : real_policies<T>
+    {
+        template <typename Inserter, typename OutputIterator, typename Policies>
+        static bool
+        call (OutputIterator& sink, T n, Policies const& p)
+        {
+            return Inserter::call_shortest(sink, n, p);
+        }
+    };
 }}}
 
 #endif // defined(BOOST_SPIRIT_KARMA_REAL_POLICIES_MAR_02_2007_0936AM)
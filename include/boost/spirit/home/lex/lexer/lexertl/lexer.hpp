@@ -15,6 +15,7 @@
 #include <boost/spirit/home/support/detail/lexer/generator.hpp>
 #include <boost/spirit/home/support/detail/lexer/rules.hpp>
 #include <boost/spirit/home/support/detail/lexer/consts.hpp>
+#include <boost/spirit/home/support/detail/lexer/serialise.hpp>
 #include <boost/spirit/home/support/unused.hpp>
 
 #include <boost/spirit/home/lex/lexer/lexertl/token.hpp>
@@ -349,6 +350,34 @@ namespace boost { namespace spirit { namespace lex { namespace lexertl
             return true;
         }
 
+        //  Write the state machine (building it first, if needed) as a
+        //  binary image, to be handed to load_dfa() by a later run of the
+        //  same lexer, sparing it the DFA construction. The image is
+        //  tagged with a hash of the token definitions.
+        bool save_dfa(std::ostream& os, bool minimize = false) const
+        {
+            if (!init_dfa(minimize))
+                return false;
+            boost::lexer::save_binary(state_machine_
+              , boost::lexer::hash_rules(rules_), os);
+            return os.good();
+        }
+
+        //  Use the state machine stored in [data, data + size), for
+        //  instance a mapped file written by save_dfa(). Returns false,
+        //  leaving the lexer to build its DFA as usual, if the image was
+        //  written for different token definitions or another platform.
+        bool load_dfa(void const* data, std::size_t size) const
+        {
+            if (!boost::lexer::load_binary(data, size
+                  , boost::lexer::hash_rules(rules_), state_machine_))
+            {
+                return false;
+            }
+            initialized_dfa_ = true;
+            return true;
+        }
+
     private:
         // lexertl specific data
         mutable boost::lexer::basic_state_machine<char_type> state_machine_;
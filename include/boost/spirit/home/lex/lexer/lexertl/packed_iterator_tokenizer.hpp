@@ -0,0 +1,212 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_LEXERTL_PACKED_ITERATOR_TOKENISER_OCT_17_2026_0900PM)
+#define BOOST_SPIRIT_LEXERTL_PACKED_ITERATOR_TOKENISER_OCT_17_2026_0900PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/lex/lexer/lexertl/packed_state_machine.hpp>
+#include <boost/spirit/home/support/detail/lexer/consts.hpp>
+#include <boost/spirit/home/support/detail/lexer/size_t.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <iterator> // for std::iterator_traits
+
+namespace boost { namespace spirit { namespace lex { namespace lexertl
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  basic_packed_iterator_tokeniser has the same interface and matching
+    //  semantics as basic_iterator_tokeniser, but runs on the tables of a
+    //  basic_packed_state_machine. It is meant for narrow character input,
+    //  typically char const*.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename Index = boost::uint16_t>
+    class basic_packed_iterator_tokeniser
+    {
+    public:
+        typedef typename std::iterator_traits<Iterator>::value_type char_type;
+        typedef basic_packed_state_machine<char_type, Index> state_machine_type;
+
+        static std::size_t next (state_machine_type const& state_machine_
+          , std::size_t &dfa_state_, bool& bol_, Iterator &start_token_
+          , Iterator const& end_, std::size_t& unique_id_)
+        {
+            bool bol = bol_;
+
+        again:
+            if (start_token_ == end_)
+            {
+                unique_id_ = boost::lexer::npos;
+                return 0;
+            }
+
+            Iterator end_token_ = start_token_;
+            bool end_bol_ = bol;
+            accept_type const* accept_ = match(state_machine_
+              , state_machine_.dfa(dfa_state_), bol, start_token_, end_
+              , end_token_, end_bol_);
+
+            if (accept_) {
+                // return longest match
+                dfa_state_ = accept_->state;
+                start_token_ = end_token_;
+
+                if (accept_->id == 0)
+                {
+                    bol = end_bol_;
+                    goto again;
+                }
+
+                bol_ = end_bol_;
+                unique_id_ = accept_->unique_id;
+                return accept_->id;
+            }
+
+            bol_ = (*start_token_ == '\n') ? true : false;
+            unique_id_ = boost::lexer::npos;
+            return boost::lexer::npos;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static std::size_t next (state_machine_type const& state_machine_
+          , bool& bol_, Iterator &start_token_, Iterator const& end_
+          , std::size_t& unique_id_)
+        {
+            if (start_token_ == end_)
+            {
+                unique_id_ = boost::lexer::npos;
+                return 0;
+            }
+
+            Iterator end_token_ = start_token_;
+            bool end_bol_ = bol_;
+            accept_type const* accept_ = match(state_machine_
+              , state_machine_.dfa(0), bol_, start_token_, end_
+              , end_token_, end_bol_);
+
+            if (accept_) {
+                // return longest match
+                bol_ = end_bol_;
+                start_token_ = end_token_;
+                unique_id_ = accept_->unique_id;
+                return accept_->id;
+            }
+
+            bol_ = *start_token_ == '\n';
+            unique_id_ = boost::lexer::npos;
+            return boost::lexer::npos;
+        }
+
+    private:
+        typedef typename state_machine_type::dfa_type dfa_type;
+        typedef typename state_machine_type::accept_type accept_type;
+
+        // Run the DFA from start_token_ and return the longest match, or 0
+        // if there is none. On a match end_token_ and end_bol_ are set to
+        // the end of the match and the BOL flag at that point.
+        static accept_type const* match(state_machine_type const& state_machine_
+          , dfa_type const& dfa_, bool bol, Iterator const& start_token_
+          , Iterator const& end_, Iterator& end_token_, bool& end_bol_)
+        {
+            unsigned char const* classes_ = dfa_.classes;
+            Index const* table_ = &dfa_.table.front();
+            accept_type const* accepts_ = &dfa_.accepts.front();
+            Index const* ptr_ = table_ + dfa_.start;
+
+            accept_type const* accept_ = 0;
+            if (ptr_[state_machine_type::accept_index])
+                accept_ = accepts_ + ptr_[state_machine_type::accept_index];
+
+            Iterator curr_ = start_token_;
+
+            if (!state_machine_.seen_BOL_assertion() &&
+                !state_machine_.seen_EOL_assertion())
+            {
+                // no assertions: a single table lookup per character
+                while (curr_ != end_)
+                {
+                    unsigned char const ch = static_cast<unsigned char>(*curr_);
+                    Index const next_ = ptr_[
+                        state_machine_type::header_size + classes_[ch]];
+
+                    if (next_ == 0)
+                    {
+                        break;
+                    }
+
+                    ++curr_;
+                    ptr_ = table_ + next_;
+
+                    if (ptr_[state_machine_type::accept_index])
+                    {
+                        accept_ = accepts_ +
+                            ptr_[state_machine_type::accept_index];
+                        end_bol_ = ch == '\n';
+                        end_token_ = curr_;
+                    }
+                }
+                return accept_;
+            }
+
+            while (curr_ != end_)
+            {
+                Index const BOL_state_ = ptr_[state_machine_type::bol_index];
+                Index const EOL_state_ = ptr_[state_machine_type::eol_index];
+
+                if (BOL_state_ && bol)
+                {
+                    ptr_ = table_ + BOL_state_;
+                }
+                else if (EOL_state_ && *curr_ == '\n')
+                {
+                    ptr_ = table_ + EOL_state_;
+                }
+                else
+                {
+                    unsigned char const ch =
+                        static_cast<unsigned char>(*curr_++);
+                    bol = (ch == '\n') ? true : false;
+                    Index const next_ = ptr_[
+                        state_machine_type::header_size + classes_[ch]];
+
+                    if (next_ == 0)
+                    {
+                        break;
+                    }
+
+                    ptr_ = table_ + next_;
+                }
+
+                if (ptr_[state_machine_type::accept_index])
+                {
+                    accept_ = accepts_ + ptr_[state_machine_type::accept_index];
+                    end_bol_ = bol;
+                    end_token_ = curr_;
+                }
+            }
+
+            Index const EOL_state_ = ptr_[state_machine_type::eol_index];
+
+            if (EOL_state_ && curr_ == end_)
+            {
+                ptr_ = table_ + EOL_state_;
+
+                if (ptr_[state_machine_type::accept_index])
+                {
+                    accept_ = accepts_ + ptr_[state_machine_type::accept_index];
+                    end_bol_ = bol;
+                    end_token_ = curr_;
+                }
+            }
+            return accept_;
+        }
+    };
+
+}}}}
+
+#endif
@@ -0,0 +1,209 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_LEXERTL_PACKED_STATE_MACHINE_OCT_17_2026_0900PM)
+#define BOOST_SPIRIT_LEXERTL_PACKED_STATE_MACHINE_OCT_17_2026_0900PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/support/detail/lexer/state_machine.hpp>
+#include <boost/spirit/home/support/detail/lexer/consts.hpp>
+#include <boost/spirit/home/support/detail/lexer/size_t.hpp>
+#include <boost/spirit/home/support/detail/lexer/runtime_error.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace boost { namespace spirit { namespace lex { namespace lexertl
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  basic_packed_state_machine is a compact runtime representation of a
+    //  boost::lexer::basic_state_machine for narrow characters.
+    //
+    //  For every lexer state the input bytes are mapped to character classes
+    //  through a 256 byte table. The transitions are stored row by row in a
+    //  single vector of Index (16 or 32 bit) entries. Every row starts with
+    //  a small header (accepting info, BOL and EOL transitions) followed by
+    //  one entry per character class. Transition targets are stored as the
+    //  offset of the target row, so following a transition does not need a
+    //  multiplication. An offset of 0 denotes the dead state.
+    //
+    //  Packing throws a boost::lexer::runtime_error if the tables of a lexer
+    //  state do not fit into Index.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Char, typename Index = boost::uint16_t>
+    class basic_packed_state_machine
+    {
+        BOOST_STATIC_ASSERT(sizeof(Char) == 1);
+
+    public:
+        typedef Char char_type;
+        typedef Index index_type;
+
+        // layout of the header of each row
+        enum { accept_index, bol_index, eol_index, header_size };
+
+        struct accept_type
+        {
+            std::size_t id;
+            std::size_t unique_id;
+            std::size_t state;
+        };
+
+        struct dfa_type
+        {
+            unsigned char classes[boost::lexer::num_chars];
+            std::vector<Index> table;
+            std::vector<accept_type> accepts;   // accepts[0] is unused
+            std::size_t start;                  // offset of the start row
+        };
+
+        basic_packed_state_machine()
+          : seen_BOL_assertion_(false), seen_EOL_assertion_(false) {}
+
+        explicit basic_packed_state_machine(
+                boost::lexer::basic_state_machine<Char> const& state_machine_)
+          : seen_BOL_assertion_(false), seen_EOL_assertion_(false)
+        {
+            pack(state_machine_);
+        }
+
+        void pack(boost::lexer::basic_state_machine<Char> const& state_machine_)
+        {
+            boost::lexer::detail::internals const& internals_ =
+                state_machine_.data();
+            std::size_t const states_ = internals_._dfa->size();
+
+            std::vector<dfa_type> packed_dfas_(states_);
+            for (std::size_t i = 0; i != states_; ++i)
+            {
+                pack_dfa(*internals_._lookup[i], internals_._dfa_alphabet[i]
+                  , *internals_._dfa[i], packed_dfas_[i]);
+            }
+
+            dfas_.swap(packed_dfas_);
+            seen_BOL_assertion_ = internals_._seen_BOL_assertion;
+            seen_EOL_assertion_ = internals_._seen_EOL_assertion;
+        }
+
+        void clear()
+        {
+            dfas_.clear();
+            seen_BOL_assertion_ = false;
+            seen_EOL_assertion_ = false;
+        }
+
+        bool empty() const { return dfas_.empty(); }
+
+        // number of lexer states
+        std::size_t size() const { return dfas_.size(); }
+
+        dfa_type const& dfa(std::size_t state) const { return dfas_[state]; }
+
+        bool seen_BOL_assertion() const { return seen_BOL_assertion_; }
+        bool seen_EOL_assertion() const { return seen_EOL_assertion_; }
+
+    private:
+        typedef std::vector<std::size_t> size_t_vector;
+
+        static void pack_dfa(size_t_vector const& lookup_
+          , std::size_t dfa_alphabet_, size_t_vector const& dfa_
+          , dfa_type& packed_)
+        {
+            using boost::lexer::dead_state_index;
+            using boost::lexer::dfa_offset;
+
+            if (dfa_alphabet_ == 0)
+            {
+                // lexer state without any rules: a dead row and a start row
+                // failing on every character
+                std::fill(packed_.classes
+                  , packed_.classes + boost::lexer::num_chars, 0);
+                packed_.table.assign(2 * (header_size + 1), 0);
+                packed_.accepts.resize(1);
+                packed_.start = header_size + 1;
+                return;
+            }
+
+            // The dead state column is 0 in every row. It only needs a class
+            // of its own if some characters map to it, which keeps the number
+            // of classes at or below 256.
+            std::size_t base_ = dfa_offset;
+            for (std::size_t c = 0; c != boost::lexer::num_chars; ++c)
+            {
+                if (lookup_[c] == dead_state_index)
+                {
+                    base_ = dead_state_index;
+                    break;
+                }
+            }
+
+            for (std::size_t c = 0; c != boost::lexer::num_chars; ++c)
+            {
+                packed_.classes[c] =
+                    static_cast<unsigned char>(lookup_[c] - base_);
+            }
+
+            std::size_t const classes_ = dfa_alphabet_ - base_;
+            std::size_t const width_ = header_size + classes_;
+            std::size_t const rows_ = dfa_.size() / dfa_alphabet_;
+
+            if ((rows_ - 1) * width_ > boost::integer_traits<Index>::const_max ||
+                rows_ > boost::integer_traits<Index>::const_max)
+            {
+                throw boost::lexer::runtime_error("State machine too large "
+                    "for the index type of basic_packed_state_machine.");
+            }
+
+            packed_.table.assign(rows_ * width_, 0);
+            packed_.accepts.resize(1);
+            packed_.start = width_;
+
+            for (std::size_t r = 0; r != rows_; ++r)
+            {
+                std::size_t const* src_ = &dfa_[r * dfa_alphabet_];
+                Index* dest_ = &packed_.table[r * width_];
+
+                if (src_[boost::lexer::end_state_index])
+                {
+                    accept_type const accept_ = {
+                        src_[boost::lexer::id_index]
+                      , src_[boost::lexer::unique_id_index]
+                      , src_[boost::lexer::state_index]
+                    };
+                    dest_[accept_index] =
+                        static_cast<Index>(packed_.accepts.size());
+                    packed_.accepts.push_back(accept_);
+                }
+
+                dest_[bol_index] = static_cast<Index>(
+                    src_[boost::lexer::bol_index] * width_);
+                dest_[eol_index] = static_cast<Index>(
+                    src_[boost::lexer::eol_index] * width_);
+
+                for (std::size_t c = 0; c != classes_; ++c)
+                {
+                    dest_[header_size + c] =
+                        static_cast<Index>(src_[base_ + c] * width_);
+                }
+            }
+        }
+
+        std::vector<dfa_type> dfas_;
+        bool seen_BOL_assertion_;
+        bool seen_EOL_assertion_;
+    };
+
+    typedef basic_packed_state_machine<char> packed_state_machine;
+    typedef basic_packed_state_machine<char, boost::uint32_t>
+        packed_state_machine32;
+
+}}}}
+
+#endif
@@ -15,7 +15,7 @@
 #include <boost/spirit/home/qi/nonterminal/rule.hpp>
 #include <boost/spirit/home/qi/nonterminal/debug_handler_state.hpp>
 #include <boost/spirit/home/qi/detail/expectation_failure.hpp>
-#include <boost/function.hpp>
+#include <boost/spirit/home/qi/nonterminal/detail/rule_function.hpp>
 #include <boost/fusion/include/at.hpp>
 #include <boost/fusion/include/vector.hpp>
 #include <boost/fusion/include/out.hpp>
@@ -28,11 +28,7 @@ namespace boost { namespace spirit { namespace qi
       , typename Skipper, typename F>
     struct debug_handler
     {
-        typedef function<
-            bool(Iterator& first, Iterator const& last
-              , Context& context
-              , Skipper const& skipper
-            )>
+        typedef detail::rule_function<Iterator, Context, Skipper>
         function_type;
 
         debug_handler(
@@ -0,0 +1,241 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_RULE_FUNCTION_OCT_18_2026_0900PM)
+#define BOOST_SPIRIT_RULE_FUNCTION_OCT_18_2026_0900PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/config.hpp>
+#include <boost/core/explicit_operator_bool.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <new>
+
+///////////////////////////////////////////////////////////////////////////////
+//  The size of the buffer a rule keeps its parser in. Parsers that do not
+//  fit (deep sequences of many rules, or rules wrapped by on_error and
+//  debug) are kept on the heap instead.
+///////////////////////////////////////////////////////////////////////////////
+#if !defined(BOOST_SPIRIT_QI_RULE_BUFFER_SIZE)
+#define BOOST_SPIRIT_QI_RULE_BUFFER_SIZE 128
+#endif
+
+namespace boost { namespace spirit { namespace qi { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The type erased parser of a rule: a replacement for
+    //
+    //      function<bool(Iterator&, Iterator const&, Context&, Skipper const&)>
+    //
+    //  that keeps the parser in an inline buffer instead of allocating it,
+    //  and is called through a single function pointer stored in the object
+    //  itself.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename Context, typename Skipper>
+    class rule_function
+    {
+        typedef boost::detail::max_align max_align;
+        typedef typename aligned_storage<
+            BOOST_SPIRIT_QI_RULE_BUFFER_SIZE
+          , alignment_of<max_align>::value
+        >::type storage_type;
+
+        typedef bool (*invoke_type)(storage_type const&, Iterator&
+          , Iterator const&, Context&, Skipper const&);
+
+        enum operation { clone_operation, destroy_operation };
+
+        typedef void (*manage_type)(operation
+          , storage_type const& src, storage_type& dst);
+
+        template <typename F>
+        struct fits_buffer
+          : mpl::bool_<
+                sizeof(F) <= sizeof(storage_type) &&
+                alignment_of<max_align>::value % alignment_of<F>::value == 0
+            >
+        {};
+
+        // F kept in the buffer
+        template <typename F, bool Small = fits_buffer<F>::value>
+        struct manager
+        {
+            static F const& get(storage_type const& s)
+            {
+                return *static_cast<F const*>(static_cast<void const*>(&s));
+            }
+
+            static void create(F const& f, storage_type& dst)
+            {
+                new (static_cast<void*>(&dst)) F(f);
+            }
+
+            static bool invoke(storage_type const& s, Iterator& first
+              , Iterator const& last, Context& context
+              , Skipper const& skipper)
+            {
+                return get(s)(first, last, context, skipper);
+            }
+
+            static void manage(operation op
+              , storage_type const& src, storage_type& dst)
+            {
+                if (op == clone_operation)
+                    create(get(src), dst);
+                else
+                    get(dst).~F();
+            }
+        };
+
+        // F kept on the heap, the buffer holds a pointer to it
+        template <typename F>
+        struct manager<F, false>
+        {
+            static F const& get(storage_type const& s)
+            {
+                return **static_cast<F* const*>(static_cast<void const*>(&s));
+            }
+
+            static void create(F const& f, storage_type& dst)
+            {
+                *static_cast<F**>(static_cast<void*>(&dst)) = new F(f);
+            }
+
+            static bool invoke(storage_type const& s, Iterator& first
+              , Iterator const& last, Context& context
+              , Skipper const& skipper)
+            {
+                return get(s)(first, last, context, skipper);
+            }
+
+            static void manage(operation op
+              , storage_type const& src, storage_type& dst)
+            {
+                if (op == clone_operation)
+                    create(get(src), dst);
+                else
+                    delete &get(dst);
+            }
+        };
+
+    public:
+
+        rule_function()
+          : invoke_(0), manage_(0) {}
+
+        rule_function(rule_function const& rhs)
+          : invoke_(0), manage_(0)
+        {
+            assign(rhs);
+        }
+
+        template <typename F>
+        rule_function(F const& f)
+          : invoke_(0), manage_(0)
+        {
+            assign(f);
+        }
+
+        ~rule_function()
+        {
+            clear();
+        }
+
+        rule_function& operator=(rule_function const& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                assign(rhs);
+            }
+            return *this;
+        }
+
+        template <typename F>
+        rule_function& operator=(F const& f)
+        {
+            // f may be a parser wrapping *this (see on_error), so it has
+            // to be copied before *this is cleared
+            rule_function tmp(f);
+            clear();
+            assign(tmp);
+            return *this;
+        }
+
+        bool operator()(Iterator& first, Iterator const& last
+          , Context& context, Skipper const& skipper) const
+        {
+            return invoke_(storage, first, last, context, skipper);
+        }
+
+        bool empty() const
+        {
+            return invoke_ == 0;
+        }
+
+        bool operator!() const
+        {
+            return invoke_ == 0;
+        }
+
+        BOOST_EXPLICIT_OPERATOR_BOOL_NOEXCEPT()
+
+        void clear()
+        {
+            if (manage_)
+            {
+                manage_(destroy_operation, storage, storage);
+                invoke_ = 0;
+                manage_ = 0;
+            }
+        }
+
+        void swap(rule_function& rhs)
+        {
+            rule_function tmp(rhs);
+            rhs = *this;
+            *this = tmp;
+        }
+
+    private:
+
+        void assign(rule_function const& rhs)
+        {
+            if (rhs.manage_)
+            {
+                rhs.manage_(clone_operation, rhs.storage, storage);
+                invoke_ = rhs.invoke_;
+                manage_ = rhs.manage_;
+            }
+        }
+
+        template <typename F>
+        void assign(F const& f)
+        {
+            manager<F>::create(f, storage);
+            invoke_ = &manager<F>::invoke;
+            manage_ = &manager<F>::manage;
+        }
+
+        invoke_type invoke_;
+        manage_type manage_;
+        storage_type storage;
+    };
+
+    template <typename Iterator, typename Context, typename Skipper>
+    inline void swap(rule_function<Iterator, Context, Skipper>& lhs
+      , rule_function<Iterator, Context, Skipper>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}}}}
+
+#endif
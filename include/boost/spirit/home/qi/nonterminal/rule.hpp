@@ -37,6 +37,7 @@
 #include <boost/spirit/home/qi/reference.hpp>
 #include <boost/spirit/home/qi/nonterminal/detail/parameterized.hpp>
 #include <boost/spirit/home/qi/nonterminal/detail/parser_binder.hpp>
+#include <boost/spirit/home/qi/nonterminal/detail/rule_function.hpp>
 #include <boost/spirit/home/qi/nonterminal/nonterminal_fwd.hpp>
 #include <boost/spirit/home/qi/skip_over.hpp>
 
@@ -142,11 +143,8 @@ namespace boost { namespace spirit { namespace qi
           , locals_type>
         context_type;
 
-        typedef function<
-            bool(Iterator& first, Iterator const& last
-              , context_type& context
-              , skipper_type const& skipper
-            )>
+        typedef detail::rule_function<
+            Iterator, context_type, skipper_type>
         function_type;
 
         typedef typename
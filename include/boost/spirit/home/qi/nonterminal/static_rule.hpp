@@ -0,0 +1,270 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_STATIC_RULE_OCT_18_2026_0900PM)
+#define BOOST_SPIRIT_STATIC_RULE_OCT_18_2026_0900PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/spirit/home/qi/nonterminal/rule.hpp>
+
+namespace boost { namespace spirit { namespace qi
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  A rule that keeps its right hand side by type instead of erasing it.
+    //  Calls to a static_rule are direct and can be inlined, but its parser
+    //  is fixed when it is created, so it cannot refer to itself, and its
+    //  type depends on the parser. It is meant for the many small, non
+    //  recursive rules of a grammar:
+    //
+    //      auto const number = qi::make_static_rule<Iterator, int()>(
+    //          int_ | hex_, "number");
+    //
+    //  T1 ... T4 are the signature, skipper, locals and encoding, in any
+    //  order, as for rule. The attribute of the rule is always passed on to
+    //  its parser, as with r %= expr.
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename Iterator, typename Parser, typename T1 = unused_type
+      , typename T2 = unused_type, typename T3 = unused_type
+      , typename T4 = unused_type>
+    struct static_rule
+      : proto::extends<
+            typename proto::terminal<
+                reference<static_rule<Iterator, Parser, T1, T2, T3, T4> const>
+            >::type
+          , static_rule<Iterator, Parser, T1, T2, T3, T4>
+        >
+      , parser<static_rule<Iterator, Parser, T1, T2, T3, T4> >
+    {
+        typedef Iterator iterator_type;
+        typedef static_rule<Iterator, Parser, T1, T2, T3, T4> this_type;
+        typedef reference<this_type const> reference_;
+        typedef typename proto::terminal<reference_>::type terminal;
+        typedef proto::extends<terminal, this_type> base_type;
+
+        // the types of a rule with the same template parameters
+        typedef rule<Iterator, T1, T2, T3, T4> rule_type;
+        typedef typename rule_type::skipper_type skipper_type;
+        typedef typename rule_type::attr_type attr_type;
+        typedef typename rule_type::parameter_types parameter_types;
+        typedef typename rule_type::context_type context_type;
+
+        static size_t const params_size = rule_type::params_size;
+
+        typedef detail::parser_binder<Parser, mpl::true_> binder_type;
+
+        explicit static_rule(Parser const& p
+              , std::string const& name = "unnamed-rule")
+          : base_type(terminal::make(reference_(*this)))
+          , name_(name)
+          , binder(p)
+        {
+        }
+
+        static_rule(static_rule const& rhs)
+          : base_type(terminal::make(reference_(*this)))
+          , name_(rhs.name_)
+          , binder(rhs.binder)
+        {
+        }
+
+        std::string const& name() const
+        {
+            return name_;
+        }
+
+        void name(std::string const& str)
+        {
+            name_ = str;
+        }
+
+        template <typename Context, typename Iterator_>
+        struct attribute
+        {
+            typedef attr_type type;
+        };
+
+        template <typename Context, typename Skipper, typename Attribute>
+        bool parse(Iterator& first, Iterator const& last
+          , Context& /*context*/, Skipper const& skipper
+          , Attribute& attr_param) const
+        {
+            BOOST_STATIC_ASSERT_MSG((is_same<skipper_type, unused_type>::value ||
+                !is_same<Skipper, unused_type>::value),
+                "The rule was instantiated with a skipper type but you have not pass any. "
+                "Did you use `parse` instead of `phrase_parse`?");
+            BOOST_STATIC_ASSERT_MSG(
+                (is_convertible<Skipper const&, skipper_type>::value),
+                "The passed skipper is not compatible/convertible to one "
+                "that the rule was instantiated with");
+
+            // do a preskip if this is an implied lexeme
+            if (is_same<skipper_type, unused_type>::value)
+                qi::skip_over(first, last, skipper);
+
+            typedef traits::make_attribute<attr_type, Attribute> make_attribute;
+            typedef traits::transform_attribute<
+                typename make_attribute::type, attr_type, domain>
+            transform;
+
+            typename make_attribute::type made_attr = make_attribute::call(attr_param);
+            typename transform::type attr_ = transform::pre(made_attr);
+
+            context_type context(attr_);
+            skipper_type const& rule_skipper = skipper;
+
+            if (binder(first, last, context, rule_skipper))
+            {
+                traits::post_transform(attr_param, attr_);
+                return true;
+            }
+
+            traits::fail_transform(attr_param, attr_);
+            return false;
+        }
+
+        template <typename Context, typename Skipper
+          , typename Attribute, typename Params>
+        bool parse(Iterator& first, Iterator const& last
+          , Context& caller_context, Skipper const& skipper
+          , Attribute& attr_param, Params const& params) const
+        {
+            BOOST_STATIC_ASSERT_MSG((is_same<skipper_type, unused_type>::value ||
+                !is_same<Skipper, unused_type>::value),
+                "The rule was instantiated with a skipper type but you have not pass any. "
+                "Did you use `parse` instead of `phrase_parse`?");
+            BOOST_STATIC_ASSERT_MSG(
+                (is_convertible<Skipper const&, skipper_type>::value),
+                "The passed skipper is not compatible/convertible to one "
+                "that the rule was instantiated with");
+
+            // do a preskip if this is an implied lexeme
+            if (is_same<skipper_type, unused_type>::value)
+                qi::skip_over(first, last, skipper);
+
+            typedef traits::make_attribute<attr_type, Attribute> make_attribute;
+            typedef traits::transform_attribute<
+                typename make_attribute::type, attr_type, domain>
+            transform;
+
+            typename make_attribute::type made_attr = make_attribute::call(attr_param);
+            typename transform::type attr_ = transform::pre(made_attr);
+
+            context_type context(attr_, params, caller_context);
+            skipper_type const& rule_skipper = skipper;
+
+            if (binder(first, last, context, rule_skipper))
+            {
+                traits::post_transform(attr_param, attr_);
+                return true;
+            }
+
+            traits::fail_transform(attr_param, attr_);
+            return false;
+        }
+
+        template <typename Context>
+        info what(Context& /*context*/) const
+        {
+            return info(name_);
+        }
+
+        reference_ alias() const
+        {
+            return reference_(*this);
+        }
+
+        // bring in the operator() overloads
+        static_rule const& get_parameterized_subject() const { return *this; }
+        typedef static_rule parameterized_subject_type;
+        #include <boost/spirit/home/qi/nonterminal/detail/fcall.hpp>
+
+        std::string name_;
+        binder_type binder;
+
+    private:
+        // the parser of a static_rule is fixed
+        static_rule& operator=(static_rule const&);
+    };
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace boost { namespace spirit { namespace result_of
+{
+    template <
+        typename Iterator, typename Expr, typename T1 = unused_type
+      , typename T2 = unused_type, typename T3 = unused_type
+      , typename T4 = unused_type>
+    struct make_static_rule
+    {
+        typedef typename
+            qi::rule<Iterator, T1, T2, T3, T4>::encoding_modifier_type
+        encoding_modifier_type;
+
+        typedef typename
+            compile<qi::domain, Expr, encoding_modifier_type>::type
+        parser_type;
+
+        typedef qi::static_rule<Iterator, parser_type, T1, T2, T3, T4> type;
+    };
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace boost { namespace spirit { namespace qi
+{
+#if !defined(BOOST_NO_CXX11_FUNCTION_TEMPLATE_DEFAULT_ARGS)
+    template <
+        typename Iterator, typename T1 = unused_type
+      , typename T2 = unused_type, typename T3 = unused_type
+      , typename T4 = unused_type, typename Expr>
+    inline typename spirit::result_of::make_static_rule<
+        Iterator, Expr, T1, T2, T3, T4>::type
+    make_static_rule(Expr const& expr
+      , std::string const& name = "unnamed-rule")
+    {
+        // Report invalid expression error as early as possible.
+        // If you got an error_invalid_expression error message here,
+        // then the expression (expr) is not a valid spirit qi expression.
+        BOOST_SPIRIT_ASSERT_MATCH(qi::domain, Expr);
+
+        typedef spirit::result_of::make_static_rule<
+            Iterator, Expr, T1, T2, T3, T4>
+        result;
+        typedef typename result::type result_type;
+
+        return result_type(compile<qi::domain>(
+            expr, typename result::encoding_modifier_type()), name);
+    }
+#endif
+}}}
+
+namespace boost { namespace spirit { namespace traits
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename IteratorA, typename IteratorB, typename Attribute
+      , typename Context, typename Parser, typename T1, typename T2
+      , typename T3, typename T4>
+    struct handles_container<
+        qi::static_rule<IteratorA, Parser, T1, T2, T3, T4>
+      , Attribute, Context, IteratorB>
+      : traits::is_container<
+          typename attribute_of<
+              qi::static_rule<IteratorA, Parser, T1, T2, T3, T4>
+            , Context, IteratorB
+          >::type
+        >
+    {};
+}}}
+
+#endif
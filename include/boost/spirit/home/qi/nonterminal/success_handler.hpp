@@ -12,7 +12,7 @@
 #endif
 
 #include <boost/spirit/home/qi/nonterminal/rule.hpp>
-#include <boost/function.hpp>
+#include <boost/spirit/home/qi/nonterminal/detail/rule_function.hpp>
 
 namespace boost { namespace spirit { namespace qi
 {
@@ -22,11 +22,7 @@ namespace boost { namespace spirit { namespace qi
     >
     struct success_handler
     {
-        typedef function<
-            bool(Iterator& first, Iterator const& last
-              , Context& context
-              , Skipper const& skipper
-            )>
+        typedef detail::rule_function<Iterator, Context, Skipper>
         function_type;
 
         success_handler(function_type subject_, F f_)
@@ -12,10 +12,60 @@
 #endif
 
 #include <boost/spirit/home/support/unused.hpp>
+#include <boost/spirit/home/support/detail/skip_ascii_space.hpp>
 #include <boost/spirit/home/qi/detail/unused_skipper.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace boost { namespace spirit
+{
+    namespace char_encoding
+    {
+        struct ascii;
+        struct iso8859_1;
+        struct standard;
+    }
+
+    namespace tag
+    {
+        struct space;
+
+        template <typename CharClass, typename CharEncoding>
+        struct char_code;
+    }
+}}
 
 namespace boost { namespace spirit { namespace qi
 {
+    template <typename Tag>
+    struct char_class;
+
+    namespace detail
+    {
+        // The built-in space classifiers of the narrow char encodings
+        // agree on the ASCII white space characters. On contiguous char
+        // input, those are skipped by a vectorized scan and only non-ASCII
+        // characters are left to the skipper itself (e.g. the locale
+        // dependent standard::space or iso8859_1's no-break space).
+        template <typename CharEncoding>
+        struct is_narrow_space_encoding
+          : mpl::false_ {};
+
+        template <>
+        struct is_narrow_space_encoding<char_encoding::ascii>
+          : mpl::true_ {};
+
+        template <>
+        struct is_narrow_space_encoding<char_encoding::iso8859_1>
+          : mpl::true_ {};
+
+        template <>
+        struct is_narrow_space_encoding<char_encoding::standard>
+          : mpl::true_ {};
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Move the /first/ iterator to the first non-matching position
     // given a skip-parser. The function is a no-op if unused_type is
@@ -28,6 +78,23 @@ namespace boost { namespace spirit { namespace qi
             /***/;
     }
 
+    template <typename Char, typename CharEncoding>
+    inline typename enable_if_c<
+        detail::is_narrow_space_encoding<CharEncoding>::value
+     && is_same<typename remove_cv<Char>::type, char>::value>::type
+    skip_over(Char*& first, Char* const& last
+      , char_class<tag::char_code<tag::space, CharEncoding> > const& skipper)
+    {
+        for (;;)
+        {
+            first += spirit::detail::skip_ascii_space(first, last) - first;
+            if (first == last
+             || static_cast<unsigned char>(*first) < 0x80
+             || !skipper.parse(first, last, unused, unused, unused))
+                break;
+        }
+    }
+
     template <typename Iterator>
     inline void skip_over(Iterator&, Iterator const&, unused_type)
     {
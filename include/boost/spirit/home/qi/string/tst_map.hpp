@@ -13,7 +13,7 @@
 
 #include <boost/spirit/home/qi/string/tst.hpp>
 #include <boost/spirit/home/qi/string/detail/tst.hpp>
-#include <boost/unordered_map.hpp>
+#include <boost/spirit/home/support/detail/tst_root.hpp>
 #include <boost/pool/object_pool.hpp>
 #include <boost/foreach.hpp>
 
@@ -52,19 +52,16 @@ namespace boost { namespace spirit { namespace qi
             if (first != last)
             {
                 Iterator save = first;
-                typename map_type::const_iterator
-                    i = map.find(filter(*first++));
-
-                if (i != map.end())
+                if (map_data const* x = map.find(filter(*first++)))
                 {
-                    if (T* p = node::find(i->second.root, first, last, filter))
+                    if (T* p = node::find(x->root, first, last, filter))
                     {
                         return p;
                     }
-                   
-                    if (i->second.data)
+
+                    if (x->data)
                     {
-                        return i->second.data;
+                        return x->data;
                     }
                 }
                 first = save;
@@ -86,20 +83,18 @@ namespace boost { namespace spirit { namespace qi
         {
             if (first != last)
             {
-                map_data x = {0, 0};
-                std::pair<typename map_type::iterator, bool>
-                    r = map.insert(std::pair<Char, map_data>(*first++, x));
+                map_data& x = map.insert(*first++);
 
                 if (first != last)
                 {
-                    return node::add(r.first->second.root
+                    return node::add(x.root
                       , first, last, val, this) ? true : false;
                 }
                 else
                 {
-                    if (r.first->second.data)
+                    if (x.data)
                         return false;
-                    r.first->second.data = this->new_data(val);
+                    x.data = this->new_data(val);
                 }
                 return true;
             }
@@ -111,21 +106,21 @@ namespace boost { namespace spirit { namespace qi
         {
             if (first != last)
             {
-                typename map_type::iterator i = map.find(*first++);
-                if (i != map.end())
+                Char c = *first++;
+                if (map_data* x = map.find(c))
                 {
                     if (first != last)
                     {
-                        node::remove(i->second.root, first, last, this);
+                        node::remove(x->root, first, last, this);
                     }
-                    else if (i->second.data)
+                    else if (x->data)
                     {
-                        this->delete_data(i->second.data);
-                        i->second.data = 0;
+                        this->delete_data(x->data);
+                        x->data = 0;
                     }
-                    if (i->second.data == 0 && i->second.root == 0)
+                    if (x->data == 0 && x->root == 0)
                     {
-                        map.erase(i);
+                        map.erase(c);
                     }
                 }
             }
@@ -133,11 +128,12 @@ namespace boost { namespace spirit { namespace qi
 
         void clear()
         {
-            BOOST_FOREACH(typename map_type::value_type& x, map)
+            BOOST_FOREACH(Char c, map.keys())
             {
-                node::destruct_node(x.second.root, this);
-                if (x.second.data)
-                    this->delete_data(x.second.data);
+                map_data const& x = *map.find(c);
+                node::destruct_node(x.root, this);
+                if (x.data)
+                    this->delete_data(x.data);
             }
             map.clear();
         }
@@ -145,12 +141,13 @@ namespace boost { namespace spirit { namespace qi
         template <typename F>
         void for_each(F f) const
         {
-            BOOST_FOREACH(typename map_type::value_type const& x, map)
+            BOOST_FOREACH(Char c, map.keys())
             {
-                std::basic_string<Char> s(1, x.first);
-                node::for_each(x.second.root, s, f);
-                if (x.second.data)
-                    f(s, *x.second.data);
+                map_data const& x = *map.find(c);
+                std::basic_string<Char> s(1, c);
+                node::for_each(x.root, s, f);
+                if (x.data)
+                    f(s, *x.data);
             }
         }
 
@@ -158,22 +155,19 @@ namespace boost { namespace spirit { namespace qi
 
         friend struct detail::tst_node<Char, T>;
 
-        struct map_data
-        {
-            node* root;
-            T* data;
-        };
-
-        typedef unordered_map<Char, map_data> map_type;
+        // the roots are indexed by the first character of the keys
+        typedef spirit::detail::tst_root_table<Char, node, T> map_type;
+        typedef typename map_type::slot map_data;
 
         void copy(tst_map const& rhs)
         {
-            BOOST_FOREACH(typename map_type::value_type const& x, rhs.map)
+            BOOST_FOREACH(Char c, rhs.map.keys())
             {
-                map_data xx = {node::clone_node(x.second.root, this), 0};
-                if (x.second.data)
-                    xx.data = data_pool.construct(*x.second.data);
-                map[x.first] = xx;
+                map_data const& x = *rhs.map.find(c);
+                map_data& xx = map.insert(c);
+                xx.root = node::clone_node(x.root, this);
+                if (x.data)
+                    xx.data = data_pool.construct(*x.data);
             }
         }
 
@@ -181,11 +175,7 @@ namespace boost { namespace spirit { namespace qi
         {
             if (this != &rhs)
             {
-                BOOST_FOREACH(typename map_type::value_type& x, map)
-                {
-                    node::destruct_node(x.second.root, this);
-                }
-                map.clear();
+                clear();
                 copy(rhs);
             }
             return *this;
@@ -212,7 +202,7 @@ namespace boost { namespace spirit { namespace qi
         }
 
         map_type map;
-        object_pool<node> node_pool;
+        spirit::detail::tst_node_pool<node> node_pool;
         object_pool<T> data_pool;
     };
 }}}
@@ -0,0 +1,67 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+    http://spirit.sourceforge.net/
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_FIND_LINE_BREAK_OCT_18_2026_1000AM)
+#define SPIRIT_FIND_LINE_BREAK_OCT_18_2026_1000AM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/support/detail/simd.hpp>
+
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Returns the first position in [first, last) that holds a '\r' or a
+    //  '\n', or last, scanning 16 or 32 bytes per step where the target
+    //  supports it.
+    ///////////////////////////////////////////////////////////////////////////
+    inline char const* find_line_break(char const* first, char const* last)
+    {
+#if defined(BOOST_SPIRIT_HAS_AVX2)
+        {
+            __m256i const cr = _mm256_set1_epi8('\r');
+            __m256i const lf = _mm256_set1_epi8('\n');
+            while (last - first >= 32)
+            {
+                __m256i const c = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(first));
+                boost::uint32_t const mask = static_cast<boost::uint32_t>(
+                    _mm256_movemask_epi8(_mm256_or_si256(
+                        _mm256_cmpeq_epi8(c, cr), _mm256_cmpeq_epi8(c, lf))));
+                if (mask)
+                    return first + lowest_bit(mask);
+                first += 32;
+            }
+        }
+#endif
+#if defined(BOOST_SPIRIT_HAS_SSE2)
+        {
+            __m128i const cr = _mm_set1_epi8('\r');
+            __m128i const lf = _mm_set1_epi8('\n');
+            while (last - first >= 16)
+            {
+                __m128i const c = _mm_loadu_si128(
+                    reinterpret_cast<__m128i const*>(first));
+                boost::uint32_t const mask = static_cast<boost::uint32_t>(
+                    _mm_movemask_epi8(_mm_or_si128(
+                        _mm_cmpeq_epi8(c, cr), _mm_cmpeq_epi8(c, lf))));
+                if (mask)
+                    return first + lowest_bit(mask);
+                first += 16;
+            }
+        }
+#endif
+        while (first != last && *first != '\r' && *first != '\n')
+            ++first;
+        return first;
+    }
+}}}
+
+#endif
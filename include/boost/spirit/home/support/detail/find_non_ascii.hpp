@@ -0,0 +1,55 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+    http://spirit.sourceforge.net/
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_FIND_NON_ASCII_OCT_18_2026_1000PM)
+#define SPIRIT_FIND_NON_ASCII_OCT_18_2026_1000PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/support/detail/simd.hpp>
+
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Returns the first position in [first, last) that holds a byte with
+    //  the high bit set, or last, scanning 16 or 32 bytes per step where the
+    //  target supports it.
+    ///////////////////////////////////////////////////////////////////////////
+    inline char const* find_non_ascii(char const* first, char const* last)
+    {
+#if defined(BOOST_SPIRIT_HAS_AVX2)
+        while (last - first >= 32)
+        {
+            boost::uint32_t const mask = static_cast<boost::uint32_t>(
+                _mm256_movemask_epi8(_mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(first))));
+            if (mask)
+                return first + lowest_bit(mask);
+            first += 32;
+        }
+#endif
+#if defined(BOOST_SPIRIT_HAS_SSE2)
+        while (last - first >= 16)
+        {
+            boost::uint32_t const mask = static_cast<boost::uint32_t>(
+                _mm_movemask_epi8(_mm_loadu_si128(
+                    reinterpret_cast<__m128i const*>(first))));
+            if (mask)
+                return first + lowest_bit(mask);
+            first += 16;
+        }
+#endif
+        while (first != last && !(static_cast<unsigned char>(*first) & 0x80))
+            ++first;
+        return first;
+    }
+}}}
+
+#endif
@@ -16,10 +16,22 @@
 #include "parser/tree/node.hpp"
 #include "parser/parser.hpp"
 #include "containers/ptr_list.hpp"
+#include <boost/config.hpp>
 #include <boost/move/unique_ptr.hpp>
 #include "rules.hpp"
 #include "state_machine.hpp"
 
+#if !defined (BOOST_NO_CXX11_HDR_ATOMIC) && \
+    !defined (BOOST_NO_CXX11_HDR_EXCEPTION) && \
+    !defined (BOOST_NO_CXX11_HDR_THREAD)
+#define BOOST_LEXER_HAS_THREADS
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+#endif
+
 namespace boost
 {
 namespace lexer
@@ -34,60 +46,116 @@ public:
     static void build (const rules &rules_,
         basic_state_machine<CharT> &state_machine_)
     {
-        std::size_t index_ = 0;
-        std::size_t size_ = rules_.statemap ().size ();
-        node_ptr_vector node_ptr_vector_;
+        const std::size_t size_ = rules_.statemap ().size ();
         detail::internals &internals_ = const_cast<detail::internals &>
             (state_machine_.data ());
         bool seen_BOL_assertion_ = false;
         bool seen_EOL_assertion_ = false;
 
         state_machine_.clear ();
+        init_machines (size_, internals_);
 
-        for (; index_ < size_; ++index_)
+        for (std::size_t index_ = 0; index_ < size_; ++index_)
         {
-            internals_._lookup->push_back (static_cast<size_t_vector *>(0));
-            internals_._lookup->back () = new size_t_vector;
-            internals_._dfa_alphabet.push_back (0);
-            internals_._dfa->push_back (static_cast<size_t_vector *>(0));
-            internals_._dfa->back () = new size_t_vector;
+            build_state (rules_, index_, false, internals_,
+                seen_BOL_assertion_, seen_EOL_assertion_);
+        }
+
+        internals_._seen_BOL_assertion = seen_BOL_assertion_;
+        internals_._seen_EOL_assertion = seen_EOL_assertion_;
+    }
+
+    // Same as build () followed by minimise () when minimise_ is set, but
+    // the DFAs of the lexer states are built on up to threads_ threads
+    // (0 for one per hardware thread). The state machine is identical to
+    // the one built serially and if several states fail to build, the
+    // error of the first one is thrown, as build () would.
+    static void build_parallel (const rules &rules_,
+        basic_state_machine<CharT> &state_machine_,
+        const bool minimise_ = false, std::size_t threads_ = 0)
+    {
+#if defined (BOOST_LEXER_HAS_THREADS)
+        const std::size_t size_ = rules_.statemap ().size ();
+
+        if (threads_ == 0)
+        {
+            threads_ = std::thread::hardware_concurrency ();
         }
 
-        for (index_ = 0, size_ = internals_._lookup->size ();
-            index_ < size_; ++index_)
+        if (threads_ > size_)
         {
-            internals_._lookup[index_]->resize (sizeof (CharT) == 1 ?
-                num_chars : num_wchar_ts, dead_state_index);
+            threads_ = size_;
+        }
 
-            if (!rules_.regexes ()[index_].empty ())
+        if (threads_ > 1)
+        {
+            detail::internals &internals_ = const_cast<detail::internals &>
+                (state_machine_.data ());
+            boost::movelib::unique_ptr<bool[]> seen_BOL_assertions_
+                (new bool[size_] ());
+            boost::movelib::unique_ptr<bool[]> seen_EOL_assertions_
+                (new bool[size_] ());
+            std::vector<std::exception_ptr> errors_ (size_);
+            std::atomic<std::size_t> next_ (0);
+            std::vector<std::thread> pool_;
+
+            state_machine_.clear ();
+            init_machines (size_, internals_);
+            pool_.reserve (threads_);
+
+            try
             {
-                // vector mapping token indexes to partitioned token index sets
-                index_set_vector set_mapping_;
-                // syntax tree
-                detail::node *root_ = build_tree (rules_, index_,
-                    node_ptr_vector_, internals_, set_mapping_);
-
-                build_dfa (root_, set_mapping_,
-                    internals_._dfa_alphabet[index_],
-                    *internals_._dfa[index_]);
+                while (pool_.size () + 1 < threads_)
+                {
+                    pool_.push_back (std::thread (&build_states,
+                        std::cref (rules_), minimise_, std::ref (internals_),
+                        std::ref (next_), seen_BOL_assertions_.get (),
+                        seen_EOL_assertions_.get (), &errors_.front ()));
+                }
+            }
+            catch (...)
+            {
+                // Carry on with the threads that could be started.
+            }
 
-                if (internals_._seen_BOL_assertion)
+            build_states (rules_, minimise_, internals_, next_,
+                seen_BOL_assertions_.get (), seen_EOL_assertions_.get (),
+                &errors_.front ());
+
+            for (std::size_t i_ = 0; i_ < pool_.size (); ++i_)
+            {
+                pool_[i_].join ();
+            }
+
+            for (std::size_t index_ = 0; index_ < size_; ++index_)
+            {
+                if (errors_[index_])
                 {
-                    seen_BOL_assertion_ = true;
+                    std::rethrow_exception (errors_[index_]);
                 }
 
-                if (internals_._seen_EOL_assertion)
+                if (seen_BOL_assertions_[index_])
                 {
-                    seen_EOL_assertion_ = true;
+                    internals_._seen_BOL_assertion = true;
                 }
 
-                internals_._seen_BOL_assertion = false;
-                internals_._seen_EOL_assertion = false;
+                if (seen_EOL_assertions_[index_])
+                {
+                    internals_._seen_EOL_assertion = true;
+                }
             }
+
+            return;
         }
+#else
+        (void) threads_;
+#endif
+        build (rules_, state_machine_);
 
-        internals_._seen_BOL_assertion = seen_BOL_assertion_;
-        internals_._seen_EOL_assertion = seen_EOL_assertion_;
+        if (minimise_)
+        {
+            minimise (state_machine_);
+        }
     }
 
     static void minimise (basic_state_machine<CharT> &state_machine_)
@@ -98,19 +166,8 @@ public:
 
         for (std::size_t i_ = 0; i_ < machines_; ++i_)
         {
-            const std::size_t dfa_alphabet_ = internals_._dfa_alphabet[i_];
-            size_t_vector *dfa_ = internals_._dfa[i_];
-
-            if (dfa_alphabet_ != 0)
-            {
-                std::size_t size_ = 0;
-
-                do
-                {
-                    size_ = dfa_->size ();
-                    minimise_dfa (dfa_alphabet_, *dfa_, size_);
-                } while (dfa_->size () != size_);
-            }
+            minimise_state (internals_._dfa_alphabet[i_],
+                *internals_._dfa[i_]);
         }
     }
 
@@ -138,11 +195,109 @@ protected:
     typedef std::pair<macro_iter, bool> macro_iter_pair;
     typedef typename parser::tokeniser::token_map token_map;
 
+    static void init_machines (const std::size_t size_,
+        detail::internals &internals_)
+    {
+        for (std::size_t index_ = 0; index_ < size_; ++index_)
+        {
+            internals_._lookup->push_back (static_cast<size_t_vector *>(0));
+            internals_._lookup->back () = new size_t_vector
+                (sizeof (CharT) == 1 ? num_chars : num_wchar_ts,
+                dead_state_index);
+            internals_._dfa_alphabet.push_back (0);
+            internals_._dfa->push_back (static_cast<size_t_vector *>(0));
+            internals_._dfa->back () = new size_t_vector;
+        }
+    }
+
+    // Only touches the tables of state index_, so that different states
+    // can be built at the same time. The assertion flags are only ever
+    // set, never cleared.
+    static void build_state (const rules &rules_, const std::size_t index_,
+        const bool minimise_, detail::internals &internals_,
+        bool &seen_BOL_assertion_, bool &seen_EOL_assertion_)
+    {
+        if (!rules_.regexes ()[index_].empty ())
+        {
+            node_ptr_vector node_ptr_vector_;
+            bool seen_BOL_ = false;
+            bool seen_EOL_ = false;
+            // vector mapping token indexes to partitioned token index sets
+            index_set_vector set_mapping_;
+            // syntax tree
+            detail::node *root_ = build_tree (rules_, index_,
+                node_ptr_vector_, *internals_._lookup[index_],
+                internals_._dfa_alphabet[index_], seen_BOL_, seen_EOL_,
+                set_mapping_);
+
+            build_dfa (root_, set_mapping_,
+                internals_._dfa_alphabet[index_],
+                *internals_._dfa[index_]);
+
+            if (minimise_)
+            {
+                minimise_state (internals_._dfa_alphabet[index_],
+                    *internals_._dfa[index_]);
+            }
+
+            if (seen_BOL_)
+            {
+                seen_BOL_assertion_ = true;
+            }
+
+            if (seen_EOL_)
+            {
+                seen_EOL_assertion_ = true;
+            }
+        }
+    }
+
+#if defined (BOOST_LEXER_HAS_THREADS)
+    // Thread body of build_parallel (): builds states until none are left.
+    static void build_states (const rules &rules_, const bool minimise_,
+        detail::internals &internals_, std::atomic<std::size_t> &next_,
+        bool *seen_BOL_assertions_, bool *seen_EOL_assertions_,
+        std::exception_ptr *errors_)
+    {
+        const std::size_t size_ = internals_._dfa->size ();
+
+        for (std::size_t index_ = next_++; index_ < size_; index_ = next_++)
+        {
+            try
+            {
+                build_state (rules_, index_, minimise_, internals_,
+                    seen_BOL_assertions_[index_],
+                    seen_EOL_assertions_[index_]);
+            }
+            catch (...)
+            {
+                errors_[index_] = std::current_exception ();
+            }
+        }
+    }
+#endif
+
+    static void minimise_state (const std::size_t dfa_alphabet_,
+        size_t_vector &dfa_)
+    {
+        if (dfa_alphabet_ != 0)
+        {
+            std::size_t size_ = 0;
+
+            do
+            {
+                size_ = dfa_.size ();
+                minimise_dfa (dfa_alphabet_, dfa_, size_);
+            } while (dfa_.size () != size_);
+        }
+    }
+
     static detail::node *build_tree (const rules &rules_,
         const std::size_t state_, node_ptr_vector &node_ptr_vector_,
-        detail::internals &internals_, index_set_vector &set_mapping_)
+        size_t_vector &lookup_, std::size_t &dfa_alphabet_,
+        bool &seen_BOL_assertion_, bool &seen_EOL_assertion_,
+        index_set_vector &set_mapping_)
     {
-        size_t_vector *lookup_ = internals_._lookup[state_];
         const typename rules::string_deque_deque &regexes_ =
             rules_.regexes ();
         const typename rules::id_vector_deque &ids_ = rules_.ids ();
@@ -169,13 +324,13 @@ protected:
 
         build_macros (token_map_, macrodeque_, macromap_,
             rules_.flags (), rules_.locale (), node_ptr_vector_,
-            internals_._seen_BOL_assertion, internals_._seen_EOL_assertion);
+            seen_BOL_assertion_, seen_EOL_assertion_);
 
         detail::node *root_ = parser::parse (regex_.c_str (),
             regex_.c_str () + regex_.size (), *ids_iter_, *unique_ids_iter_,
             *states_iter_, rules_.flags (), rules_.locale (), node_ptr_vector_,
-            macromap_, token_map_, internals_._seen_BOL_assertion,
-            internals_._seen_EOL_assertion);
+            macromap_, token_map_, seen_BOL_assertion_,
+            seen_EOL_assertion_);
 
         ++regex_iter_;
         ++ids_iter_;
@@ -193,8 +348,7 @@ protected:
                 regex2_.c_str () + regex2_.size (), *ids_iter_,
                 *unique_ids_iter_, *states_iter_, rules_.flags (),
                 rules_.locale (), node_ptr_vector_, macromap_, token_map_,
-                internals_._seen_BOL_assertion,
-                internals_._seen_EOL_assertion);
+                seen_BOL_assertion_, seen_EOL_assertion_);
             tree_vector_.push_back (root_);
             ++regex_iter_;
             ++ids_iter_;
@@ -202,7 +356,7 @@ protected:
             ++states_iter_;
         }
 
-        if (internals_._seen_BOL_assertion)
+        if (seen_BOL_assertion_)
         {
             // Fixup BOLs
             typename detail::node::node_vector::iterator iter_ =
@@ -258,7 +412,7 @@ protected:
             typename charset::index_set::const_iterator set_end_ =
                 cs_->_index_set.end ();
 
-            fill_lookup (cs_->_token, lookup_, index_);
+            fill_lookup (cs_->_token, &lookup_, index_);
 
             for (; set_iter_ != set_end_; ++set_iter_)
             {
@@ -266,7 +420,7 @@ protected:
             }
         }
 
-        internals_._dfa_alphabet[state_] = token_list_->size () + dfa_offset;
+        dfa_alphabet_ = token_list_->size () + dfa_offset;
         return root_;
     }
 
@@ -0,0 +1,402 @@
+// serialise.hpp
+// Copyright (c) 2007-2009 Ben Hanson (http://www.benhanson.net/)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file licence_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#ifndef BOOST_LEXER_SERIALISE_HPP
+#define BOOST_LEXER_SERIALISE_HPP
+
+#include <boost/cstdint.hpp>
+#include "consts.hpp"
+// memcpy()
+#include <cstring>
+#include "internals.hpp"
+#include <ostream>
+#include "rules.hpp"
+#include "size_t.hpp"
+#include "state_machine.hpp"
+#include <string>
+
+// A binary image of a basic_state_machine, used to cache the result of
+// basic_generator::build () across processes. The image is laid out for
+// the machine that wrote it: the tables are native std::size_t arrays at
+// 8 byte aligned offsets, so an image mapped into memory is loaded with a
+// single memcpy () per table. load_binary () rejects images written by
+// another format version, word size, byte order or character type, and
+// images of a different rule set (see hash_rules ()).
+//
+// Layout:
+//     header
+//     dfas * { lookup size, dfa_alphabet, dfa size } (boost::uint64_t)
+//     dfas * { lookup table, dfa table } (std::size_t, each padded to 8)
+
+namespace boost
+{
+namespace lexer
+{
+namespace detail
+{
+const boost::uint32_t binary_version = 1;
+const boost::uint32_t binary_byte_order = 0x01020304;
+
+struct binary_header
+{
+    char magic[8];
+    boost::uint32_t version;
+    boost::uint32_t byte_order;
+    boost::uint32_t size_t_size;
+    boost::uint32_t char_size;
+    boost::uint64_t hash;
+    boost::uint64_t flags;
+    boost::uint64_t dfas;
+    boost::uint64_t size;
+};
+
+enum {bol_flag = 1, eol_flag = 2};
+
+inline const char *binary_magic ()
+{
+    return "LEXERTL";
+}
+
+inline std::size_t binary_padding (const std::size_t size_)
+{
+    return (8 - size_ % 8) % 8;
+}
+
+// 64 bit FNV-1a
+class fnv1a
+{
+public:
+    fnv1a () :
+        _hash (14695981039346656037ULL)
+    {
+    }
+
+    void add (const void *data_, const std::size_t size_)
+    {
+        const unsigned char *ptr_ = static_cast<const unsigned char *>(data_);
+
+        for (std::size_t i_ = 0; i_ < size_; ++i_)
+        {
+            _hash ^= ptr_[i_];
+            _hash *= 1099511628211ULL;
+        }
+    }
+
+    void add (const boost::uint64_t value_)
+    {
+        unsigned char bytes_[8];
+
+        // independent of the byte order
+        for (std::size_t i_ = 0; i_ < 8; ++i_)
+        {
+            bytes_[i_] = static_cast<unsigned char>(value_ >> (i_ * 8));
+        }
+
+        add (bytes_, 8);
+    }
+
+    template<typename CharT>
+    void add (const std::basic_string<CharT> &str_)
+    {
+        add (static_cast<boost::uint64_t>(str_.size ()));
+
+        for (std::size_t i_ = 0; i_ < str_.size (); ++i_)
+        {
+            add (static_cast<boost::uint64_t>(str_[i_]));
+        }
+    }
+
+    boost::uint64_t value () const
+    {
+        return _hash;
+    }
+
+private:
+    boost::uint64_t _hash;
+};
+
+// Checks that the tokenizer can follow the tables of one state without
+// leaving them: the lookup table maps to columns of the dfa, the dfa is
+// made of whole rows, from the dead state and the start state on, and
+// every transition and lex state refers to an existing row or state.
+// A state without rules has no dfa at all.
+inline bool valid_tables (const internals::size_t_vector &lookup_,
+    const std::size_t dfa_alphabet_, const internals::size_t_vector &dfa_,
+    const std::size_t dfas_)
+{
+    if (dfa_.empty ()) return dfa_alphabet_ == 0;
+
+    if (dfa_alphabet_ < dfa_offset || dfa_.size () % dfa_alphabet_ != 0)
+        return false;
+
+    const std::size_t rows_ = dfa_.size () / dfa_alphabet_;
+
+    if (rows_ < 2) return false;
+
+    for (std::size_t i_ = 0, size_ = lookup_.size (); i_ < size_; ++i_)
+    {
+        if (lookup_[i_] >= dfa_alphabet_) return false;
+    }
+
+    for (std::size_t row_ = 0; row_ < rows_; ++row_)
+    {
+        const std::size_t *ptr_ = &dfa_[row_ * dfa_alphabet_];
+
+        if (ptr_[state_index] >= dfas_ || ptr_[bol_index] >= rows_ ||
+            ptr_[eol_index] >= rows_) return false;
+
+        for (std::size_t col_ = dfa_offset; col_ < dfa_alphabet_; ++col_)
+        {
+            if (ptr_[col_] >= rows_) return false;
+        }
+    }
+
+    return true;
+}
+}
+
+// A hash of everything basic_generator::build () reads from the rules.
+template<typename CharT>
+boost::uint64_t hash_rules (const basic_rules<CharT> &rules_)
+{
+    typedef basic_rules<CharT> rules;
+    detail::fnv1a hash_;
+
+    hash_.add (static_cast<boost::uint64_t>(detail::binary_version));
+    hash_.add (static_cast<boost::uint64_t>(sizeof (CharT)));
+    hash_.add (static_cast<boost::uint64_t>(rules_.flags ()));
+    hash_.add (rules_.locale ().name ());
+    hash_.add (static_cast<boost::uint64_t>(rules_.statemap ().size ()));
+
+    for (typename rules::string_size_t_map::const_iterator iter_ =
+        rules_.statemap ().begin (), end_ = rules_.statemap ().end ();
+        iter_ != end_; ++iter_)
+    {
+        hash_.add (iter_->first);
+        hash_.add (static_cast<boost::uint64_t>(iter_->second));
+    }
+
+    hash_.add (static_cast<boost::uint64_t>(rules_.macrodeque ().size ()));
+
+    for (typename rules::string_pair_deque::const_iterator iter_ =
+        rules_.macrodeque ().begin (), end_ = rules_.macrodeque ().end ();
+        iter_ != end_; ++iter_)
+    {
+        hash_.add (iter_->first);
+        hash_.add (iter_->second);
+    }
+
+    const typename rules::string_deque_deque &regexes_ = rules_.regexes ();
+
+    hash_.add (static_cast<boost::uint64_t>(regexes_.size ()));
+
+    for (std::size_t state_ = 0; state_ < regexes_.size (); ++state_)
+    {
+        const std::size_t size_ = regexes_[state_].size ();
+
+        hash_.add (static_cast<boost::uint64_t>(size_));
+
+        for (std::size_t i_ = 0; i_ < size_; ++i_)
+        {
+            hash_.add (regexes_[state_][i_]);
+            hash_.add (static_cast<boost::uint64_t>
+                (rules_.ids ()[state_][i_]));
+            hash_.add (static_cast<boost::uint64_t>
+                (rules_.unique_ids ()[state_][i_]));
+            hash_.add (static_cast<boost::uint64_t>
+                (rules_.states ()[state_][i_]));
+        }
+    }
+
+    return hash_.value ();
+}
+
+// Writes the image of state_machine_, tagged with the hash of the rules
+// it was built from.
+template<typename CharT>
+void save_binary (const basic_state_machine<CharT> &state_machine_,
+    const boost::uint64_t hash_, std::ostream &os_)
+{
+    const detail::internals &internals_ = state_machine_.data ();
+    const std::size_t dfas_ = internals_._dfa->size ();
+    const char zeros_[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    detail::binary_header header_;
+
+    std::memset (&header_, 0, sizeof (header_));
+    std::memcpy (header_.magic, detail::binary_magic (), 8);
+    header_.version = detail::binary_version;
+    header_.byte_order = detail::binary_byte_order;
+    header_.size_t_size = sizeof (std::size_t);
+    header_.char_size = sizeof (CharT);
+    header_.hash = hash_;
+    header_.flags = (internals_._seen_BOL_assertion ? detail::bol_flag : 0) |
+        (internals_._seen_EOL_assertion ? detail::eol_flag : 0);
+    header_.dfas = dfas_;
+    header_.size = sizeof (header_) + dfas_ * 3 * sizeof (boost::uint64_t);
+
+    for (std::size_t index_ = 0; index_ < dfas_; ++index_)
+    {
+        const std::size_t lookup_ = internals_._lookup[index_]->size () *
+            sizeof (std::size_t);
+        const std::size_t dfa_ = internals_._dfa[index_]->size () *
+            sizeof (std::size_t);
+
+        header_.size += lookup_ + detail::binary_padding (lookup_) +
+            dfa_ + detail::binary_padding (dfa_);
+    }
+
+    os_.write (reinterpret_cast<const char *>(&header_), sizeof (header_));
+
+    for (std::size_t index_ = 0; index_ < dfas_; ++index_)
+    {
+        const boost::uint64_t sizes_[3] =
+        {
+            internals_._lookup[index_]->size (),
+            internals_._dfa_alphabet[index_],
+            internals_._dfa[index_]->size ()
+        };
+
+        os_.write (reinterpret_cast<const char *>(sizes_), sizeof (sizes_));
+    }
+
+    for (std::size_t index_ = 0; index_ < dfas_; ++index_)
+    {
+        const detail::internals::size_t_vector *tables_[2] =
+            {internals_._lookup[index_], internals_._dfa[index_]};
+
+        for (std::size_t t_ = 0; t_ < 2; ++t_)
+        {
+            const std::size_t size_ = tables_[t_]->size () *
+                sizeof (std::size_t);
+
+            if (size_)
+            {
+                os_.write (reinterpret_cast<const char *>
+                    (&tables_[t_]->front ()), size_);
+            }
+
+            os_.write (zeros_, detail::binary_padding (size_));
+        }
+    }
+}
+
+// Replaces state_machine_ with the image in [data_, data_ + size_).
+// Returns false, leaving state_machine_ alone, if the image is not one
+// written by save_binary () on this platform for rules with hash_, or if
+// its tables are not consistent.
+template<typename CharT>
+bool load_binary (const void *data_, const std::size_t size_,
+    const boost::uint64_t hash_, basic_state_machine<CharT> &state_machine_)
+{
+    const char *ptr_ = static_cast<const char *>(data_);
+    detail::binary_header header_;
+
+    if (size_ < sizeof (header_)) return false;
+
+    std::memcpy (&header_, ptr_, sizeof (header_));
+
+    if (std::memcmp (header_.magic, detail::binary_magic (), 8) != 0 ||
+        header_.version != detail::binary_version ||
+        header_.byte_order != detail::binary_byte_order ||
+        header_.size_t_size != sizeof (std::size_t) ||
+        header_.char_size != sizeof (CharT) ||
+        header_.hash != hash_ || header_.size != size_ ||
+        header_.dfas > (size_ - sizeof (header_)) /
+            (3 * sizeof (boost::uint64_t)))
+    {
+        return false;
+    }
+
+    const std::size_t dfas_ = static_cast<std::size_t>(header_.dfas);
+    const char *sizes_ = ptr_ + sizeof (header_);
+    const char *tables_ = sizes_ + dfas_ * 3 * sizeof (boost::uint64_t);
+    const char *end_ = ptr_ + size_;
+    const char *curr_ = tables_;
+    const std::size_t lookup_size_ = sizeof (CharT) == 1 ?
+        num_chars : num_wchar_ts;
+
+    // check that the tables are where they should be before allocating
+    for (std::size_t index_ = 0; index_ < dfas_; ++index_)
+    {
+        boost::uint64_t entry_[3];
+
+        std::memcpy (entry_, sizes_ + index_ * sizeof (entry_),
+            sizeof (entry_));
+
+        if (entry_[0] != lookup_size_ ||
+            (entry_[1] == 0 ? entry_[2] != 0 : entry_[2] % entry_[1] != 0))
+        {
+            return false;
+        }
+
+        for (std::size_t t_ = 0; t_ < 3; t_ += 2)
+        {
+            if (entry_[t_] > static_cast<boost::uint64_t>(end_ - curr_) /
+                sizeof (std::size_t)) return false;
+
+            const std::size_t bytes_ = static_cast<std::size_t>(entry_[t_]) *
+                sizeof (std::size_t);
+
+            if (bytes_ + detail::binary_padding (bytes_) >
+                static_cast<std::size_t>(end_ - curr_)) return false;
+
+            curr_ += bytes_ + detail::binary_padding (bytes_);
+        }
+    }
+
+    if (curr_ != end_) return false;
+
+    basic_state_machine<CharT> sm_;
+    detail::internals &internals_ = const_cast<detail::internals &>
+        (sm_.data ());
+
+    curr_ = tables_;
+    internals_._seen_BOL_assertion = (header_.flags & detail::bol_flag) != 0;
+    internals_._seen_EOL_assertion = (header_.flags & detail::eol_flag) != 0;
+
+    for (std::size_t index_ = 0; index_ < dfas_; ++index_)
+    {
+        boost::uint64_t entry_[3];
+
+        std::memcpy (entry_, sizes_ + index_ * sizeof (entry_),
+            sizeof (entry_));
+        internals_._lookup->push_back
+            (static_cast<detail::internals::size_t_vector *>(0));
+        internals_._lookup->back () = new detail::internals::size_t_vector
+            (static_cast<std::size_t>(entry_[0]));
+        internals_._dfa_alphabet.push_back
+            (static_cast<std::size_t>(entry_[1]));
+        internals_._dfa->push_back
+            (static_cast<detail::internals::size_t_vector *>(0));
+        internals_._dfa->back () = new detail::internals::size_t_vector
+            (static_cast<std::size_t>(entry_[2]));
+
+        detail::internals::size_t_vector *vectors_[2] =
+            {internals_._lookup->back (), internals_._dfa->back ()};
+
+        for (std::size_t t_ = 0; t_ < 2; ++t_)
+        {
+            const std::size_t bytes_ = vectors_[t_]->size () *
+                sizeof (std::size_t);
+
+            if (bytes_)
+            {
+                std::memcpy (&vectors_[t_]->front (), curr_, bytes_);
+            }
+
+            curr_ += bytes_ + detail::binary_padding (bytes_);
+        }
+
+        if (!detail::valid_tables (*vectors_[0], static_cast<std::size_t>
+            (entry_[1]), *vectors_[1], dfas_)) return false;
+    }
+
+    state_machine_.swap (sm_);
+    return true;
+}
+}
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+    http://spirit.sourceforge.net/
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_SIMD_OCT_17_2026_1100AM)
+#define SPIRIT_SIMD_OCT_17_2026_1100AM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+//  Detect the vector instruction sets usable by the character scanning
+//  kernels. Define BOOST_SPIRIT_NO_SIMD to force the portable code paths.
+///////////////////////////////////////////////////////////////////////////////
+#if !defined(BOOST_SPIRIT_NO_SIMD)
+# if defined(__SSE2__) || defined(_M_X64) || \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BOOST_SPIRIT_HAS_SSE2
+#  include <emmintrin.h>
+# endif
+# if defined(__AVX2__)
+#  define BOOST_SPIRIT_HAS_AVX2
+#  include <immintrin.h>
+# endif
+#endif
+
+#if defined(BOOST_MSVC)
+# include <intrin.h>
+#endif
+
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Index of the lowest set bit of a non-zero mask
+    ///////////////////////////////////////////////////////////////////////////
+    inline unsigned lowest_bit(boost::uint32_t mask)
+    {
+#if defined(BOOST_MSVC)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#elif defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+        unsigned index = 0;
+        while (!(mask & 1))
+        {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+}}}
+
+#endif
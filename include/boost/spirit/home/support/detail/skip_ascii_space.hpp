@@ -0,0 +1,92 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+    http://spirit.sourceforge.net/
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_SKIP_ASCII_SPACE_OCT_17_2026_1105AM)
+#define SPIRIT_SKIP_ASCII_SPACE_OCT_17_2026_1105AM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/spirit/home/support/detail/simd.hpp>
+
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Returns true for the ASCII white space characters: '\t', '\n', '\v',
+    //  '\f', '\r' and ' '. These are white space in every char encoding
+    //  Spirit supports.
+    ///////////////////////////////////////////////////////////////////////////
+    inline bool is_ascii_space(char ch)
+    {
+        unsigned char const c = static_cast<unsigned char>(ch);
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Returns the first position in [first, last) that does not hold an
+    //  ASCII white space character, scanning 16 or 32 bytes per step where
+    //  the target supports it.
+    ///////////////////////////////////////////////////////////////////////////
+    inline char const* skip_ascii_space(char const* first, char const* last)
+    {
+        // most calls happen at a non-space position, keep those cheap
+        if (first == last || !is_ascii_space(*first))
+            return first;
+        ++first;
+
+#if defined(BOOST_SPIRIT_HAS_AVX2)
+        {
+            __m256i const space = _mm256_set1_epi8(' ');
+            __m256i const tab = _mm256_set1_epi8('\t');
+            __m256i const range = _mm256_set1_epi8('\r' - '\t');
+            while (last - first >= 32)
+            {
+                __m256i const c = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(first));
+                // c - '\t' <= '\r' - '\t' (unsigned) <=> min(c - '\t', 4) == c - '\t'
+                __m256i const d = _mm256_sub_epi8(c, tab);
+                __m256i const ws = _mm256_or_si256(
+                    _mm256_cmpeq_epi8(c, space)
+                  , _mm256_cmpeq_epi8(_mm256_min_epu8(d, range), d));
+                boost::uint32_t const mask =
+                    ~static_cast<boost::uint32_t>(_mm256_movemask_epi8(ws));
+                if (mask)
+                    return first + lowest_bit(mask);
+                first += 32;
+            }
+        }
+#endif
+#if defined(BOOST_SPIRIT_HAS_SSE2)
+        {
+            __m128i const space = _mm_set1_epi8(' ');
+            __m128i const tab = _mm_set1_epi8('\t');
+            __m128i const range = _mm_set1_epi8('\r' - '\t');
+            while (last - first >= 16)
+            {
+                __m128i const c = _mm_loadu_si128(
+                    reinterpret_cast<__m128i const*>(first));
+                __m128i const d = _mm_sub_epi8(c, tab);
+                __m128i const ws = _mm_or_si128(
+                    _mm_cmpeq_epi8(c, space)
+                  , _mm_cmpeq_epi8(_mm_min_epu8(d, range), d));
+                boost::uint32_t const mask =
+                    ~static_cast<boost::uint32_t>(_mm_movemask_epi8(ws)) & 0xffff;
+                if (mask)
+                    return first + lowest_bit(mask);
+                first += 16;
+            }
+        }
+#endif
+        while (first != last && is_ascii_space(*first))
+            ++first;
+        return first;
+    }
+}}}
+
+#endif
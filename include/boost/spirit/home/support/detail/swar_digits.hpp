@@ -0,0 +1,76 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+    http://spirit.sourceforge.net/
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_SWAR_DIGITS_OCT_17_2026_0210PM)
+#define SPIRIT_SWAR_DIGITS_OCT_17_2026_0210PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/mpl/bool.hpp>
+#include <cstring>
+
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  SIMD within a register: eight decimal digits are loaded into one
+    //  64-bit word, validated and converted with a handful of integer
+    //  operations instead of a compare and a multiply-add per character.
+    ///////////////////////////////////////////////////////////////////////////
+
+    // Only contiguous ranges of (plain) chars can be loaded as a word.
+    template <typename Iterator>
+    struct is_swar_digits_iterator : mpl::false_ {};
+
+    template <>
+    struct is_swar_digits_iterator<char const*> : mpl::true_ {};
+
+    template <>
+    struct is_swar_digits_iterator<char*> : mpl::true_ {};
+
+    // Load the eight chars at p, the first one in the lowest byte.
+    inline boost::uint64_t load_eight_chars(char const* p)
+    {
+        boost::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+#if BOOST_ENDIAN_BIG_BYTE
+        v = ((v & 0x00000000ffffffffull) << 32) | (v >> 32);
+        v = ((v & 0x0000ffff0000ffffull) << 16) | ((v >> 16) & 0x0000ffff0000ffffull);
+        v = ((v & 0x00ff00ff00ff00ffull) << 8) | ((v >> 8) & 0x00ff00ff00ff00ffull);
+#endif
+        return v;
+    }
+
+    // True if all eight bytes of v are in '0'..'9': every byte must be
+    // 0x3X, and adding 6 must not carry X into the high nibble.
+    inline bool is_eight_digits(boost::uint64_t v)
+    {
+        return ((v & 0xf0f0f0f0f0f0f0f0ull)
+          | (((v + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4))
+            == 0x3333333333333333ull;
+    }
+
+    // The value of the eight digits in v (as loaded by load_eight_chars).
+    // Adjacent digits are combined pairwise into 2, then 4 and finally
+    // 8 digit numbers.
+    inline boost::uint32_t eight_digits_value(boost::uint64_t v)
+    {
+        boost::uint64_t const mask = 0x000000ff000000ffull;
+        boost::uint64_t const mul1 = 0x000f424000000064ull; // 100 + (1000000 << 32)
+        boost::uint64_t const mul2 = 0x0000271000000001ull; // 1 + (10000 << 32)
+        v -= 0x3030303030303030ull;
+        v = (v * 10) + (v >> 8);
+        v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+        return static_cast<boost::uint32_t>(v);
+    }
+}}}
+
+#endif
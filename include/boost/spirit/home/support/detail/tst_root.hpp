@@ -0,0 +1,317 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(SPIRIT_TST_ROOT_OCT_18_2026_1100PM)
+#define SPIRIT_TST_ROOT_OCT_18_2026_1100PM
+
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <new>
+#include <vector>
+
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  The roots of a tst_map, indexed by the first character of the keys.
+    //  Narrow characters index a flat table of 256 slots directly. Wider
+    //  characters go through a two level page table with pages of 256
+    //  slots, allocated as they are used, for the characters up to
+    //  U+10FFFF; the rare characters beyond that are kept in a map.
+    //
+    //  A slot holds the TST of the rest of the keys and the value of the
+    //  single character key. The characters of the slots in use are kept
+    //  in order, for iterating over them.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Char, typename Node, typename T
+      , bool Narrow = (sizeof(Char) == 1)>
+    class tst_root_table;
+
+    template <typename Node, typename T>
+    struct tst_root_slot
+    {
+        Node* root;
+        T* data;
+    };
+
+    template <typename Char>
+    class tst_root_keys
+    {
+    public:
+
+        typedef std::vector<Char> keys_type;
+
+        keys_type const& keys() const
+        {
+            return keys_;
+        }
+
+    protected:
+
+        void add_key(Char c)
+        {
+            typename keys_type::iterator i =
+                std::lower_bound(keys_.begin(), keys_.end(), c);
+            if (i == keys_.end() || *i != c)
+                keys_.insert(i, c);
+        }
+
+        void remove_key(Char c)
+        {
+            typename keys_type::iterator i =
+                std::lower_bound(keys_.begin(), keys_.end(), c);
+            if (i != keys_.end() && *i == c)
+                keys_.erase(i);
+        }
+
+        keys_type keys_;
+    };
+
+    template <typename Char, typename Node, typename T>
+    class tst_root_table<Char, Node, T, true>
+      : public tst_root_keys<Char>, noncopyable
+    {
+    public:
+
+        typedef tst_root_slot<Node, T> slot;
+
+        tst_root_table()
+        {
+            slot const empty = {0, 0};
+            std::fill(table, table + 256, empty);
+        }
+
+        // the slot of c, the slot is empty if no key starts with c
+        slot const* find(Char c) const
+        {
+            return &table[static_cast<unsigned char>(c)];
+        }
+
+        slot* find(Char c)
+        {
+            return &table[static_cast<unsigned char>(c)];
+        }
+
+        slot& insert(Char c)
+        {
+            this->add_key(c);
+            return table[static_cast<unsigned char>(c)];
+        }
+
+        void erase(Char c)
+        {
+            erase_slot(c);
+            this->remove_key(c);
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i != this->keys_.size(); ++i)
+                erase_slot(this->keys_[i]);
+            this->keys_.clear();
+        }
+
+    private:
+
+        void erase_slot(Char c)
+        {
+            slot& x = table[static_cast<unsigned char>(c)];
+            x.root = 0;
+            x.data = 0;
+        }
+
+        slot table[256];
+    };
+
+    template <typename Char, typename Node, typename T>
+    class tst_root_table<Char, Node, T, false>
+      : public tst_root_keys<Char>, noncopyable
+    {
+    public:
+
+        typedef tst_root_slot<Node, T> slot;
+
+        BOOST_STATIC_CONSTANT(std::size_t, page_bits = 8);
+        BOOST_STATIC_CONSTANT(std::size_t, page_size = 1 << page_bits);
+        BOOST_STATIC_CONSTANT(std::size_t, max_pages = 0x110000 >> page_bits);
+
+        tst_root_table()
+        {
+        }
+
+        ~tst_root_table()
+        {
+            release();
+        }
+
+        // the slot of c, or 0 if no key starts with c
+        slot const* find(Char c) const
+        {
+            unsigned_type const u = static_cast<unsigned_type>(c);
+            std::size_t const page = static_cast<std::size_t>(u >> page_bits);
+            if (page < pages.size())
+            {
+                slot const* p = pages[page];
+                return p ? p + (u & (page_size - 1)) : 0;
+            }
+            if (page < max_pages || overflow.empty())
+                return 0;
+
+            typename overflow_type::const_iterator i = overflow.find(u);
+            return i != overflow.end() ? &i->second : 0;
+        }
+
+        slot* find(Char c)
+        {
+            return const_cast<slot*>(
+                static_cast<tst_root_table const*>(this)->find(c));
+        }
+
+        slot& insert(Char c)
+        {
+            this->add_key(c);
+
+            unsigned_type const u = static_cast<unsigned_type>(c);
+            std::size_t const page = static_cast<std::size_t>(u >> page_bits);
+            if (page >= max_pages)
+            {
+                slot const empty = {0, 0};
+                return overflow.insert(
+                    typename overflow_type::value_type(u, empty)).first->second;
+            }
+
+            if (page >= pages.size())
+                pages.resize(page + 1, 0);
+            if (!pages[page])
+            {
+                slot const empty = {0, 0};
+                pages[page] = new slot[page_size];
+                std::fill(pages[page], pages[page] + page_size, empty);
+            }
+            return pages[page][u & (page_size - 1)];
+        }
+
+        void erase(Char c)
+        {
+            unsigned_type const u = static_cast<unsigned_type>(c);
+            std::size_t const page = static_cast<std::size_t>(u >> page_bits);
+            if (page < pages.size())
+            {
+                if (slot* p = pages[page])
+                {
+                    p[u & (page_size - 1)].root = 0;
+                    p[u & (page_size - 1)].data = 0;
+                }
+            }
+            else if (page >= max_pages)
+            {
+                overflow.erase(u);
+            }
+            this->remove_key(c);
+        }
+
+        void clear()
+        {
+            release();
+            pages.clear();
+            overflow.clear();
+            this->keys_.clear();
+        }
+
+    private:
+
+        typedef typename make_unsigned<Char>::type unsigned_type;
+        typedef std::map<unsigned_type, slot> overflow_type;
+
+        void release()
+        {
+            for (std::size_t i = 0; i != pages.size(); ++i)
+                delete [] pages[i];
+        }
+
+        std::vector<slot*> pages;
+        overflow_type overflow;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  A pool for the nodes of a tst_map. Nodes are carved out of blocks of
+    //  increasing size, so the nodes of a table stay close to each other,
+    //  and are recycled through a free list, so that both allocating and
+    //  releasing a node take constant time. The nodes must be trivially
+    //  destructible: the blocks are released without visiting them.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Node>
+    class tst_node_pool : noncopyable
+    {
+    public:
+
+        BOOST_STATIC_ASSERT(has_trivial_destructor<Node>::value);
+        BOOST_STATIC_ASSERT(sizeof(Node) >= sizeof(void*));
+
+        tst_node_pool()
+          : free_(0), next(0), end(0), block_size(32)
+        {
+        }
+
+        ~tst_node_pool()
+        {
+            for (std::size_t i = 0; i != blocks.size(); ++i)
+                ::operator delete(blocks[i]);
+        }
+
+        template <typename A>
+        Node* construct(A const& a)
+        {
+            return new (allocate()) Node(a);
+        }
+
+        void destroy(Node* p)
+        {
+            p->~Node();
+            *static_cast<void**>(static_cast<void*>(p)) = free_;
+            free_ = p;
+        }
+
+    private:
+
+        void* allocate()
+        {
+            if (free_)
+            {
+                void* p = free_;
+                free_ = *static_cast<void**>(free_);
+                return p;
+            }
+            if (next == end)
+            {
+                blocks.reserve(blocks.size() + 1);
+                next = static_cast<Node*>(
+                    ::operator new(block_size * sizeof(Node)));
+                blocks.push_back(next);
+                end = next + block_size;
+                if (block_size < 4096)
+                    block_size *= 2;
+            }
+            return next++;
+        }
+
+        std::vector<void*> blocks;
+        void* free_;
+        Node* next;
+        Node* end;
+        std::size_t block_size;
+    };
+}}}
+
+#endif
@@ -7,8 +7,52 @@
 #define BOOST_SPIRIT_ITERATOR_COMBINE_POLICIES_APR_06_2008_0136PM
 
 #include <boost/config.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/type_traits/is_empty.hpp>
 
+namespace boost { namespace spirit { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Storage policies written before the clone() hook was added do not
+    //  implement it, a copy of the iterator does not concern them. The
+    //  hook is looked up from a class derived from the storage policy, as
+    //  the policies keep their functions protected; it is never created.
+    template <typename Storage, typename MultiPass>
+    struct storage_clone : Storage
+    {
+        template <void (*)(MultiPass&)>
+        struct check;
+
+        template <typename U>
+        static char test(check<&U::template clone<MultiPass> >*);
+
+        template <typename U>
+        static char (&test(...))[2];
+
+        static void call(MultiPass& mp, mpl::true_)
+        {
+            Storage::clone(mp);
+        }
+
+        static void call(MultiPass&, mpl::false_)
+        {
+        }
+    };
+
+    template <typename Storage, typename MultiPass>
+    struct has_storage_clone
+      : mpl::bool_<sizeof(storage_clone<Storage, MultiPass>::template
+            test<storage_clone<Storage, MultiPass> >(0)) == sizeof(char)>
+    {};
+
+    template <typename Storage, typename MultiPass>
+    inline void clone_storage(MultiPass& mp)
+    {
+        storage_clone<Storage, MultiPass>::call(mp
+          , has_storage_clone<Storage, MultiPass>());
+    }
+}}}
+
 namespace boost { namespace spirit { namespace iterator_policies
 {
     ///////////////////////////////////////////////////////////////////////////
@@ -64,6 +108,13 @@ namespace boost { namespace spirit { namespace iterator_policies
             Checking::clear_queue(mp);
             Storage::clear_queue(mp);
         }
+
+        template <typename MultiPass>
+        inline static void clone(MultiPass& mp)
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -99,6 +150,13 @@ namespace boost { namespace spirit { namespace iterator_policies
             Storage::clear_queue(mp);
         }
 
+        template <typename MultiPass>
+        inline static void clone(MultiPass& mp)
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
+
         // implement input policy functions by forwarding to the Input type
         template <typename MultiPass>
         inline static void advance_input(MultiPass& mp)
@@ -150,6 +208,13 @@ namespace boost { namespace spirit { namespace iterator_policies
             Storage::clear_queue(mp);
         }
 
+        template <typename MultiPass>
+        inline static void clone(MultiPass& mp)
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
+
         // checking policy functions are forwarded to the Checking type
         template <typename MultiPass>
         inline static void docheck(MultiPass const& mp)
@@ -187,6 +252,13 @@ namespace boost { namespace spirit { namespace iterator_policies
             Storage::clear_queue(mp);
         }
 
+        template <typename MultiPass>
+        inline static void clone(MultiPass& mp)
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
+
         // implement input policy functions by forwarding to the Input type
         template <typename MultiPass>
         inline static void advance_input(MultiPass& mp)
@@ -246,7 +318,10 @@ namespace boost { namespace spirit { namespace iterator_policies
         // ownership policy functions are forwarded to the Ownership type
         template <typename MultiPass>
         inline static void clone(MultiPass& mp)
-            { Ownership::clone(mp); }
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
 
         template <typename MultiPass>
         inline static bool release(MultiPass& mp)
@@ -308,7 +383,10 @@ namespace boost { namespace spirit { namespace iterator_policies
         // ownership policy functions are forwarded to the Ownership type
         template <typename MultiPass>
         inline static void clone(MultiPass& mp)
-            { Ownership::clone(mp); }
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
 
         template <typename MultiPass>
         inline static bool release(MultiPass& mp)
@@ -358,7 +436,10 @@ namespace boost { namespace spirit { namespace iterator_policies
         // ownership policy functions are forwarded to the Ownership type
         template <typename MultiPass>
         inline static void clone(MultiPass& mp)
-            { Ownership::clone(mp); }
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
 
         template <typename MultiPass>
         inline static bool release(MultiPass& mp)
@@ -423,7 +504,10 @@ namespace boost { namespace spirit { namespace iterator_policies
         // ownership policy functions are forwarded to the Ownership type
         template <typename MultiPass>
         inline static void clone(MultiPass& mp)
-            { Ownership::clone(mp); }
+        {
+            Ownership::clone(mp);
+            detail::clone_storage<Storage>(mp);
+        }
 
         template <typename MultiPass>
         inline static bool release(MultiPass& mp)
@@ -68,6 +68,9 @@ namespace boost { namespace spirit { namespace detail
         template <typename MultiPass>
         static void destroy(MultiPass&) {}
 
+        template <typename MultiPass>
+        static void clone(MultiPass&) {}
+
         void swap(default_storage_policy&) {}
 
         template <typename MultiPass>
@@ -0,0 +1,316 @@
+//  Copyright (c) 2001 Daniel C. Nuffer
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(BOOST_SPIRIT_ITERATOR_SPLIT_CHUNKED_QUEUE_POLICY_OCT_18_2026_0600PM)
+#define BOOST_SPIRIT_ITERATOR_SPLIT_CHUNKED_QUEUE_POLICY_OCT_18_2026_0600PM
+
+#include <boost/spirit/home/support/iterators/multi_pass_fwd.hpp>
+#include <boost/spirit/home/support/iterators/detail/multi_pass.hpp>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost { namespace spirit { namespace iterator_policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  class split_chunked_queue
+    //
+    //  Implementation of the StoragePolicy used by multi_pass
+    //  This stores the data in a list of chunks of ChunkSize elements each.
+    //  Every iterator pins the chunk holding its position. The oldest chunks
+    //  are recycled through a free list as soon as no iterator is left on
+    //  them, so the memory in use is bounded by the distance between the
+    //  oldest and the newest iterator, not by the length of the input. The
+    //  buffer never reallocates, so the buffered elements do not move.
+    //
+    //  The iterator constructed from the input has no access to the queue
+    //  before it is first used, so the first chunk is pinned for it until
+    //  then, or until another iterator finds it is the only one left.
+    ///////////////////////////////////////////////////////////////////////////
+    template <std::size_t ChunkSize>
+    struct split_chunked_queue
+    {
+        BOOST_STATIC_ASSERT(ChunkSize > 0);
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Value>
+        struct chunk
+        {
+            chunk() : first(0), refs(0), next(0)
+            {
+                values.reserve(ChunkSize);
+            }
+
+            std::vector<Value> values;      // never grows past ChunkSize
+            std::size_t first;              // the position of values[0]
+            std::size_t refs;               // the iterators on this chunk
+            chunk* next;
+        };
+
+        template <typename Value>
+        struct shared;
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Value>
+        class unique //: public detail::default_storage_policy
+        {
+        private:
+            typedef chunk<Value> chunk_type;
+            typedef shared<Value> shared_type;
+
+        protected:
+            unique() : queued_chunk(0), queued_position(0) {}
+
+            unique(unique const& x)
+              : queued_chunk(x.queued_chunk)
+              , queued_position(x.queued_position)
+            {
+                if (0 != queued_chunk)
+                    ++queued_chunk->refs;
+            }
+
+            ~unique()
+            {
+                if (0 != queued_chunk)
+                    --queued_chunk->refs;
+            }
+
+            void swap(unique& x)
+            {
+                boost::swap(queued_chunk, x.queued_chunk);
+                boost::swap(queued_position, x.queued_position);
+            }
+
+            // This is called when the iterator is dereferenced.  It's a
+            // template method so we can recover the type of the multi_pass
+            // iterator and call get_input.
+            template <typename MultiPass>
+            static typename MultiPass::reference
+            dereference(MultiPass const& mp)
+            {
+                chunk_type* c = attach(mp);
+                if (mp.queued_position == mp.shared()->position)
+                    return MultiPass::get_input(mp);
+
+                BOOST_ASSERT(mp.queued_position - c->first < c->values.size());
+                return c->values[mp.queued_position - c->first];
+            }
+
+            // This is called when the iterator is incremented. It's a template
+            // method so we can recover the type of the multi_pass iterator
+            // and call is_unique and advance_input.
+            template <typename MultiPass>
+            static void increment(MultiPass& mp)
+            {
+                shared_type* s = mp.shared();
+                chunk_type* c = attach(mp);
+
+                if (s->origin_pinned && MultiPass::is_unique(mp))
+                {
+                    // the iterator without a chunk is gone
+                    s->origin_pinned = false;
+                    --s->first_chunk->refs;
+                    s->release_unused();
+                }
+
+                if (mp.queued_position == s->position)
+                {
+                    if (c == s->first_chunk && c->values.empty()
+                     && 1 == c->refs && MultiPass::is_unique(mp))
+                    {
+                        // this is the only iterator: nothing needs to be
+                        // kept, the chunk just moves along with it
+                        MultiPass::advance_input(mp);
+                        c->first = ++s->position;
+                        ++mp.queued_position;
+                        return;
+                    }
+
+                    BOOST_ASSERT(c == s->last_chunk);
+                    c->values.push_back(MultiPass::get_input(mp));
+                    MultiPass::advance_input(mp);
+                    ++s->position;
+                }
+
+                if (++mp.queued_position == c->first + ChunkSize)
+                {
+                    // move on to the next chunk, adding it if this one was
+                    // the newest
+                    if (0 == c->next)
+                    {
+                        c->next = s->allocate(mp.queued_position);
+                        s->last_chunk = c->next;
+                    }
+                    mp.queued_chunk = c->next;
+                    ++mp.queued_chunk->refs;
+                    --c->refs;
+
+                    // the other iterators leave their chunks without
+                    // access to the queue, so this is the place to catch up
+                    s->release_unused();
+                }
+            }
+
+            // called to forcibly clear the queue
+            template <typename MultiPass>
+            static void clear_queue(MultiPass& mp)
+            {
+                // the other iterators are invalid now (buf_id_check detects
+                // their use), their chunks are recycled once they are gone
+                shared_type* s = mp.shared();
+                chunk_type* c = attach(mp);
+                if (s->origin_pinned)
+                {
+                    s->origin_pinned = false;
+                    --s->first_chunk->refs;
+                }
+
+                mp.queued_position = s->position;
+                if (c != s->last_chunk)
+                {
+                    mp.queued_chunk = s->last_chunk;
+                    ++mp.queued_chunk->refs;
+                    --c->refs;
+                }
+                s->release_unused();
+            }
+
+            // called to determine whether the iterator is an eof iterator
+            template <typename MultiPass>
+            static bool is_eof(MultiPass const& mp)
+            {
+                return mp.queued_position == mp.shared()->position
+                    && MultiPass::input_at_eof(mp);
+            }
+
+            // called by operator==
+            template <typename MultiPass>
+            static bool equal_to(MultiPass const& mp, MultiPass const& x)
+            {
+                return mp.queued_position == x.queued_position;
+            }
+
+            // called by operator<
+            template <typename MultiPass>
+            static bool less_than(MultiPass const& mp, MultiPass const& x)
+            {
+                return mp.queued_position < x.queued_position;
+            }
+
+            // called before the shared data of the last iterator goes away
+            template <typename MultiPass>
+            static void destroy(MultiPass& mp)
+            {
+                mp.queued_chunk = 0;
+            }
+
+            // called when a copy of the iterator is made, a copy of the
+            // iterator without a chunk gets the first one
+            template <typename MultiPass>
+            static void clone(MultiPass& mp)
+            {
+                if (0 == mp.queued_chunk && 0 != mp.shared())
+                {
+                    BOOST_ASSERT(mp.shared()->origin_pinned);
+                    mp.queued_chunk = mp.shared()->first_chunk;
+                    ++mp.queued_chunk->refs;
+                }
+            }
+
+        private:
+            // the iterator constructed from the input has no chunk until it
+            // is first used, it takes over the pin of the first chunk then
+            template <typename MultiPass>
+            static chunk_type* attach(MultiPass const& mp)
+            {
+                if (0 == mp.queued_chunk)
+                {
+                    shared_type* s = mp.shared();
+                    BOOST_ASSERT(s->origin_pinned);
+                    s->origin_pinned = false;
+                    mp.queued_chunk = s->first_chunk;
+                }
+                return mp.queued_chunk;
+            }
+
+        protected:
+            mutable chunk_type* queued_chunk;
+            mutable std::size_t queued_position;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Value>
+        struct shared
+        {
+            typedef chunk<Value> chunk_type;
+
+            shared()
+              : first_chunk(new chunk_type), free_chunks(0)
+              , position(0), origin_pinned(true)
+            {
+                last_chunk = first_chunk;
+                first_chunk->refs = 1;
+            }
+
+            ~shared()
+            {
+                delete_chunks(first_chunk);
+                delete_chunks(free_chunks);
+            }
+
+            // a chunk starting at the given position, recycled if possible
+            chunk_type* allocate(std::size_t first)
+            {
+                chunk_type* c = free_chunks;
+                if (0 != c)
+                    free_chunks = c->next;
+                else
+                    c = new chunk_type;
+                c->first = first;
+                c->next = 0;
+                return c;
+            }
+
+            // recycles the oldest chunks that no iterator is on
+            void release_unused()
+            {
+                while (first_chunk != last_chunk && 0 == first_chunk->refs)
+                {
+                    chunk_type* c = first_chunk;
+                    first_chunk = c->next;
+                    c->values.clear();
+                    c->next = free_chunks;
+                    free_chunks = c;
+                }
+            }
+
+            static void delete_chunks(chunk_type* c)
+            {
+                while (0 != c)
+                {
+                    chunk_type* next = c->next;
+                    delete c;
+                    c = next;
+                }
+            }
+
+            chunk_type* first_chunk;        // the oldest chunk in use
+            chunk_type* last_chunk;         // the chunk the input goes to
+            chunk_type* free_chunks;
+            std::size_t position;           // the position of the input
+            bool origin_pinned;
+
+        private:
+            shared(shared const&);
+            shared& operator=(shared const&);
+        };
+
+    }; // split_chunked_queue
+
+}}}
+
+#endif
@@ -145,6 +145,9 @@ namespace boost { namespace spirit { namespace iterator_policies
             template <typename MultiPass>
             static void destroy(MultiPass&) {}
 
+            template <typename MultiPass>
+            static void clone(MultiPass&) {}
+
         protected:
             mutable typename queue_type::size_type queued_position;
         }; 
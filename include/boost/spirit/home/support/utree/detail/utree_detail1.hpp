@@ -31,22 +31,28 @@ namespace boost { namespace spirit { namespace detail
         template <typename Value>
         class node_iterator;
 
-        void free();
-        void copy(list const& other);
+        // The arena flag tells whether the nodes of this list come from the
+        // current utree_arena (see utree_arena.hpp) instead of the heap.
+        void free(bool arena);
+        void copy(list const& other, bool arena);
         void default_construct();
 
         template <typename T, typename Iterator>
-        void insert(T const& val, Iterator pos);
+        void insert(T const& val, Iterator pos, bool arena);
 
         template <typename T>
-        void push_front(T const& val);
+        void push_front(T const& val, bool arena);
 
         template <typename T>
-        void push_back(T const& val);
+        void push_back(T const& val, bool arena);
+
+        void pop_front(bool arena);
+        void pop_back(bool arena);
+        node* erase(node* pos, bool arena);
 
-        void pop_front();
-        void pop_back();
-        node* erase(node* pos);
+        template <typename T>
+        static node* new_node(T const& val, node* next, node* prev, bool arena);
+        static void delete_node(node* p, bool arena);
 
         node* first;
         node* last;
@@ -94,6 +100,10 @@ namespace boost { namespace spirit { namespace detail
     // characters are allowed, making it suitable to encode raw binary. The
     // string length is encoded in the first byte if the string is placed in-situ,
     // else, the length plus a pointer to the string in the heap are stored.
+    //
+    // Bit 0 of the info byte is the heap flag, bit 6 is the arena flag (the
+    // heap string, list nodes or function object are owned by a utree_arena)
+    // and the bits in between hold the utree type.
     ///////////////////////////////////////////////////////////////////////////
     struct fast_string // Keep this a POD!
     {
@@ -123,6 +133,8 @@ namespace boost { namespace spirit { namespace detail
         int get_type() const;
         void set_type(int t);
         bool is_heap_allocated() const;
+        bool is_arena_allocated() const;
+        void set_arena_allocated(bool arena);
 
         std::size_t size() const;
         char const* str() const;
@@ -19,6 +19,7 @@
 #include <boost/utility/enable_if.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/iterator/iterator_traits.hpp>
+#include <cstring>
 
 namespace boost { namespace spirit { namespace detail
 {
@@ -34,12 +35,12 @@ namespace boost { namespace spirit { namespace detail
 
     inline int fast_string::get_type() const
     {
-        return info() >> 1;
+        return (info() >> 1) & 0x1f;
     }
 
     inline void fast_string::set_type(int t)
     {
-        info() = (t << 1) | (info() & 1);
+        info() = (t << 1) | (info() & 0x41);
     }
 
     inline short fast_string::tag() const
@@ -60,6 +61,19 @@ namespace boost { namespace spirit { namespace detail
         return info() & 1;
     }
 
+    inline bool fast_string::is_arena_allocated() const
+    {
+        return info() & 0x40;
+    }
+
+    inline void fast_string::set_arena_allocated(bool arena)
+    {
+        if (arena)
+            info() |= 0x40;
+        else
+            info() &= ~0x40;
+    }
+
     inline std::size_t fast_string::size() const
     {
         if (is_heap_allocated())
@@ -87,15 +101,21 @@ namespace boost { namespace spirit { namespace detail
             // of the string is placed in buff[small_string_size - 1]
             str = buff;
             buff[max_string_len] = static_cast<char>(max_string_len - size);
-            info() &= ~0x1;
+            info() &= ~0x41;
         }
         else
         {
-            // else, store it in the heap
-            str = new char[size + 1]; // add one for the null char
+            // else, store it in the heap, or in the current arena if there
+            // is one
+            utree_arena* arena = utree_arena::current();
+            if (arena)
+                str = static_cast<char*>(arena->allocate(size + 1));
+            else
+                str = new char[size + 1]; // add one for the null char
             heap.str = str;
             heap.size = size;
             info() |= 0x1;
+            set_arena_allocated(arena != 0);
         }
         for (std::size_t i = 0; i != size; ++i)
         {
@@ -111,7 +131,7 @@ namespace boost { namespace spirit { namespace detail
 
     inline void fast_string::free()
     {
-        if (is_heap_allocated())
+        if (is_heap_allocated() && !is_arena_allocated())
         {
             delete [] heap.str;
         }
@@ -259,23 +279,51 @@ namespace boost { namespace spirit { namespace detail
     template <typename Value>
     Value list::node_iterator<boost::reference_wrapper<Value> >::nil_node = Value();
 
-    inline void list::free()
+    template <typename T>
+    inline list::node* list::new_node(
+        T const& val, node* next, node* prev, bool arena)
+    {
+        if (arena)
+        {
+            // A list built in an arena must only grow while a scope of that
+            // arena is active: a node from the heap would never be deleted.
+            utree_arena* a = utree_arena::current();
+            if (a == 0)
+            {
+                BOOST_THROW_EXCEPTION(bad_type_exception(
+                    "arena allocated list modified outside of an arena scope"
+                  , utree_type::list_type));
+            }
+            return new (a->allocate(sizeof(node))) node(val, next, prev);
+        }
+        return new node(val, next, prev);
+    }
+
+    inline void list::delete_node(node* p, bool arena)
+    {
+        if (arena)
+            p->~node();
+        else
+            delete p;
+    }
+
+    inline void list::free(bool arena)
     {
         node* p = first;
         while (p != 0)
         {
             node* next = p->next;
-            delete p;
+            delete_node(p, arena);
             p = next;
         }
     }
 
-    inline void list::copy(list const& other)
+    inline void list::copy(list const& other, bool arena)
     {
         node* p = other.first;
         while (p != 0)
         {
-            push_back(p->val);
+            push_back(p->val, arena);
             p = p->next;
         }
     }
@@ -287,16 +335,16 @@ namespace boost { namespace spirit { namespace detail
     }
 
     template <typename T, typename Iterator>
-    inline void list::insert(T const& val, Iterator pos)
+    inline void list::insert(T const& val, Iterator pos, bool arena)
     {
         if (!pos.node)
         {
-            push_back(val);
+            push_back(val, arena);
             return;
         }
 
         detail::list::node* new_node =
-            new detail::list::node(val, pos.node, pos.node->prev);
+            list::new_node(val, pos.node, pos.node->prev, arena);
 
         if (pos.node->prev)
             pos.node->prev->next = new_node;
@@ -308,18 +356,18 @@ namespace boost { namespace spirit { namespace detail
     }
 
     template <typename T>
-    inline void list::push_front(T const& val)
+    inline void list::push_front(T const& val, bool arena)
     {
         detail::list::node* new_node;
         if (first == 0)
         {
-            new_node = new detail::list::node(val, 0, 0);
+            new_node = list::new_node(val, 0, 0, arena);
             first = last = new_node;
             ++size;
         }
         else
         {
-            new_node = new detail::list::node(val, first, first->prev);
+            new_node = list::new_node(val, first, first->prev, arena);
             first->prev = new_node;
             first = new_node;
             ++size;
@@ -327,25 +375,25 @@ namespace boost { namespace spirit { namespace detail
     }
 
     template <typename T>
-    inline void list::push_back(T const& val)
+    inline void list::push_back(T const& val, bool arena)
     {
         if (last == 0)
-            push_front(val);
+            push_front(val, arena);
         else {
             detail::list::node* new_node =
-                new detail::list::node(val, last->next, last);
+                list::new_node(val, last->next, last, arena);
             last->next = new_node;
             last = new_node;
             ++size;
         }
     }
 
-    inline void list::pop_front()
+    inline void list::pop_front(bool arena)
     {
         BOOST_ASSERT(size != 0);
         if (first == last) // there's only one item
         {
-            delete first;
+            delete_node(first, arena);
             size = 0;
             first = last = 0;
         }
@@ -354,17 +402,17 @@ namespace boost { namespace spirit { namespace detail
             node* np = first;
             first = first->next;
             first->prev = 0;
-            delete np;
+            delete_node(np, arena);
             --size;
         }
     }
 
-    inline void list::pop_back()
+    inline void list::pop_back(bool arena)
     {
         BOOST_ASSERT(size != 0);
         if (first == last) // there's only one item
         {
-            delete first;
+            delete_node(first, arena);
             size = 0;
             first = last = 0;
         }
@@ -373,29 +421,29 @@ namespace boost { namespace spirit { namespace detail
             node* np = last;
             last = last->prev;
             last->next = 0;
-            delete np;
+            delete_node(np, arena);
             --size;
         }
     }
 
-    inline list::node* list::erase(node* pos)
+    inline list::node* list::erase(node* pos, bool arena)
     {
         BOOST_ASSERT(pos != 0);
         if (pos == first)
         {
-            pop_front();
+            pop_front(arena);
             return first;
         }
         else if (pos == last)
         {
-            pop_back();
+            pop_back(arena);
             return 0;
         }
         else
         {
             node* next(pos->next);
             pos->unlink();
-            delete pos;
+            delete_node(pos, arena);
             --size;
             return next;
         }
@@ -790,6 +838,7 @@ namespace boost { namespace spirit
         s.initialize();
         pf = pf_.clone();
         set_type(type::function_type);
+        own_function();
     }
 
     inline utree::utree(function_base* pf_)
@@ -947,6 +996,7 @@ namespace boost { namespace spirit
         free();
         pf = pf_.clone();
         set_type(type::function_type);
+        own_function();
         return *this;
     }
 
@@ -1022,7 +1072,7 @@ namespace boost { namespace spirit
             return p->push_front(val);
 
         ensure_list_type("push_front()");
-        l.push_front(val);
+        l.push_front(val, s.is_arena_allocated());
     }
 
     template <typename T>
@@ -1032,7 +1082,7 @@ namespace boost { namespace spirit
             return p->push_back(val);
 
         ensure_list_type("push_back()");
-        l.push_back(val);
+        l.push_back(val, s.is_arena_allocated());
     }
 
     template <typename T>
@@ -1044,10 +1094,10 @@ namespace boost { namespace spirit
         ensure_list_type("insert()");
         if (!pos.node)
         {
-            l.push_back(val);
+            l.push_back(val, s.is_arena_allocated());
             return utree::iterator(l.last, l.last->prev);
         }
-        l.insert(val, pos);
+        l.insert(val, pos, s.is_arena_allocated());
         return utree::iterator(pos.node->prev, pos.node->prev->prev);
     }
 
@@ -1081,6 +1131,7 @@ namespace boost { namespace spirit
 
         clear();
         set_type(type::list_type);
+        s.set_arena_allocated(utree_arena::current() != 0);
 
         while (first != last)
         {
@@ -1109,7 +1160,7 @@ namespace boost { namespace spirit
                     ("pop_front() called on non-list utree type",
                      get_type()));
 
-        l.pop_front();
+        l.pop_front(s.is_arena_allocated());
     }
 
     inline void utree::pop_back()
@@ -1122,7 +1173,7 @@ namespace boost { namespace spirit
                     ("pop_back() called on non-list utree type",
                      get_type()));
 
-        l.pop_back();
+        l.pop_back(s.is_arena_allocated());
     }
 
     inline utree::iterator utree::erase(iterator pos)
@@ -1135,7 +1186,7 @@ namespace boost { namespace spirit
                     ("erase() called on non-list utree type",
                      get_type()));
 
-        detail::list::node* np = l.erase(pos.node);
+        detail::list::node* np = l.erase(pos.node, s.is_arena_allocated());
         return iterator(np, np?np->prev:l.last);
     }
 
@@ -1418,6 +1469,7 @@ namespace boost { namespace spirit
         {
             set_type(type::list_type);
             l.default_construct();
+            s.set_arena_allocated(utree_arena::current() != 0);
         }
         else if (get_type() != type::list_type)
         {
@@ -1437,10 +1489,14 @@ namespace boost { namespace spirit
                 s.free();
                 break;
             case type::list_type:
-                l.free();
+                // arena nodes are released with the arena, all at once, but
+                // the elements may still own heap storage: they are visited
+                // in O(n) either way
+                l.free(s.is_arena_allocated());
                 break;
             case type::function_type:
-                delete pf;
+                if (!s.is_arena_allocated())
+                    delete pf;
                 break;
             default:
                 break;
@@ -1491,6 +1547,7 @@ namespace boost { namespace spirit
                 break;
             case type::function_type:
                 pf = other.pf->clone();
+                own_function();
                 s.tag(other.s.tag());
                 break;
             case type::string_type:
@@ -1500,12 +1557,24 @@ namespace boost { namespace spirit
                 s.tag(other.s.tag());
                 break;
             case type::list_type:
-                l.copy(other.l);
+                s.set_arena_allocated(utree_arena::current() != 0);
+                l.copy(other.l, s.is_arena_allocated());
                 s.tag(other.s.tag());
                 break;
         }
     }
 
+    inline void utree::own_function()
+    {
+        // hand a cloned function object over to the current arena, if any
+        utree_arena* arena = utree_arena::current();
+        if (arena)
+        {
+            arena->own(pf);
+            s.set_arena_allocated(true);
+        }
+    }
+
     template <typename T>
     struct is_iterator_range
       : boost::mpl::false_
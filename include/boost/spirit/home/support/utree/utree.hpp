@@ -31,6 +31,7 @@
 #include <boost/ref.hpp>
 #include <boost/config.hpp>
 
+#include <boost/spirit/home/support/utree/utree_arena.hpp>
 #include <boost/spirit/home/support/utree/detail/utree_detail1.hpp>
 
 #if defined(BOOST_MSVC)
@@ -590,6 +591,7 @@ namespace boost { namespace spirit
         void set_type(type::info);
         void free();
         void copy(const_reference);
+        void own_function();
 
         union {
             detail::fast_string s;
@@ -0,0 +1,212 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(BOOST_SPIRIT_UTREE_ARENA)
+#define BOOST_SPIRIT_UTREE_ARENA
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+// The active scope is a thread local, a global would let a scope redirect
+// the allocations of every thread.
+#if defined(BOOST_NO_CXX11_THREAD_LOCAL) && defined(BOOST_HAS_THREADS)
+#define BOOST_SPIRIT_NO_UTREE_ARENA_SCOPE
+#endif
+
+namespace boost { namespace spirit
+{
+    //[utree_arena
+    /*`A `utree_arena` is a monotonic memory arena for utree storage. While a
+       `utree_arena::scope` is active on the current thread, every list node,
+       heap allocated string and cloned function object created by a utree
+       comes from the arena instead of the free store. Such storage is never
+       released piecewise, the memory is handed back all at once by
+       `release()` or the destructor of the arena. Destroying a utree built
+       inside the scope still visits every element of its lists, as these
+       may have been given heap storage since, so it takes O(n) time, but
+       frees no list node.
+
+       The arena must outlive all utrees built inside its scope. A list built
+       inside the scope may grow again only while a scope of the same arena
+       is active, otherwise a `bad_type_exception` is thrown. Copying a utree
+       outside of any scope makes an ordinary, independent deep copy.
+
+       The active scope is kept per thread. Without C++11 `thread_local`,
+       scopes are only available in single threaded builds, otherwise
+       `BOOST_SPIRIT_NO_UTREE_ARENA_SCOPE` is defined.
+    */
+    class utree_arena : boost::noncopyable
+    {
+    public:
+#if !defined(BOOST_SPIRIT_NO_UTREE_ARENA_SCOPE)
+        class scope : boost::noncopyable
+        {
+        public:
+            explicit scope(utree_arena& arena)
+              : previous(current_ref())
+            {
+                current_ref() = &arena;
+            }
+
+            ~scope()
+            {
+                current_ref() = previous;
+            }
+
+        private:
+            utree_arena* previous;
+        };
+#endif
+
+        explicit utree_arena(std::size_t block_size_ = 64 * 1024)
+          : blocks(0), ptr(0), last(0), block_size(block_size_), used(0)
+        {}
+
+        ~utree_arena()
+        {
+            release();
+        }
+
+        // The arena of the innermost active scope on this thread, or 0.
+        static utree_arena* current()
+        {
+            return current_ref();
+        }
+
+        void* allocate(std::size_t size)
+        {
+            size = (size + alignment - 1) & ~(alignment - 1);
+            if (size > static_cast<std::size_t>(last - ptr))
+                return allocate_block(size);
+
+            void* p = ptr;
+            ptr += size;
+            used += size;
+            return p;
+        }
+
+        // Delete p when the arena is released.
+        template <typename T>
+        void own(T* p)
+        {
+            cleanup c = { p, &delete_object<T> };
+            cleanups.push_back(c);
+        }
+
+        void release()
+        {
+            for (std::size_t i = cleanups.size(); i != 0; --i)
+                cleanups[i-1].destroy(cleanups[i-1].p);
+            cleanups.clear();
+
+            while (blocks != 0)
+            {
+                block* next = blocks->next;
+                ::operator delete(blocks);
+                blocks = next;
+            }
+            ptr = last = 0;
+            used = 0;
+        }
+
+        // number of bytes handed out since the last release()
+        std::size_t size() const
+        {
+            return used;
+        }
+
+    private:
+        union max_align
+        {
+            long double ld;
+            double d;
+            long long ll;
+            void* p;
+        };
+
+        static std::size_t const alignment =
+            boost::alignment_of<max_align>::value;
+
+        struct block
+        {
+            block* next;
+        };
+
+        static std::size_t const header_size =
+            (sizeof(block) + alignment - 1) & ~(alignment - 1);
+
+        struct cleanup
+        {
+            void* p;
+            void (*destroy)(void*);
+        };
+
+        template <typename T>
+        static void delete_object(void* p)
+        {
+            delete static_cast<T*>(p);
+        }
+
+        static utree_arena*& current_ref()
+        {
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+            static thread_local utree_arena* current = 0;
+#else
+            // there is no scope to set it in multi threaded builds
+            static utree_arena* current = 0;
+#endif
+            return current;
+        }
+
+        void* allocate_block(std::size_t size)
+        {
+            // Requests larger than half a block get a block of their own, so
+            // the rest of the current block can still be used.
+            bool const dedicated = size > block_size / 2;
+            std::size_t const bytes =
+                header_size + (dedicated ? size : block_size);
+
+            block* b = static_cast<block*>(::operator new(bytes));
+            char* data = reinterpret_cast<char*>(b) + header_size;
+
+            if (dedicated && blocks != 0)
+            {
+                b->next = blocks->next;
+                blocks->next = b;
+            }
+            else
+            {
+                b->next = blocks;
+                blocks = b;
+                if (!dedicated)
+                {
+                    ptr = data + size;
+                    last = data + block_size;
+                }
+            }
+
+            used += size;
+            return data;
+        }
+
+        block* blocks;
+        char* ptr;
+        char* last;
+        std::size_t block_size;
+        std::size_t used;
+        std::vector<cleanup> cleanups;
+    };
+    //]
+}}
+
+#endif
@@ -33,6 +33,16 @@ namespace boost { namespace spirit { namespace x3
           , typename RuleContext, typename Attribute>
         bool parse(Iterator& first, Iterator const& last
           , Context const& context, RuleContext& rcontext, Attribute& attr) const
+        {
+            return parse(first, last, context, rcontext, attr
+              , has_expectation_failure_info<Context>());
+        }
+
+        template <typename Iterator, typename Context
+          , typename RuleContext, typename Attribute>
+        bool parse(Iterator& first, Iterator const& last
+          , Context const& context, RuleContext& rcontext, Attribute& attr
+          , mpl::false_ /* expectation failures are thrown */) const
         {
             for (;;)
             {
@@ -62,6 +72,44 @@ namespace boost { namespace spirit { namespace x3
             return false;
         }
 
+        template <typename Iterator, typename Context
+          , typename RuleContext, typename Attribute>
+        bool parse(Iterator& first, Iterator const& last
+          , Context const& context, RuleContext& rcontext, Attribute& attr
+          , mpl::true_ /* expectation failures are recorded */) const
+        {
+            auto& failure = get_expectation_failure_info(context);
+            for (;;)
+            {
+                Iterator i = first;
+                if (this->subject.parse(i, last, context, rcontext, attr))
+                {
+                    first = i;
+                    return true;
+                }
+
+                if (!failure.failed())
+                    return false;
+
+                expectation_failure<Iterator> const x(
+                    failure.where(), failure.which());
+                switch (handler(first, last, x, context))
+                {
+                    case error_handler_result::fail:
+                        failure.clear();
+                        return false;
+                    case error_handler_result::retry:
+                        failure.clear();
+                        continue;
+                    case error_handler_result::accept:
+                        failure.clear();
+                        return true;
+                    case error_handler_result::rethrow:
+                        return false;
+                }
+            }
+        }
+
         Handler handler;
     };
 }}}
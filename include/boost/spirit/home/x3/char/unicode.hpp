@@ -401,6 +401,77 @@ namespace boost { namespace spirit { namespace x3
 #undef BOOST_SPIRIT_X3_CLASSIFY
     };
 
+    namespace detail
+    {
+        // The ASCII members of the unicode char classes, one bit for each
+        // character: lo holds 0x00 to 0x3f, hi 0x40 to 0x7f. These are
+        // taken from the UCD tables, the classes not listed have none.
+        template <typename Tag>
+        struct unicode_ascii_class
+        {
+            static ::boost::uint64_t const lo = 0;
+            static ::boost::uint64_t const hi = 0;
+        };
+
+#define BOOST_SPIRIT_X3_ASCII_CLASS(name, lo_, hi_)                             \
+        template <>                                                             \
+        struct unicode_ascii_class<name##_tag>                                  \
+        {                                                                       \
+            static ::boost::uint64_t const lo = lo_##ULL;                       \
+            static ::boost::uint64_t const hi = hi_##ULL;                       \
+        };                                                                      \
+        /***/
+
+        BOOST_SPIRIT_X3_ASCII_CLASS(char, 0xffffffffffffffff, 0xffffffffffffffff)
+        BOOST_SPIRIT_X3_ASCII_CLASS(alnum, 0x03ff000000000000, 0x07fffffe07fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(alpha, 0x0000000000000000, 0x07fffffe07fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(digit, 0x03ff000000000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(xdigit, 0x03ff000000000000, 0x0000007e0000007e)
+        BOOST_SPIRIT_X3_ASCII_CLASS(cntrl, 0x00000000ffffffff, 0x8000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(graph, 0xfffffffe00000000, 0x7fffffffffffffff)
+        BOOST_SPIRIT_X3_ASCII_CLASS(lower, 0x0000000000000000, 0x07fffffe00000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(print, 0xffffffff00000000, 0x7fffffffffffffff)
+        BOOST_SPIRIT_X3_ASCII_CLASS(punct, 0x8c00f7ee00000000, 0x28000000b8000001)
+        BOOST_SPIRIT_X3_ASCII_CLASS(space, 0x0000000100003e00, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(blank, 0x0000000100000200, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(upper, 0x0000000000000000, 0x0000000007fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(letter, 0x0000000000000000, 0x07fffffe07fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(number, 0x03ff000000000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(separator, 0x0000000100000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(other, 0x00000000ffffffff, 0x8000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(punctuation, 0x8c00f7ee00000000, 0x28000000b8000001)
+        BOOST_SPIRIT_X3_ASCII_CLASS(symbol, 0x7000081000000000, 0x5000000140000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(uppercase_letter, 0x0000000000000000, 0x0000000007fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(lowercase_letter, 0x0000000000000000, 0x07fffffe00000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(decimal_number, 0x03ff000000000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(space_separator, 0x0000000100000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(control, 0x00000000ffffffff, 0x8000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(dash_punctuation, 0x0000200000000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(open_punctuation, 0x0000010000000000, 0x0800000008000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(close_punctuation, 0x0000020000000000, 0x2000000020000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(connector_punctuation, 0x0000000000000000, 0x0000000080000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(other_punctuation, 0x8c00d4ee00000000, 0x0000000010000001)
+        BOOST_SPIRIT_X3_ASCII_CLASS(math_symbol, 0x7000080000000000, 0x5000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(currency_symbol, 0x0000001000000000, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(modifier_symbol, 0x0000000000000000, 0x0000000140000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(alphabetic, 0x0000000000000000, 0x07fffffe07fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(uppercase, 0x0000000000000000, 0x0000000007fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(lowercase, 0x0000000000000000, 0x07fffffe00000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(white_space, 0x0000000100003e00, 0x0000000000000000)
+        BOOST_SPIRIT_X3_ASCII_CLASS(hex_digit, 0x03ff000000000000, 0x0000007e0000007e)
+        BOOST_SPIRIT_X3_ASCII_CLASS(latin, 0x0000000000000000, 0x07fffffe07fffffe)
+        BOOST_SPIRIT_X3_ASCII_CLASS(common, 0xffffffffffffffff, 0xf8000001f8000001)
+
+#undef BOOST_SPIRIT_X3_ASCII_CLASS
+
+        template <typename Tag>
+        inline bool is_unicode_ascii_class(::boost::uint32_t ch)
+        {
+            typedef unicode_ascii_class<Tag> ascii;
+            return ((ch < 64 ? ascii::lo >> ch : ascii::hi >> (ch - 64)) & 1) != 0;
+        }
+    }
+
     template <typename Tag>
     struct unicode_char_class
       : char_parser<unicode_char_class<Tag>>
@@ -414,6 +485,11 @@ namespace boost { namespace spirit { namespace x3
         template <typename Char, typename Context>
         bool test(Char ch, Context const&) const
         {
+            // ASCII is looked up in a bitmap, the rest in the UCD tables
+            char_type const c = detail::cast_char<char_type>(ch);
+            if (c < 0x80)
+                return detail::is_unicode_ascii_class<Tag>(c);
+
             return ((sizeof(Char) <= sizeof(char_type)) || encoding::ischar(ch))
                 && unicode_char_class_base::is(tag(), ch);
         }
@@ -0,0 +1,234 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_PARSE_PARALLEL_OCT_18_2026_0700PM)
+#define BOOST_SPIRIT_X3_PARSE_PARALLEL_OCT_18_2026_0700PM
+
+#include <boost/spirit/home/x3/support/context.hpp>
+#include <boost/spirit/home/x3/support/unused.hpp>
+#include <boost/spirit/home/x3/support/traits/container_traits.hpp>
+#include <boost/spirit/home/x3/core/parser.hpp>
+#include <boost/spirit/home/x3/core/skip_over.hpp>
+#include <boost/spirit/home/x3/operator/kleene.hpp>
+#include <boost/spirit/home/support/detail/find_line_break.hpp>
+#include <boost/mpl/bool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace boost { namespace spirit { namespace x3
+{
+    ///////////////////////////////////////////////////////////////////////////
+    struct parallel_options
+    {
+        std::size_t chunk_size = 256 * 1024;    // bytes, rounded up to a record
+        unsigned threads = 0;                   // 0: hardware concurrency
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Record boundary finder for line based input: returns the start of the
+    // line following the one pos is in ("\n", "\r\n" or "\r" ends a line),
+    // or last.
+    ///////////////////////////////////////////////////////////////////////////
+    struct line_boundary
+    {
+        char const* operator()(char const* pos, char const* last) const
+        {
+            pos = spirit::detail::find_line_break(pos, last);
+            if (pos != last && *pos++ == '\r' && pos != last && *pos == '\n')
+                ++pos;
+            return pos;
+        }
+
+        template <typename Iterator>
+        Iterator operator()(Iterator pos, Iterator last) const
+        {
+            char const* const base = &*pos;
+            return pos + ((*this)(base, base + (last - pos)) - base);
+        }
+    };
+
+    namespace detail
+    {
+        template <typename Iterator, typename Parser, typename Context
+          , typename Attribute>
+        bool parse_parallel_chunk(Iterator& first, Iterator last
+          , Parser const& records, Context const& context, Attribute& attr)
+        {
+            records.parse(first, last, context, unused, attr);
+            x3::skip_over(first, last, context);
+            return first == last;
+        }
+
+        template <typename Attribute>
+        void reserve_parallel_results(Attribute& attr, std::size_t size
+          , mpl::true_)
+        {
+            attr.reserve(attr.size() + size);
+        }
+
+        template <typename Attribute>
+        void reserve_parallel_results(Attribute&, std::size_t, mpl::false_)
+        {
+        }
+
+        template <typename Iterator, typename Parser, typename Finder
+          , typename Context, typename Attribute>
+        bool parse_parallel_main(Iterator& first, Iterator last
+          , Parser const& record, Finder const& next_record
+          , Context const& context, Attribute& attr
+          , parallel_options const& options)
+        {
+            // split the input into chunks that end at record boundaries
+            std::vector<Iterator> bounds(1, first);
+            std::size_t const chunk_size = (std::max)(
+                options.chunk_size, std::size_t(1));
+            while (bounds.back() != last)
+            {
+                Iterator const from = bounds.back();
+                Iterator const pos = std::size_t(last - from) <= chunk_size ?
+                    last : next_record(from + chunk_size, last);
+                bounds.push_back(pos);
+            }
+
+            std::size_t const chunks = bounds.size() - 1;
+            std::vector<Attribute> results(chunks);
+            std::vector<Iterator> stops(bounds.begin(), bounds.end() - 1);
+            std::vector<std::exception_ptr> errors(chunks);
+
+            // the chunks are taken in input order, and none after the
+            // first one that failed
+            std::atomic<std::size_t> next(0);
+            std::atomic<std::size_t> failed(chunks);
+            auto const worker = [&]()
+            {
+                for (std::size_t i; (i = next++) < failed.load(); )
+                {
+                    bool r = false;
+                    try
+                    {
+                        r = parse_parallel_chunk(stops[i], bounds[i + 1]
+                          , *record, context, results[i]);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                    if (!r)
+                    {
+                        std::size_t f = failed.load();
+                        while (i < f && !failed.compare_exchange_weak(f, i))
+                            ;
+                    }
+                }
+            };
+
+            unsigned threads = options.threads ?
+                options.threads : std::thread::hardware_concurrency();
+            threads = static_cast<unsigned>((std::min)(
+                std::size_t((std::max)(threads, 1u)), chunks));
+
+            std::vector<std::thread> pool;
+            try
+            {
+                for (unsigned t = 1; t < threads; ++t)
+                    pool.emplace_back(worker);
+            }
+            catch (...)
+            {
+                // a thread failed to start: stop the started ones, as
+                // destroying them while joinable would terminate
+                failed = 0;
+                for (auto& t : pool)
+                    t.join();
+                throw;
+            }
+            worker();
+            for (auto& t : pool)
+                t.join();
+
+            std::size_t const done = failed.load();
+            std::size_t size = 0;
+            for (std::size_t i = 0; i != done; ++i)
+            {
+                size += std::distance(
+                    traits::begin(results[i]), traits::end(results[i]));
+            }
+            reserve_parallel_results(attr, size
+              , traits::is_reservable<Attribute>());
+            for (std::size_t i = 0; i != done; ++i)
+            {
+                traits::append(attr
+                  , std::make_move_iterator(traits::begin(results[i]))
+                  , std::make_move_iterator(traits::end(results[i])));
+            }
+
+            if (done != chunks)
+            {
+                // the error is where the first failing chunk stopped
+                first = stops[done];
+                if (errors[done])
+                    std::rethrow_exception(errors[done]);
+                return false;
+            }
+            first = last;
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Parses a contiguous input made of records, such as lines, in parallel.
+    //  The input is split into chunks of about options.chunk_size at the
+    //  record boundaries found by next_record(pos, last), which returns the
+    //  start of the first record after pos. Each chunk is parsed as *record
+    //  on a pool of threads and the attribute containers of the chunks are
+    //  appended to attr in input order.
+    //
+    //  Returns true if the whole input was parsed. On failure first is set
+    //  where the first failing chunk stopped, and the records of the chunks
+    //  before it are in attr. An exception thrown while parsing that chunk
+    //  (e.g. an expectation_failure) is rethrown. The grammar must not
+    //  depend on what precedes a chunk, and its semantic actions must be
+    //  safe to run concurrently.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator, typename Parser, typename Finder
+      , typename Attribute>
+    inline bool
+    parse_parallel(
+        Iterator& first
+      , Iterator last
+      , Parser const& record
+      , Finder const& next_record
+      , Attribute& attr
+      , parallel_options const& options = parallel_options())
+    {
+        return detail::parse_parallel_main(first, last, as_parser(record)
+          , next_record, unused, attr, options);
+    }
+
+    template <typename Iterator, typename Parser, typename Skipper
+      , typename Finder, typename Attribute>
+    inline bool
+    phrase_parse_parallel(
+        Iterator& first
+      , Iterator last
+      , Parser const& record
+      , Skipper const& s
+      , Finder const& next_record
+      , Attribute& attr
+      , parallel_options const& options = parallel_options())
+    {
+        auto const skipper_ctx = make_context<skipper_tag>(as_parser(s));
+        return detail::parse_parallel_main(first, last, as_parser(record)
+          , next_record, skipper_ctx, attr, options);
+    }
+}}}
+
+#endif
@@ -0,0 +1,237 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_PUSH_PARSER_OCT_18_2026_0500PM)
+#define BOOST_SPIRIT_X3_PUSH_PARSER_OCT_18_2026_0500PM
+
+#include <boost/spirit/home/x3/support/context.hpp>
+#include <boost/spirit/home/x3/support/unused.hpp>
+#include <boost/spirit/home/x3/core/parser.hpp>
+#include <boost/spirit/home/x3/core/skip_over.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost { namespace spirit { namespace x3
+{
+    namespace detail
+    {
+        // The end of the input fed so far, and whether the parser looked
+        // at it
+        struct push_input
+        {
+            char const* end;
+            bool hit_end;
+        };
+
+        // Iterates the fed input, noting when a parser reaches its end:
+        // the parser might have gone further had there been more input.
+        class push_iterator
+          : public boost::iterator_adaptor<push_iterator, char const*>
+        {
+        public:
+
+            push_iterator()
+              : push_iterator::iterator_adaptor_(0), input(0) {}
+
+            push_iterator(char const* pos, push_input* input)
+              : push_iterator::iterator_adaptor_(pos), input(input) {}
+
+        private:
+
+            friend class boost::iterator_core_access;
+
+            bool equal(push_iterator const& other) const
+            {
+                bool const result = this->base() == other.base();
+                if (result && input && this->base() == input->end)
+                    input->hit_end = true;
+                return result;
+            }
+
+            std::ptrdiff_t distance_to(push_iterator const& other) const
+            {
+                if (input && other.base() == input->end)
+                    input->hit_end = true;
+                return other.base() - this->base();
+            }
+
+            push_input* input;
+        };
+
+        inline unused_type make_push_context(unused_type)
+        {
+            return unused;
+        }
+
+        template <typename Skipper>
+        inline auto make_push_context(Skipper const& skipper)
+        {
+            return make_context<skipper_tag>(skipper);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Parses a stream of records fed in chunks, such as data read from a
+    //  socket. Each chunk is appended to the unconsumed tail of the input
+    //  and every record that can be parsed from it is passed to the handler
+    //  as soon as it is complete. A record that needs more input than was
+    //  fed is parsed again from its start when the next chunk arrives, so
+    //  only the tail from the start of the current record is kept.
+    //
+    //  A record is complete when it matched without looking at the end of
+    //  the input fed so far: a parser like int_ that stops at the end might
+    //  continue in the next chunk. finish() ends the stream and parses the
+    //  rest of the input as it is.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Parser, typename Skipper, typename Attribute
+      , typename Handler>
+    class push_parser
+    {
+    public:
+
+        typedef detail::push_iterator iterator_type;
+        typedef Attribute attribute_type;
+
+        push_parser(Parser const& p, Skipper const& skipper, Handler handler)
+          : p(p), skipper(skipper), handler(std::move(handler))
+          , consumed_(0), failed_(false) {}
+
+        // Appends size bytes to the input and parses the records that are
+        // complete. Returns false once the input failed to parse.
+        bool feed(char const* data, std::size_t size)
+        {
+            if (failed_)
+                return false;
+            buffer.insert(buffer.end(), data, data + size);
+            return parse_records(false);
+        }
+
+        bool feed(std::string const& data)
+        {
+            return feed(data.data(), data.size());
+        }
+
+        // Ends the input. Returns true if all of it was parsed into records.
+        bool finish()
+        {
+            if (failed_)
+                return false;
+            return parse_records(true);
+        }
+
+        // The number of bytes held for the next records
+        std::size_t buffered() const { return buffer.size(); }
+
+        // The stream offset of the first byte that is not part of a parsed
+        // record, or of the error if the input failed to parse
+        std::size_t consumed() const { return consumed_; }
+
+        bool failed() const { return failed_; }
+
+        // What was expected if the input failed on an expectation
+        std::string const& which() const { return which_; }
+
+    private:
+
+        bool parse_records(bool at_end)
+        {
+            char const* const base = buffer.data();
+            detail::push_input input = { base + buffer.size(), false };
+            iterator_type const last(input.end, &input);
+            auto const context = detail::make_push_context(skipper);
+
+            char const* start = base;
+            while (true)
+            {
+                iterator_type first(start, &input);
+                input.hit_end = false;
+                x3::skip_over(first, last, context);
+                if (first.base() == input.end)
+                {
+                    start = input.end;
+                    break;
+                }
+
+                Attribute attr;
+                bool r;
+                try
+                {
+                    r = p.parse(first, last, context, unused, attr);
+                }
+                catch (expectation_failure<iterator_type> const& x)
+                {
+                    if (input.hit_end && !at_end)
+                        break;
+                    consume(start - base);
+                    return fail(x.where().base() - start, x.which());
+                }
+
+                if (input.hit_end && !at_end)
+                    break;
+                if (!r || first.base() == start)
+                {
+                    consume(start - base);
+                    return fail(0, std::string());
+                }
+
+                handler(std::move(attr));
+                start = first.base();
+            }
+
+            consume(start - base);
+            return true;
+        }
+
+        void consume(std::size_t n)
+        {
+            buffer.erase(buffer.begin(), buffer.begin() + n);
+            consumed_ += n;
+        }
+
+        bool fail(std::size_t offset, std::string which)
+        {
+            consumed_ += offset;
+            which_ = std::move(which);
+            failed_ = true;
+            return false;
+        }
+
+        Parser p;
+        Skipper skipper;
+        Handler handler;
+        std::vector<char> buffer;
+        std::size_t consumed_;
+        bool failed_;
+        std::string which_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Attribute, typename Parser, typename Handler>
+    inline push_parser<
+        typename extension::as_parser<Parser>::value_type
+      , unused_type, Attribute, Handler>
+    make_push_parser(Parser const& p, Handler handler)
+    {
+        return { as_parser(p), unused, std::move(handler) };
+    }
+
+    template <typename Attribute, typename Parser, typename Skipper
+      , typename Handler>
+    inline push_parser<
+        typename extension::as_parser<Parser>::value_type
+      , typename extension::as_parser<Skipper>::value_type
+      , Attribute, Handler>
+    make_push_parser(Parser const& p, Skipper const& skipper, Handler handler)
+    {
+        return { as_parser(p), as_parser(skipper), std::move(handler) };
+    }
+}}}
+
+#endif
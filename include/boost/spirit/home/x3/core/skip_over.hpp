@@ -10,14 +10,28 @@
 #include <boost/spirit/home/x3/support/unused.hpp>
 #include <boost/spirit/home/x3/support/context.hpp>
 #include <boost/spirit/home/x3/support/traits/attribute_category.hpp>
+#include <boost/spirit/home/x3/char/char_class_tags.hpp>
+#include <boost/spirit/home/support/detail/skip_ascii_space.hpp>
 #include <boost/mpl/bool.hpp>
 #include <boost/mpl/not.hpp>
 #include <boost/type_traits/remove_cv.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/utility/declval.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <type_traits>
+
+namespace boost { namespace spirit { namespace char_encoding
+{
+    struct ascii;
+    struct iso8859_1;
+    struct standard;
+}}}
 
 namespace boost { namespace spirit { namespace x3
 {
+    template <typename Encoding, typename Tag>
+    struct char_class;
+
     ///////////////////////////////////////////////////////////////////////////
     // Move the /first/ iterator to the first non-matching position
     // given a skip-parser. The function is a no-op if unused_type or
@@ -66,6 +80,45 @@ namespace boost { namespace spirit { namespace x3
                 /***/;
         }
 
+        // The built-in space classifiers of the narrow char encodings
+        // agree on the ASCII white space characters. On contiguous char
+        // input, those are skipped by a vectorized scan and only non-ASCII
+        // characters are left to the skipper itself (e.g. the locale
+        // dependent standard::space or iso8859_1's no-break space).
+        template <typename Encoding>
+        struct is_narrow_space_encoding
+          : mpl::false_ {};
+
+        template <>
+        struct is_narrow_space_encoding<char_encoding::ascii>
+          : mpl::true_ {};
+
+        template <>
+        struct is_narrow_space_encoding<char_encoding::iso8859_1>
+          : mpl::true_ {};
+
+        template <>
+        struct is_narrow_space_encoding<char_encoding::standard>
+          : mpl::true_ {};
+
+        template <typename Char, typename Encoding>
+        inline typename enable_if_c<
+            is_narrow_space_encoding<Encoding>::value
+         && std::is_same<typename remove_cv<Char>::type, char>::value>::type
+        skip_over(
+            Char*& first, Char* const& last
+          , char_class<Encoding, space_tag> const& skipper)
+        {
+            for (;;)
+            {
+                first += spirit::detail::skip_ascii_space(first, last) - first;
+                if (first == last
+                 || static_cast<unsigned char>(*first) < 0x80
+                 || !skipper.parse(first, last, unused, unused, unused))
+                    break;
+            }
+        }
+
         template <typename Iterator>
         inline void skip_over(Iterator&, Iterator const&, unused_type)
         {
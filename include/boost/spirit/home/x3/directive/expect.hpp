@@ -13,7 +13,14 @@
 
 #include <boost/config.hpp> // for BOOST_SYMBOL_VISIBLE
 #include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/mpl/bool.hpp>
+#include <functional>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace boost { namespace spirit { namespace x3
 {
@@ -37,6 +44,251 @@ namespace boost { namespace spirit { namespace x3
         std::string which_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  Non-throwing expectations
+    //
+    //  When the context holds an expectation_failure_info under the
+    //  expectation_failure_tag, a failed expectation does not throw. The
+    //  first failure is recorded in the info and the parse fails:
+    //
+    //      x3::expectation_failure_info<iterator_type> failure;
+    //      bool r = x3::parse(first, last
+    //        , x3::with<x3::expectation_failure_tag>(failure)[p]);
+    //      if (failure.failed())
+    //          report(failure.where(), failure.which());
+    //
+    //  Once a failure is recorded, alternatives, repetitions, optionals and
+    //  predicates do not backtrack over it, so the parse fails just like it
+    //  would unwind with the exception. Rules and guards with an on_error
+    //  handler get an expectation_failure for the recorded failure and
+    //  their result is applied as usual; a handler returning rethrow leaves
+    //  the failure recorded.
+    //
+    //  which() describes the failed parser on demand. For that the info
+    //  keeps a copy of the parser in a small inline buffer, so recording a
+    //  failure does not allocate. Parsers that do not fit or may throw when
+    //  copied are described right away.
+    ///////////////////////////////////////////////////////////////////////////
+
+    // tag used to get the expectation failure info from the context
+    struct expectation_failure_tag;
+
+    template <typename Iterator>
+    class expectation_failure_info
+    {
+    public:
+
+        typedef Iterator iterator_type;
+
+        expectation_failure_info()
+          : where_(), failed_(false), ops(0) {}
+
+        expectation_failure_info(expectation_failure_info const& rhs)
+          : where_(rhs.where_), which_(rhs.which_), failed_(rhs.failed_), ops(0)
+        {
+            copy_subject(rhs);
+        }
+
+        expectation_failure_info& operator=(expectation_failure_info const& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                where_ = rhs.where_;
+                which_ = rhs.which_;
+                failed_ = rhs.failed_;
+                copy_subject(rhs);
+            }
+            return *this;
+        }
+
+        ~expectation_failure_info()
+        {
+            clear();
+        }
+
+        bool failed() const { return failed_; }
+
+        Iterator const& where() const { return where_; }
+
+        std::string which() const
+        {
+            return ops ? ops->what(&buffer) : which_;
+        }
+
+        template <typename Subject>
+        void set(Iterator const& where, Subject const& subject)
+        {
+            clear();
+            where_ = where;
+            failed_ = true;
+            store(subject, mpl::bool_<
+                sizeof(Subject) <= buffer_size
+             && alignof(Subject) <= alignof(buffer_type)
+             && std::is_nothrow_copy_constructible<Subject>::value>());
+        }
+
+        void clear()
+        {
+            if (ops)
+                ops->destroy(&buffer);
+            ops = 0;
+            which_.clear();
+            failed_ = false;
+        }
+
+    private:
+
+        static std::size_t const buffer_size = 64;
+        typedef typename std::aligned_storage<buffer_size>::type buffer_type;
+
+        struct subject_ops
+        {
+            void (*copy)(void const* from, void* to);
+            void (*destroy)(void* subject);
+            std::string (*what)(void const* subject);
+        };
+
+        template <typename Subject>
+        struct subject_ops_of
+        {
+            static void copy(void const* from, void* to)
+            {
+                new (to) Subject(*static_cast<Subject const*>(from));
+            }
+
+            static void destroy(void* subject)
+            {
+                static_cast<Subject*>(subject)->~Subject();
+            }
+
+            static std::string what_(void const* subject)
+            {
+                return what(*static_cast<Subject const*>(subject));
+            }
+
+            static subject_ops const ops;
+        };
+
+        template <typename Subject>
+        void store(Subject const& subject, mpl::true_)
+        {
+            new (&buffer) Subject(subject);
+            ops = &subject_ops_of<Subject>::ops;
+        }
+
+        template <typename Subject>
+        void store(Subject const& subject, mpl::false_)
+        {
+            which_ = what(subject);
+        }
+
+        void copy_subject(expectation_failure_info const& rhs)
+        {
+            if (rhs.ops)
+            {
+                rhs.ops->copy(&rhs.buffer, &buffer);
+                ops = rhs.ops;
+            }
+        }
+
+        Iterator where_;
+        std::string which_;
+        bool failed_;
+        subject_ops const* ops;
+        buffer_type buffer;
+    };
+
+    template <typename Iterator>
+    template <typename Subject>
+    typename expectation_failure_info<Iterator>::subject_ops const
+    expectation_failure_info<Iterator>::subject_ops_of<Subject>::ops =
+    {
+        &subject_ops_of<Subject>::copy
+      , &subject_ops_of<Subject>::destroy
+      , &subject_ops_of<Subject>::what_
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        T& unwrap_expectation_failure_info(T& info)
+        {
+            return info;
+        }
+
+        template <typename T>
+        T& unwrap_expectation_failure_info(std::reference_wrapper<T> info)
+        {
+            return info.get();
+        }
+
+        inline bool has_expectation_failure(unused_type)
+        {
+            return false;
+        }
+
+        template <typename Info>
+        bool has_expectation_failure(Info const& info)
+        {
+            return unwrap_expectation_failure_info(info).failed();
+        }
+
+        template <typename Iterator, typename Subject>
+        void set_expectation_failure(
+            Iterator const& where, Subject const& subject, unused_type)
+        {
+            boost::throw_exception(
+                expectation_failure<Iterator>(where, what(subject)));
+        }
+
+        template <typename Iterator, typename Subject, typename Info>
+        void set_expectation_failure(
+            Iterator const& where, Subject const& subject, Info& info)
+        {
+            auto& info_ = unwrap_expectation_failure_info(info);
+
+            // keep the first (innermost) failure, as the exception would
+            if (!info_.failed())
+                info_.set(where, subject);
+        }
+    }
+
+    // true if the context holds an expectation_failure_info
+    template <typename Context>
+    struct has_expectation_failure_info
+      : mpl::bool_<!is_same<
+            decltype(x3::get<expectation_failure_tag>(std::declval<Context const&>()))
+          , unused_type>::value>
+    {};
+
+    // true if the context holds an expectation_failure_info with a
+    // recorded failure (always false if there is none)
+    template <typename Context>
+    inline bool has_expectation_failure(Context const& context)
+    {
+        return detail::has_expectation_failure(
+            x3::get<expectation_failure_tag>(context));
+    }
+
+    // the expectation_failure_info of the context, if there is one
+    template <typename Context>
+    inline decltype(auto) get_expectation_failure_info(Context const& context)
+    {
+        return detail::unwrap_expectation_failure_info(
+            x3::get<expectation_failure_tag>(context));
+    }
+
+    // throws an expectation_failure, or records it if the context holds
+    // an expectation_failure_info
+    template <typename Iterator, typename Subject, typename Context>
+    inline void set_expectation_failure(
+        Iterator const& where, Subject const& subject, Context const& context)
+    {
+        decltype(auto) info = x3::get<expectation_failure_tag>(context);
+        detail::set_expectation_failure(where, subject, info);
+    }
+
     template <typename Subject>
     struct expect_directive : unary_parser<Subject, expect_directive<Subject>>
     {
@@ -54,11 +306,7 @@ namespace boost { namespace spirit { namespace x3
             bool r = this->subject.parse(first, last, context, rcontext, attr);
 
             if (!r)
-            {
-                boost::throw_exception(
-                    expectation_failure<Iterator>(
-                        first, what(this->subject)));
-            }
+                set_expectation_failure(first, this->subject, context);
             return r;
         }
     };
@@ -92,11 +340,7 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
                 parser.subject, first, last, context, rcontext, attr);
 
             if (!r)
-            {
-                boost::throw_exception(
-                    expectation_failure<Iterator>(
-                        first, what(parser.subject)));
-            }
+                set_expectation_failure(first, parser.subject, context);
             return r;
         }
     };
@@ -9,6 +9,7 @@
 #define BOOST_SPIRIT_HOME_X3_EXTENSIONS_MATCHES_HPP
 
 #include <boost/spirit/home/x3/core/parser.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
 #include <boost/spirit/home/x3/support/traits/move_to.hpp>
 #include <boost/spirit/home/x3/support/unused.hpp>
 
@@ -30,6 +31,9 @@ namespace boost { namespace spirit { namespace x3
         {
             bool const result = this->subject.parse(
                     first, last, context, rcontext, unused);
+            // an expectation failure is not a mismatch
+            if (!result && has_expectation_failure(context))
+                return false;
             traits::move_to(result, attr);
             return true;
         }
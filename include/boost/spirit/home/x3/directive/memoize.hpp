@@ -0,0 +1,365 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_MEMOIZE_OCT_18_2026_0300PM)
+#define BOOST_SPIRIT_X3_MEMOIZE_OCT_18_2026_0300PM
+
+#include <boost/spirit/home/x3/support/context.hpp>
+#include <boost/spirit/home/x3/support/unused.hpp>
+#include <boost/spirit/home/x3/support/traits/attribute_of.hpp>
+#include <boost/spirit/home/x3/support/traits/move_to.hpp>
+#include <boost/spirit/home/x3/core/parser.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace boost { namespace spirit { namespace x3
+{
+    template <typename ID, typename Attribute, bool force_attribute>
+    struct rule;
+
+    template <typename ID, typename RHS, typename Attribute, bool force_attribute>
+    struct rule_definition;
+
+    struct memo_table_tag;
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  The results of the memoize directives of one parse: whether the
+    //  subject matched, where it stopped and a copy of its attribute, by
+    //  start offset, memoized parser and context. The result of a parser
+    //  depends on its context (the skipper, no_case), so the entries of
+    //  one context are not replayed in another. Put it in the context with
+    //  with<memo_table_tag>(table)[p]. The table holds at most capacity
+    //  entries; when it is full, the entries with the lowest start offsets
+    //  are dropped first.
+    //
+    //  The entries are keyed by the offset of their start from the first
+    //  iterator, which is only O(1) to get for random access iterators.
+    //  With forward iterators each lookup would walk the input from the
+    //  start and the parse would no longer be linear, so they are rejected.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator>
+    class memo_table
+    {
+        static_assert(std::is_base_of<std::random_access_iterator_tag
+              , typename std::iterator_traits<Iterator>::iterator_category
+            >::value
+          , "memo_table requires random access iterators");
+
+    public:
+
+        typedef Iterator iterator_type;
+
+        struct entry
+        {
+            bool success;
+            Iterator end;
+            std::shared_ptr<void const> value;      // null if not synthesized
+            std::type_info const* type;
+        };
+
+        static std::size_t const unbounded = std::size_t(-1);
+
+        explicit memo_table(Iterator first, std::size_t capacity = unbounded)
+          : first_(first), capacity_(capacity), hits_(0), misses_(0) {}
+
+        memo_table(memo_table const&) = delete;
+        memo_table& operator=(memo_table const&) = delete;
+
+        std::size_t size() const { return entries.size(); }
+        std::size_t capacity() const { return capacity_; }
+        std::size_t hits() const { return hits_; }
+        std::size_t misses() const { return misses_; }
+
+        void clear()
+        {
+            entries.clear();
+        }
+
+        // Drops the entries that start before pos. A driver that knows the
+        // parse will not backtrack before pos (e.g. at the start of the next
+        // top level item) can keep the table small this way.
+        void evict_before(Iterator pos)
+        {
+            entries.erase(entries.begin()
+              , entries.lower_bound(
+                    key_type(offset_of(pos), nullptr, nullptr)));
+        }
+
+        entry const* find(void const* id, void const* context
+          , Iterator where)
+        {
+            auto i = entries.find(key_type(offset_of(where), id, context));
+            if (i == entries.end())
+            {
+                ++misses_;
+                return nullptr;
+            }
+            ++hits_;
+            return &i->second;
+        }
+
+        void insert(void const* id, void const* context
+          , Iterator where, entry e)
+        {
+            if (capacity_ == 0)
+                return;
+            key_type const key(offset_of(where), id, context);
+            auto i = entries.find(key);
+            if (i != entries.end())
+            {
+                i->second = std::move(e);
+                return;
+            }
+            if (entries.size() >= capacity_)
+                entries.erase(entries.begin());
+            entries.emplace(key, std::move(e));
+        }
+
+    private:
+
+        typedef std::tuple<std::size_t, void const*, void const*> key_type;
+
+        std::size_t offset_of(Iterator pos) const
+        {
+            return std::distance(first_, pos);
+        }
+
+        Iterator first_;
+        std::size_t capacity_;
+        std::size_t hits_;
+        std::size_t misses_;
+        std::map<key_type, entry, std::less<key_type>> entries;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        T& unwrap_memo_table(T& table)
+        {
+            return table;
+        }
+
+        template <typename T>
+        T& unwrap_memo_table(std::reference_wrapper<T> table)
+        {
+            return table.get();
+        }
+
+        template <typename ID>
+        struct memo_rule_id
+        {
+            static char const id;
+        };
+
+        template <typename ID>
+        char const memo_rule_id<ID>::id = 0;
+
+        // identifies the type of the context a memoized parser runs in
+        template <typename Context>
+        struct memo_context_id
+        {
+            static char const id;
+        };
+
+        template <typename Context>
+        char const memo_context_id<Context>::id = 0;
+
+        // Copies of a memoize directive share its entries. A rule is the
+        // same wherever it is referenced, so all memoize directives of a
+        // rule share them.
+        template <typename Subject>
+        std::shared_ptr<void const> make_memo_id(Subject const&)
+        {
+            return std::make_shared<char const>(0);
+        }
+
+        template <typename ID, typename Attribute, bool force_attribute>
+        std::shared_ptr<void const> make_memo_id(
+            rule<ID, Attribute, force_attribute> const&)
+        {
+            return std::shared_ptr<void const>(
+                std::shared_ptr<void const>(), &memo_rule_id<ID>::id);
+        }
+
+        template <typename ID, typename RHS, typename Attribute
+          , bool force_attribute>
+        std::shared_ptr<void const> make_memo_id(
+            rule_definition<ID, RHS, Attribute, force_attribute> const&)
+        {
+            return std::shared_ptr<void const>(
+                std::shared_ptr<void const>(), &memo_rule_id<ID>::id);
+        }
+    }
+
+    // true if the context holds a memo_table
+    template <typename Context>
+    struct has_memo_table
+      : mpl::bool_<!is_same<
+            decltype(x3::get<memo_table_tag>(std::declval<Context const&>()))
+          , unused_type>::value>
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  memoize[p] parses p at most once per start position, replaying the
+    //  recorded result when it is re-entered there (packrat parsing). This
+    //  keeps grammars that backtrack into the same rule from many branches
+    //  linear. Semantic actions of p do not run again when a result is
+    //  replayed. Without a memo_table in the context p is simply parsed.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Subject>
+    struct memoize_directive : unary_parser<Subject, memoize_directive<Subject>>
+    {
+        typedef unary_parser<Subject, memoize_directive<Subject> > base_type;
+        static bool const is_pass_through_unary = true;
+        static bool const handles_container = Subject::handles_container;
+
+        typedef Subject subject_type;
+
+        memoize_directive(Subject const& subject)
+          : base_type(subject)
+          , id(detail::make_memo_id(subject)) {}
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse(Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr) const
+        {
+            return parse_main(first, last, context, rcontext, attr
+              , has_memo_table<Context>());
+        }
+
+    private:
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse_main(Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr
+          , mpl::false_) const
+        {
+            return this->subject.parse(first, last, context, rcontext, attr);
+        }
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse_main(Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr
+          , mpl::true_) const
+        {
+            auto& table = detail::unwrap_memo_table(
+                x3::get<memo_table_tag>(context));
+
+            typedef typename
+                traits::attribute_of<memoize_directive, Context>::type
+            value_type;
+            // the attribute is synthesized even if the caller does not
+            // want it, so that the entry can serve every caller
+            typedef is_same<value_type, unused_type> is_unused;
+
+            void const* const context_id = &detail::memo_context_id<Context>::id;
+            Iterator const start = first;
+            if (auto const* e = table.find(id.get(), context_id, start))
+            {
+                if (replay<value_type>(*e, first, attr, is_unused()))
+                    return e->success;
+            }
+
+            typename memo_table<Iterator>::entry e =
+                { false, start, nullptr, &typeid(value_type) };
+            e.success = parse_subject(first, last, context, rcontext, attr
+              , e.value, is_unused());
+
+            // a recorded expectation failure is not replayed, so a failing
+            // parse that recorded one is not memoized
+            if (!e.success && x3::has_expectation_failure(context))
+                return false;
+
+            bool const success = e.success;
+            e.end = first;
+            table.insert(id.get(), context_id, start, std::move(e));
+            return success;
+        }
+
+        // a failure, or a success with no attribute to restore
+        template <typename ValueType, typename Entry, typename Iterator
+          , typename Attribute>
+        static bool replay(Entry const& e, Iterator& first, Attribute&
+          , mpl::true_)
+        {
+            first = e.end;
+            return true;
+        }
+
+        // false if the entry has no attribute of the right type
+        template <typename ValueType, typename Entry, typename Iterator
+          , typename Attribute>
+        static bool replay(Entry const& e, Iterator& first, Attribute& attr
+          , mpl::false_)
+        {
+            if (!e.success)
+                return replay<ValueType>(e, first, attr, mpl::true_());
+            if (!e.value || *e.type != typeid(ValueType))
+                return false;
+
+            ValueType val = *static_cast<ValueType const*>(e.value.get());
+            traits::move_to(std::move(val), attr);
+            first = e.end;
+            return true;
+        }
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse_subject(Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute&
+          , std::shared_ptr<void const>&, mpl::true_) const
+        {
+            return this->subject.parse(first, last, context, rcontext, unused);
+        }
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse_subject(Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr
+          , std::shared_ptr<void const>& value, mpl::false_) const
+        {
+            typedef typename
+                traits::attribute_of<memoize_directive, Context>::type
+            value_type;
+
+            value_type val;
+            if (!this->subject.parse(first, last, context, rcontext, val))
+                return false;
+            value = std::make_shared<value_type const>(val);
+            traits::move_to(std::move(val), attr);
+            return true;
+        }
+
+        std::shared_ptr<void const> id;
+    };
+
+    struct memoize_gen
+    {
+        template <typename Subject>
+        memoize_directive<typename extension::as_parser<Subject>::value_type>
+        operator[](Subject const& subject) const
+        {
+            return { as_parser(subject) };
+        }
+    };
+
+    auto const memoize = memoize_gen{};
+}}}
+
+#endif
@@ -15,6 +15,12 @@
 #include <boost/spirit/home/x3/support/utility/sfinae.hpp>
 #include <boost/spirit/home/x3/nonterminal/detail/transform_attribute.hpp>
 #include <boost/utility/addressof.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 
 #if defined(BOOST_SPIRIT_X3_DEBUG)
 #include <boost/spirit/home/x3/nonterminal/simple_trace.hpp>
@@ -29,6 +35,7 @@ namespace boost { namespace spirit { namespace x3
     struct rule;
 
     struct parse_pass_context_tag;
+    struct rule_profiler_tag;
 
     namespace detail
     {
@@ -88,6 +95,72 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
     };
 #endif
 
+    inline std::size_t next_profile_rule_index()
+    {
+        static std::atomic<std::size_t> next(0);
+        return next++;
+    }
+
+    // a small integer for each rule, indexing the rule_profiler statistics
+    template <typename ID>
+    std::size_t profile_rule_index()
+    {
+        static std::size_t const index = next_profile_rule_index();
+        return index;
+    }
+
+    // reports a rule invocation to the rule_profiler in the context (see
+    // x3/nonterminal/rule_profiler.hpp), if there is one
+    template <typename ID, typename Iterator, typename Profiler>
+    struct context_profile
+    {
+        context_profile(
+            Profiler& profiler
+          , char const* rule_name
+          , Iterator const& first
+          , bool const& ok_parse
+          )
+          : profiler(profiler), first(first), start(first)
+          , ok_parse(ok_parse)
+        {
+            profiler.enter(profile_rule_index<ID>(), rule_name);
+        }
+
+        ~context_profile()
+        {
+            profiler.leave(ok_parse
+              , ok_parse ? std::size_t(std::distance(start, first)) : 0);
+        }
+
+        Profiler& profiler;
+        Iterator const& first;
+        Iterator const start;
+        bool const& ok_parse;
+    };
+
+    template <typename ID, typename Iterator, typename Profiler>
+    struct context_profile<ID, Iterator, std::reference_wrapper<Profiler>>
+      : context_profile<ID, Iterator, Profiler>
+    {
+        context_profile(
+            std::reference_wrapper<Profiler> profiler
+          , char const* rule_name
+          , Iterator const& first
+          , bool const& ok_parse
+          )
+          : context_profile<ID, Iterator, Profiler>(
+                profiler.get(), rule_name, first, ok_parse)
+        {}
+    };
+
+    template <typename ID, typename Iterator>
+    struct context_profile<ID, Iterator, unused_type>
+    {
+        context_profile(
+            unused_type, char const*, Iterator const&, bool const&)
+        {}
+    };
+
     template <typename ID, typename Iterator, typename Context, typename Enable = void>
     struct has_on_error : mpl::false_ {};
 
@@ -226,11 +299,11 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
 
         template <typename RHS, typename Iterator, typename Context
           , typename RContext, typename ActualAttribute>
-        static bool parse_rhs_main(
+        static bool parse_rhs_main_on_error(
             RHS const& rhs
           , Iterator& first, Iterator const& last
           , Context const& context, RContext& rcontext, ActualAttribute& attr
-          , mpl::true_ /* on_error is found */)
+          , mpl::false_ /* expectation failures are thrown */)
         {
             for (;;)
             {
@@ -256,6 +329,58 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
             }
         }
 
+        template <typename RHS, typename Iterator, typename Context
+          , typename RContext, typename ActualAttribute>
+        static bool parse_rhs_main_on_error(
+            RHS const& rhs
+          , Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, ActualAttribute& attr
+          , mpl::true_ /* expectation failures are recorded */)
+        {
+            auto& failure = get_expectation_failure_info(context);
+            for (;;)
+            {
+                if (parse_rhs_main(
+                        rhs, first, last, context, rcontext, attr, mpl::false_()))
+                {
+                    return true;
+                }
+
+                if (!failure.failed())
+                    return false;
+
+                expectation_failure<Iterator> const x(
+                    failure.where(), failure.which());
+                switch (ID().on_error(first, last, x, context))
+                {
+                    case error_handler_result::fail:
+                        failure.clear();
+                        return false;
+                    case error_handler_result::retry:
+                        failure.clear();
+                        continue;
+                    case error_handler_result::accept:
+                        failure.clear();
+                        return true;
+                    case error_handler_result::rethrow:
+                        return false;
+                }
+            }
+        }
+
+        template <typename RHS, typename Iterator, typename Context
+          , typename RContext, typename ActualAttribute>
+        static bool parse_rhs_main(
+            RHS const& rhs
+          , Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, ActualAttribute& attr
+          , mpl::true_ /* on_error is found */)
+        {
+            return parse_rhs_main_on_error(
+                rhs, first, last, context, rcontext, attr
+              , has_expectation_failure_info<Context>());
+        }
+
         template <typename RHS, typename Iterator
           , typename Context, typename RContext, typename ActualAttribute>
         static bool parse_rhs_main(
@@ -311,7 +436,7 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
             typedef typename transform::type transform_attr;
             transform_attr attr_ = transform::pre(attr);
 
-            bool ok_parse
+            bool ok_parse = false
               //Creates a place to hold the result of parse_rhs
               //called inside the following scope.
               ;
@@ -326,6 +451,15 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
                 context_debug<Iterator, transform_attr>
                 dbg(rule_name, first, last, attr_, ok_parse);
 #endif
+                typedef typename remove_const<
+                    typename remove_reference<
+                        decltype(x3::get<rule_profiler_tag>(context))>::type
+                    >::type
+                profiler_type;
+                context_profile<ID, Iterator, profiler_type>
+                profile(x3::get<rule_profiler_tag>(context)
+                  , rule_name, first, ok_parse);
+
                 ok_parse = parse_rhs(rhs, first, last, context, attr_, attr_
                    , mpl::bool_
                      < (  RHS::has_action
@@ -0,0 +1,272 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_RULE_PROFILER_OCT_18_2026_0900PM)
+#define BOOST_SPIRIT_X3_RULE_PROFILER_OCT_18_2026_0900PM
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/io/ios_state.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(BOOST_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace boost { namespace spirit { namespace x3
+{
+    struct rule_profiler_tag;
+
+    namespace detail
+    {
+        // a cheap, monotonic tick count: the time stamp counter where there
+        // is one, nanoseconds otherwise
+        inline boost::uint64_t profile_ticks()
+        {
+#if defined(BOOST_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            return __builtin_ia32_rdtsc();
+#else
+            return static_cast<boost::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  rule_profiler collects statistics for every rule it sees. Put it in
+    //  the context with with<rule_profiler_tag>(profiler)[p]. Rules parsed
+    //  without one in their context pay nothing.
+    //
+    //  Times are in ticks of detail::profile_ticks. The inclusive time of a
+    //  recursive rule is counted for the outermost invocation only. The
+    //  backtracked bytes of a rule are the bytes consumed by its sub-rules
+    //  that it did not keep, either because it failed or because it
+    //  backtracked past them. This is a lower bound: input consumed by
+    //  primitives outside of any rule is not seen.
+    //
+    //  A profiler is not synchronized, use one per thread.
+    ///////////////////////////////////////////////////////////////////////////
+    class rule_profiler
+    {
+    public:
+
+        struct rule_stats
+        {
+            char const* name = "";
+            boost::uint64_t calls = 0;
+            boost::uint64_t successes = 0;
+            boost::uint64_t failures = 0;
+            boost::uint64_t consumed = 0;       // bytes, successes only
+            boost::uint64_t backtracked = 0;    // bytes
+            boost::uint64_t inclusive = 0;      // ticks
+            boost::uint64_t exclusive = 0;      // ticks
+        };
+
+        rule_profiler()
+          : nodes(1)
+        {}
+
+        // called by the rules, rule is a small integer identifying it
+        void enter(std::size_t rule, char const* name)
+        {
+            if (rule >= rules.size())
+            {
+                rules.resize(rule + 1);
+                active.resize(rule + 1);
+            }
+            rules[rule].name = name;
+            ++rules[rule].calls;
+            ++active[rule];
+
+            frame f;
+            f.rule = rule;
+            f.node = child_node(frames.empty() ? 0 : frames.back().node, rule);
+            f.children_ticks = 0;
+            f.children_consumed = 0;
+            frames.push_back(f);
+            frames.back().start = detail::profile_ticks();
+        }
+
+        void leave(bool ok, std::size_t consumed)
+        {
+            boost::uint64_t const stop = detail::profile_ticks();
+            frame const f = frames.back();
+            frames.pop_back();
+
+            boost::uint64_t const ticks = stop - f.start;
+            boost::uint64_t const self =
+                ticks - (std::min)(f.children_ticks, ticks);
+
+            rule_stats& s = rules[f.rule];
+            if (ok)
+            {
+                ++s.successes;
+                s.consumed += consumed;
+                if (f.children_consumed > consumed)
+                    s.backtracked += f.children_consumed - consumed;
+            }
+            else
+            {
+                ++s.failures;
+                s.backtracked += f.children_consumed;
+            }
+            s.exclusive += self;
+            if (--active[f.rule] == 0)
+                s.inclusive += ticks;
+            nodes[f.node].ticks += self;
+
+            if (!frames.empty())
+            {
+                frames.back().children_ticks += ticks;
+                if (ok)
+                    frames.back().children_consumed += consumed;
+            }
+        }
+
+        // the rules seen, the most expensive (by exclusive time) first
+        std::vector<rule_stats> stats() const
+        {
+            std::vector<rule_stats> result;
+            for (rule_stats const& s : rules)
+            {
+                if (s.calls != 0)
+                    result.push_back(s);
+            }
+            std::stable_sort(result.begin(), result.end()
+              , [](rule_stats const& a, rule_stats const& b)
+                {
+                    return a.exclusive > b.exclusive;
+                });
+            return result;
+        }
+
+        // writes the statistics as a table, out keeps its formatting
+        void report(std::ostream& out) const
+        {
+            boost::io::ios_flags_saver const flags(out);
+            boost::io::ios_precision_saver const precision(out);
+
+            std::vector<rule_stats> const all = stats();
+            boost::uint64_t total = 0;
+            std::size_t width = 4;
+            for (rule_stats const& s : all)
+            {
+                total += s.exclusive;
+                width = (std::max)(width, std::string(s.name).size());
+            }
+
+            out << std::left << std::setw(int(width)) << "rule" << std::right
+                << std::setw(12) << "calls"
+                << std::setw(12) << "successes"
+                << std::setw(12) << "failures"
+                << std::setw(14) << "consumed"
+                << std::setw(14) << "backtracked"
+                << std::setw(16) << "inclusive"
+                << std::setw(16) << "exclusive"
+                << std::setw(8) << "%" << '\n';
+            for (rule_stats const& s : all)
+            {
+                double const percent =
+                    total ? 100.0 * double(s.exclusive) / double(total) : 0.0;
+                out << std::left << std::setw(int(width)) << s.name
+                    << std::right
+                    << std::setw(12) << s.calls
+                    << std::setw(12) << s.successes
+                    << std::setw(12) << s.failures
+                    << std::setw(14) << s.consumed
+                    << std::setw(14) << s.backtracked
+                    << std::setw(16) << s.inclusive
+                    << std::setw(16) << s.exclusive
+                    << std::setw(8) << std::fixed << std::setprecision(1)
+                    << percent << '\n';
+            }
+        }
+
+        // writes the exclusive time of every call path as "a;b;c ticks"
+        // lines, the folded stack format read by flame graph tools
+        void folded_stacks(std::ostream& out) const
+        {
+            std::vector<std::size_t> path;
+            for (std::size_t i = 1; i < nodes.size(); ++i)
+            {
+                if (nodes[i].ticks == 0)
+                    continue;
+                path.clear();
+                for (std::size_t n = i; n != 0; n = nodes[n].parent)
+                    path.push_back(nodes[n].rule);
+                for (std::size_t j = path.size(); j-- != 0; )
+                {
+                    out << rules[path[j]].name;
+                    if (j != 0)
+                        out << ';';
+                }
+                out << ' ' << nodes[i].ticks << '\n';
+            }
+        }
+
+        void clear()
+        {
+            rules.clear();
+            active.clear();
+            frames.clear();
+            nodes.resize(1);
+            nodes[0].children.clear();
+        }
+
+    private:
+
+        struct frame
+        {
+            std::size_t rule;
+            std::size_t node;
+            boost::uint64_t start;
+            boost::uint64_t children_ticks;
+            boost::uint64_t children_consumed;
+        };
+
+        // a call path, the root (node 0) stands for the caller of the
+        // outermost rule
+        struct node
+        {
+            std::size_t rule = 0;
+            std::size_t parent = 0;
+            boost::uint64_t ticks = 0;
+            std::vector<std::size_t> children;
+        };
+
+        std::size_t child_node(std::size_t parent, std::size_t rule)
+        {
+            for (std::size_t c : nodes[parent].children)
+            {
+                if (nodes[c].rule == rule)
+                    return c;
+            }
+            std::size_t const c = nodes.size();
+            nodes.emplace_back();
+            nodes[c].rule = rule;
+            nodes[c].parent = parent;
+            nodes[parent].children.push_back(c);
+            return c;
+        }
+
+        std::vector<rule_stats> rules;      // by rule index
+        std::vector<std::size_t> active;    // nesting depth, by rule index
+        std::vector<frame> frames;
+        std::vector<node> nodes;
+    };
+}}}
+
+#endif
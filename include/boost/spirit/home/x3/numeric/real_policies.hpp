@@ -164,6 +164,25 @@ namespace boost { namespace spirit { namespace x3
     {
         static bool const expect_dot = true;
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Fast, correctly rounded real number policies. For float and double,
+    //  the digits are collected in a 64-bit integer and converted with the
+    //  Eisel-Lemire algorithm, falling back to the default algorithm only
+    //  for rare hard cases. parse_n and parse_frac_n are not used by this
+    //  path: don't derive from these if you customize the digit syntax.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct fast_ureal_policies : ureal_policies<T>
+    {
+        static bool const fast_path = true;
+    };
+
+    template <typename T>
+    struct fast_real_policies : real_policies<T>
+    {
+        static bool const fast_path = true;
+    };
 }}}
 
 #endif
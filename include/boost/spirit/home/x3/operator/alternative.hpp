@@ -10,6 +10,8 @@
 #include <boost/spirit/home/x3/support/traits/attribute_of.hpp>
 #include <boost/spirit/home/x3/core/parser.hpp>
 #include <boost/spirit/home/x3/operator/detail/alternative.hpp>
+#include <boost/spirit/home/x3/operator/detail/alternative_dispatch.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
 
 namespace boost { namespace spirit { namespace x3
 {
@@ -26,8 +28,8 @@ namespace boost { namespace spirit { namespace x3
             Iterator& first, Iterator const& last
           , Context const& context, RContext& rcontext, unused_type) const
         {
-            return this->left.parse(first, last, context, rcontext, unused)
-               || this->right.parse(first, last, context, rcontext, unused);
+            return parse(first, last, context, rcontext, unused
+              , detail::use_alternative_dispatch<alternative, Iterator, Context>());
         }
 
         template <typename Iterator, typename Context
@@ -35,9 +37,56 @@ namespace boost { namespace spirit { namespace x3
         bool parse(
             Iterator& first, Iterator const& last
           , Context const& context, RContext& rcontext, Attribute& attr) const
+        {
+            return parse(first, last, context, rcontext, attr
+              , detail::use_alternative_dispatch<alternative, Iterator, Context>());
+        }
+
+        template <typename Iterator, typename Context, typename RContext>
+        bool parse(
+            Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, unused_type
+          , mpl::false_) const
+        {
+            return this->left.parse(first, last, context, rcontext, unused)
+               || (!has_expectation_failure(context)
+                && this->right.parse(first, last, context, rcontext, unused));
+        }
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse(
+            Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr
+          , mpl::false_) const
         {
             return detail::parse_alternative(this->left, first, last, context, rcontext, attr)
-               || detail::parse_alternative(this->right, first, last, context, rcontext, attr);
+               || (!has_expectation_failure(context)
+                && detail::parse_alternative(this->right, first, last, context, rcontext, attr));
+        }
+
+        // Only the branches that can start with the next character are
+        // tried (see detail/alternative_dispatch.hpp)
+        template <typename Iterator, typename Context, typename RContext>
+        bool parse(
+            Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, unused_type
+          , mpl::true_) const
+        {
+            unused_type attr;
+            return detail::dispatch_alternative(
+                *this, first, last, context, rcontext, attr);
+        }
+
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse(
+            Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr
+          , mpl::true_) const
+        {
+            return detail::dispatch_alternative(
+                *this, first, last, context, rcontext, attr);
         }
     };
 
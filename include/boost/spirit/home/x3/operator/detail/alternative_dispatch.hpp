@@ -0,0 +1,313 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_ALTERNATIVE_DISPATCH_OCT_18_2026_1200PM)
+#define BOOST_SPIRIT_X3_ALTERNATIVE_DISPATCH_OCT_18_2026_1200PM
+
+#include <boost/spirit/home/x3/char/char_parser.hpp>
+#include <boost/spirit/home/x3/core/skip_over.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
+#include <boost/spirit/home/x3/operator/detail/alternative.hpp>
+#include <boost/spirit/home/x3/support/no_case.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/int.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <string>
+#include <type_traits>
+
+namespace boost { namespace spirit { namespace x3
+{
+    template <typename String, typename Encoding, typename Attribute>
+    struct literal_string;
+
+    template <typename Left, typename Right>
+    struct sequence;
+
+    template <typename Subject, typename Action>
+    struct action;
+}}}
+
+namespace boost { namespace spirit { namespace x3 { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  FIRST-set dispatch for alternatives
+    //
+    //  Many branches of an alternative can only match if the next input
+    //  character (after skipping) is in a set known from the branch's type:
+    //  char parsers, non-empty literal strings, and sequences and semantic
+    //  actions starting with one of them. For such an alternative on char
+    //  input, the next character is looked up once and only the branches
+    //  whose FIRST set holds it are tried.
+    //
+    //  A branch that is passed over must leave the input as it would after
+    //  failing: char parsers and literal strings skip before they fail, so
+    //  the skip is applied; sequences and actions restore the input. A
+    //  branch that is tried starts after the skip, so that the skipper does
+    //  not run twice over the same input (its semantic actions neither).
+    ///////////////////////////////////////////////////////////////////////////
+
+    // The FIRST set of a parser, unknown by default
+    template <typename Parser, typename Context, typename Enable = void>
+    struct alternative_first
+    {
+        static bool const is_known = false;
+    };
+
+    template <typename Parser, typename Context>
+    struct alternative_first<Parser, Context
+      , typename enable_if<is_base_of<char_parser<Parser>, Parser>>::type>
+    {
+        static bool const is_known = true;
+        static bool const skips_on_failure = true;
+
+        template <typename Iterator>
+        static bool may_match(Parser const& p
+          , Iterator i, Iterator const& last, Context const& context)
+        {
+            return i != last && p.test(*i, context);
+        }
+    };
+
+    template <typename String, typename Encoding, typename Attribute
+      , typename Context>
+    struct alternative_first<
+        literal_string<String, Encoding, Attribute>, Context>
+    {
+        static bool const is_known = true;
+        static bool const skips_on_failure = true;
+
+        template <typename Char>
+        static Char const* first_char(Char const* str)
+        {
+            return *str ? str : 0;
+        }
+
+        template <typename Char, typename Traits, typename Allocator>
+        static Char const* first_char(
+            std::basic_string<Char, Traits, Allocator> const& str)
+        {
+            return str.empty() ? 0 : str.data();
+        }
+
+        template <typename Iterator>
+        static bool may_match(
+            literal_string<String, Encoding, Attribute> const& p
+          , Iterator i, Iterator const& last, Context const& context)
+        {
+            auto const* ch = first_char(p.str);
+            if (!ch)
+                return true;    // the empty string always matches
+            return i != last && get_case_compare<Encoding>(context)(*ch, *i) == 0;
+        }
+    };
+
+    template <typename Left, typename Right, typename Context>
+    struct alternative_first<sequence<Left, Right>, Context
+      , typename enable_if_c<alternative_first<Left, Context>::is_known>::type>
+    {
+        static bool const is_known = true;
+        static bool const skips_on_failure = false;
+
+        template <typename Iterator>
+        static bool may_match(sequence<Left, Right> const& p
+          , Iterator i, Iterator const& last, Context const& context)
+        {
+            return alternative_first<Left, Context>::may_match(
+                p.left, i, last, context);
+        }
+    };
+
+    template <typename Subject, typename Action, typename Context>
+    struct alternative_first<action<Subject, Action>, Context
+      , typename enable_if_c<alternative_first<Subject, Context>::is_known>::type>
+    {
+        static bool const is_known = true;
+        static bool const skips_on_failure =
+            alternative_first<Subject, Context>::skips_on_failure;
+
+        template <typename Iterator>
+        static bool may_match(action<Subject, Action> const& p
+          , Iterator i, Iterator const& last, Context const& context)
+        {
+            return alternative_first<Subject, Context>::may_match(
+                p.subject, i, last, context);
+        }
+    };
+
+    // The number of branches with a known FIRST set
+    template <typename Parser, typename Context>
+    struct alternative_known_first
+      : mpl::int_<alternative_first<Parser, Context>::is_known> {};
+
+    template <typename Left, typename Right, typename Context>
+    struct alternative_known_first<alternative<Left, Right>, Context>
+      : mpl::int_<
+            alternative_known_first<Left, Context>::value
+          + alternative_known_first<Right, Context>::value> {};
+
+    template <typename Iterator>
+    struct is_alternative_dispatch_iterator
+      : mpl::bool_<
+            std::is_same<Iterator, char const*>::value
+         || std::is_same<Iterator, char*>::value
+         || std::is_same<Iterator, std::string::const_iterator>::value
+         || std::is_same<Iterator, std::string::iterator>::value>
+    {};
+
+    // Dispatch pays off once two branches can be passed over
+    template <typename Alternative, typename Iterator, typename Context>
+    struct use_alternative_dispatch
+      : mpl::bool_<
+            is_alternative_dispatch_iterator<Iterator>::value
+         && (alternative_known_first<Alternative, Context>::value >= 2)>
+    {};
+
+    // The next character after skipping, looked up again only when the
+    // input moved
+    template <typename Iterator>
+    struct alternative_lookahead
+    {
+        Iterator from;
+        Iterator at;
+    };
+
+    template <typename Parser, typename Iterator, typename Context
+      , typename RContext, typename Attribute>
+    bool call_alternative_branch(Parser const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr)
+    {
+        return parse_alternative(p, first, last, context, rcontext, attr);
+    }
+
+    template <typename Parser, typename Iterator, typename Context
+      , typename RContext>
+    bool call_alternative_branch(Parser const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, unused_type)
+    {
+        return p.parse(first, last, context, rcontext, unused);
+    }
+
+    template <typename Parser, typename Iterator, typename Context
+      , typename RContext, typename Attribute>
+    bool dispatch_alternative_branch(Parser const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr
+      , alternative_lookahead<Iterator>& /* lookahead */, mpl::false_)
+    {
+        return call_alternative_branch(p, first, last, context, rcontext, attr);
+    }
+
+    template <typename Parser, typename Iterator, typename Context
+      , typename RContext, typename Attribute>
+    bool dispatch_alternative_branch(Parser const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr
+      , alternative_lookahead<Iterator>& lookahead, mpl::true_)
+    {
+        typedef alternative_first<Parser, Context> first_set;
+
+        if (first != lookahead.from)
+        {
+            lookahead.from = first;
+            lookahead.at = first;
+            x3::skip_over(lookahead.at, last, context);
+        }
+
+        if (first_set::may_match(p, lookahead.at, last, context))
+        {
+            Iterator const save = first;
+            first = lookahead.at;
+            if (call_alternative_branch(p, first, last, context, rcontext, attr))
+                return true;
+            if (!first_set::skips_on_failure)
+                first = save;
+        }
+
+        if (first_set::skips_on_failure)
+            lookahead.from = first = lookahead.at;
+        return false;
+    }
+
+    template <typename Parser, typename Iterator, typename Context
+      , typename RContext, typename Attribute>
+    bool dispatch_alternative_branch(Parser const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr
+      , alternative_lookahead<Iterator>& lookahead)
+    {
+        return dispatch_alternative_branch(
+            p, first, last, context, rcontext, attr, lookahead
+          , mpl::bool_<alternative_first<Parser, Context>::is_known>());
+    }
+
+    template <typename Left, typename Right, typename Iterator
+      , typename Context, typename RContext, typename Attribute>
+    bool dispatch_alternative(alternative<Left, Right> const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr
+      , alternative_lookahead<Iterator>& lookahead);
+
+    // A nested alternative gets its attribute as parse_alternative would
+    // pass it
+    template <typename Left, typename Right, typename Iterator
+      , typename Context, typename RContext, typename Attribute>
+    bool dispatch_alternative_branch(alternative<Left, Right> const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr
+      , alternative_lookahead<Iterator>& lookahead)
+    {
+        typedef pass_variant_attribute<
+            alternative<Left, Right>, Attribute, Context> pass;
+
+        typename pass::type attr_ = pass::call(attr);
+        return dispatch_alternative(
+            p, first, last, context, rcontext, attr_, lookahead);
+    }
+
+    template <typename Left, typename Right, typename Iterator
+      , typename Context, typename RContext>
+    bool dispatch_alternative_branch(alternative<Left, Right> const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, unused_type
+      , alternative_lookahead<Iterator>& lookahead)
+    {
+        unused_type attr_;
+        return dispatch_alternative(
+            p, first, last, context, rcontext, attr_, lookahead);
+    }
+
+    template <typename Left, typename Right, typename Iterator
+      , typename Context, typename RContext, typename Attribute>
+    bool dispatch_alternative(alternative<Left, Right> const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr
+      , alternative_lookahead<Iterator>& lookahead)
+    {
+        return dispatch_alternative_branch(
+                p.left, first, last, context, rcontext, attr, lookahead)
+           || (!x3::has_expectation_failure(context)
+            && dispatch_alternative_branch(
+                p.right, first, last, context, rcontext, attr, lookahead));
+    }
+
+    template <typename Left, typename Right, typename Iterator
+      , typename Context, typename RContext, typename Attribute>
+    bool dispatch_alternative(alternative<Left, Right> const& p
+      , Iterator& first, Iterator const& last
+      , Context const& context, RContext& rcontext, Attribute& attr)
+    {
+        // at the end of the input there is nothing to skip, anywhere else
+        // the first branch with a known FIRST set looks the next character up
+        alternative_lookahead<Iterator> lookahead = { last, last };
+        return dispatch_alternative(
+            p, first, last, context, rcontext, attr, lookahead);
+    }
+}}}}
+
+#endif
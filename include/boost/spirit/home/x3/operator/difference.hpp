@@ -10,6 +10,7 @@
 #include <boost/spirit/home/x3/support/traits/attribute_of.hpp>
 #include <boost/spirit/home/x3/support/traits/has_attribute.hpp>
 #include <boost/spirit/home/x3/core/parser.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
 
 namespace boost { namespace spirit { namespace x3
 {
@@ -35,6 +36,8 @@ namespace boost { namespace spirit { namespace x3
                 first = start;
                 return false;
             }
+            if (has_expectation_failure(context))
+                return false;
             // Right fails, now try Left
             return this->left.parse(first, last, context, rcontext, attr);
         }
@@ -14,6 +14,7 @@
 #include <boost/spirit/home/x3/support/traits/move_to.hpp>
 #include <boost/spirit/home/x3/support/traits/optional_traits.hpp>
 #include <boost/spirit/home/x3/support/traits/attribute_category.hpp>
+#include <boost/spirit/home/x3/directive/expect.hpp>
 
 namespace boost { namespace spirit { namespace x3
 {
@@ -28,6 +29,16 @@ namespace boost { namespace spirit { namespace x3
 
         using base_type::parse_subject;
 
+        template <typename Iterator, typename Context
+          , typename RContext, typename Attribute>
+        bool parse(Iterator& first, Iterator const& last
+          , Context const& context, RContext& rcontext, Attribute& attr) const
+        {
+            // do not accept the empty match after an expectation failure
+            return base_type::parse(first, last, context, rcontext, attr)
+                && !has_expectation_failure(context);
+        }
+
         // Attribute is a container
         template <typename Iterator, typename Context
           , typename RContext, typename Attribute>
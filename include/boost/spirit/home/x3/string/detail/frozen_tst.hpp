@@ -0,0 +1,211 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_FROZEN_TST_OCTOBER_17_2026_1000AM)
+#define BOOST_SPIRIT_X3_FROZEN_TST_OCTOBER_17_2026_1000AM
+
+#include <boost/spirit/home/x3/string/detail/tst.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/assert.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost { namespace spirit { namespace x3 { namespace detail
+{
+    // This file contains low level routines for the flattened
+    // (frozen) TST, not for public consumption.
+    //
+    // A frozen TST is a tst_node tree compacted into a contiguous array.
+    // Links are 32-bit indices into that array.
+    // The root is always at index 0 and can never be a child, so a zero
+    // link means "no child". The values are stored contiguously in a
+    // separate array; a node's data field is a one-based index into it
+    // (zero means the node has no data).
+
+    template <typename Char, typename T>
+    struct frozen_tst_node
+    {
+        typedef tst_node<Char, T> tree_node;
+
+        template <typename Iterator, typename CaseCompare>
+        static T*
+        find(
+            frozen_tst_node const* nodes
+          , T* values
+          , Iterator& first
+          , Iterator last
+          , CaseCompare comp)
+        {
+            if (first == last)
+                return 0;
+
+            Iterator i = first;
+            Iterator latest = first;
+            frozen_tst_node const* p = nodes;
+            T* found = 0;
+
+            for (;;)
+            {
+                boost::uint32_t next;
+                int32_t c = comp(*i, p->id);
+                if (c == 0)
+                {
+                    if (p->data)
+                    {
+                        found = values + (p->data - 1);
+                        latest = i;
+                    }
+                    next = p->eq;
+                    if (++i == last)
+                        break;
+                }
+                else if (c < 0)
+                {
+                    next = p->lt;
+                }
+                else
+                {
+                    next = p->gt;
+                }
+
+                if (next == 0)
+                    break;
+                p = nodes + next;
+            }
+
+            if (found)
+                first = ++latest; // one past the last matching char
+            return found;
+        }
+
+        // Compact the tree rooted at root into nodes/values. Each sibling
+        // group (the binary tree spanned by the lt/gt links below an eq
+        // link) is laid out breadth-first in one contiguous block, so the
+        // lt/gt hops done while matching one character stay within a few
+        // adjacent cache lines. The groups themselves are emitted depth
+        // first: a group usually directly follows the node whose eq link
+        // points to it, keeping long single-path suffixes contiguous.
+        static void
+        freeze(
+            tree_node const* root
+          , std::vector<frozen_tst_node>& nodes
+          , std::vector<T>& values)
+        {
+            nodes.clear();
+            values.clear();
+            if (root == 0)
+                return;
+
+            // pending sibling groups: (group root, index of the node
+            // whose eq link points to it)
+            std::vector<std::pair<tree_node const*, boost::uint32_t>> groups;
+            std::vector<tree_node const*> queue;
+            groups.push_back(std::make_pair(root, boost::uint32_t(0)));
+            while (!groups.empty())
+            {
+                std::pair<tree_node const*, boost::uint32_t> g = groups.back();
+                groups.pop_back();
+
+                std::size_t const base = nodes.size();
+                BOOST_ASSERT(base < 0xffffffffu);
+                if (base != 0)
+                    nodes[g.second].eq = boost::uint32_t(base);
+
+                // queue[k] is the tree node that ends up at nodes[base + k]
+                queue.clear();
+                queue.push_back(g.first);
+                for (std::size_t k = 0; k != queue.size(); ++k)
+                {
+                    tree_node const* p = queue[k];
+                    frozen_tst_node n;
+                    n.id = p->id;
+                    n.lt = enqueue(queue, base, p->lt);
+                    n.eq = 0; // patched when the group is laid out
+                    n.gt = enqueue(queue, base, p->gt);
+                    n.data = 0;
+                    if (p->eq)
+                    {
+                        groups.push_back(std::make_pair(
+                            p->eq, boost::uint32_t(base + k)));
+                    }
+                    if (p->data)
+                    {
+                        values.push_back(*p->data);
+                        n.data = static_cast<boost::uint32_t>(values.size());
+                    }
+                    nodes.push_back(n);
+                }
+            }
+        }
+
+        // Rebuild a tst_node tree with the same shape as the frozen one.
+        template <typename Alloc>
+        static tree_node*
+        thaw(
+            frozen_tst_node const* nodes
+          , T const* values
+          , boost::uint32_t index
+          , Alloc* alloc)
+        {
+            frozen_tst_node const& n = nodes[index];
+            tree_node* p = alloc->new_node(n.id);
+            if (n.data)
+                p->data = alloc->new_data(values[n.data - 1]);
+            if (n.lt)
+                p->lt = thaw(nodes, values, n.lt, alloc);
+            if (n.eq)
+                p->eq = thaw(nodes, values, n.eq, alloc);
+            if (n.gt)
+                p->gt = thaw(nodes, values, n.gt, alloc);
+            return p;
+        }
+
+        template <typename F>
+        static void
+        for_each(
+            frozen_tst_node const* nodes
+          , T const* values
+          , boost::uint32_t index
+          , std::basic_string<Char> prefix
+          , F f)
+        {
+            frozen_tst_node const& n = nodes[index];
+            if (n.lt)
+                for_each(nodes, values, n.lt, prefix, f);
+            std::basic_string<Char> s = prefix + n.id;
+            if (n.eq)
+                for_each(nodes, values, n.eq, s, f);
+            if (n.data)
+                f(s, values[n.data - 1]);
+            if (n.gt)
+                for_each(nodes, values, n.gt, prefix, f);
+        }
+
+        Char id;                // the node's identity character
+        boost::uint32_t lt;     // left index (0 if none)
+        boost::uint32_t eq;     // middle index (0 if none)
+        boost::uint32_t gt;     // right index (0 if none)
+        boost::uint32_t data;   // one-based value index (0 if none)
+
+    private:
+
+        static boost::uint32_t
+        enqueue(
+            std::vector<tree_node const*>& queue
+          , std::size_t base
+          , tree_node const* p)
+        {
+            if (p == 0)
+                return 0;
+            queue.push_back(p);
+            BOOST_ASSERT(base + queue.size() <= 0xffffffffu);
+            return static_cast<boost::uint32_t>(base + queue.size() - 1);
+        }
+    };
+}}}}
+
+#endif
@@ -0,0 +1,178 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_FROZEN_TST_OCTOBER_17_2026_1015AM)
+#define BOOST_SPIRIT_X3_FROZEN_TST_OCTOBER_17_2026_1015AM
+
+#include <boost/spirit/home/x3/string/detail/tst.hpp>
+#include <boost/spirit/home/x3/string/detail/frozen_tst.hpp>
+#include <string>
+#include <vector>
+
+namespace boost { namespace spirit { namespace x3
+{
+    // A tst that can be frozen into a compact, read-only form. Entries
+    // are added to an ordinary tst_node tree; freeze() then compacts the
+    // tree into a contiguous array of nodes linked by 32-bit indices,
+    // with the values stored inline in a second array, and releases the
+    // tree. Lookups on a frozen tst touch far fewer cache lines. Adding
+    // or removing entries after freezing transparently thaws the tree
+    // again; call freeze() once more when done.
+    //
+    // Use it as the Lookup of a symbols_parser for large tables that
+    // are built once and then only queried:
+    //
+    //  symbols_parser<char_encoding::standard, int
+    //    , frozen_tst<char, int>> sym;
+    template <typename Char, typename T>
+    struct frozen_tst
+    {
+        typedef Char char_type; // the character type
+        typedef T value_type; // the value associated with each entry
+        typedef detail::tst_node<Char, T> node;
+        typedef detail::frozen_tst_node<Char, T> frozen_node;
+
+        frozen_tst()
+          : root(0)
+        {
+        }
+
+        ~frozen_tst()
+        {
+            clear();
+        }
+
+        frozen_tst(frozen_tst const& rhs)
+          : root(0)
+        {
+            copy(rhs);
+        }
+
+        frozen_tst& operator=(frozen_tst const& rhs)
+        {
+            return assign(rhs);
+        }
+
+        template <typename Iterator, typename CaseCompare>
+        T* find(Iterator& first, Iterator last, CaseCompare caseCompare) const
+        {
+            if (!nodes.empty())
+            {
+                // the values are only reachable through non-const
+                // symbols_parser members, just like the tst's T* data
+                return frozen_node::find(nodes.data()
+                  , const_cast<T*>(values.data()), first, last, caseCompare);
+            }
+            return node::find(root, first, last, caseCompare);
+        }
+
+        template <typename Iterator>
+        T* add(
+            Iterator first
+          , Iterator last
+          , typename boost::call_traits<T>::param_type val)
+        {
+            thaw();
+            return node::add(root, first, last, val, this);
+        }
+
+        template <typename Iterator>
+        void remove(Iterator first, Iterator last)
+        {
+            thaw();
+            node::remove(root, first, last, this);
+        }
+
+        void clear()
+        {
+            node::destruct_node(root, this);
+            root = 0;
+            nodes.clear();
+            values.clear();
+        }
+
+        template <typename F>
+        void for_each(F f) const
+        {
+            if (!nodes.empty())
+                frozen_node::for_each(nodes.data(), values.data()
+                  , 0, std::basic_string<Char>(), f);
+            else
+                node::for_each(root, std::basic_string<Char>(), f);
+        }
+
+        void freeze()
+        {
+            if (root == 0)
+                return;
+            frozen_node::freeze(root, nodes, values);
+            node::destruct_node(root, this);
+            root = 0;
+        }
+
+        bool frozen() const
+        {
+            return !nodes.empty();
+        }
+
+    private:
+
+        friend struct detail::tst_node<Char, T>;
+        friend struct detail::frozen_tst_node<Char, T>;
+
+        void thaw()
+        {
+            if (nodes.empty())
+                return;
+            root = frozen_node::thaw(nodes.data(), values.data(), 0, this);
+            std::vector<frozen_node>().swap(nodes);
+            std::vector<T>().swap(values);
+        }
+
+        void copy(frozen_tst const& rhs)
+        {
+            root = node::clone_node(rhs.root, this);
+            nodes = rhs.nodes;
+            values = rhs.values;
+        }
+
+        frozen_tst& assign(frozen_tst const& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                copy(rhs);
+            }
+            return *this;
+        }
+
+        node* root;
+        std::vector<frozen_node> nodes;
+        std::vector<T> values;
+
+        node* new_node(Char id)
+        {
+            return new node(id);
+        }
+
+        T* new_data(typename boost::call_traits<T>::param_type val)
+        {
+            return new T(val);
+        }
+
+        void delete_node(node* p)
+        {
+            delete p;
+        }
+
+        void delete_data(T* p)
+        {
+            delete p;
+        }
+    };
+}}}
+
+#endif
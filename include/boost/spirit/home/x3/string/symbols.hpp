@@ -113,6 +113,13 @@ namespace boost { namespace spirit { namespace x3
             lookup->clear();
         }
 
+        // Compact the symbol table for faster lookups. Only available
+        // if the Lookup supports it (e.g. frozen_tst).
+        void freeze()
+        {
+            lookup->freeze();
+        }
+
         struct adder;
         struct remover;
 
@@ -8,13 +8,12 @@
 #define BOOST_SPIRIT_X3_TST_MAP_JUNE_03_2007_1143AM
 
 #include <boost/spirit/home/x3/string/detail/tst.hpp>
-#include <unordered_map>
+#include <boost/spirit/home/x3/support/no_case.hpp>
+#include <boost/spirit/home/support/detail/tst_root.hpp>
 #include <boost/pool/object_pool.hpp>
 
 namespace boost { namespace spirit { namespace x3
 {
-    struct tst_pass_through; // declared in tst.hpp
-
     template <typename Char, typename T>
     struct tst_map
     {
@@ -42,34 +41,32 @@ namespace boost { namespace spirit { namespace x3
             return assign(rhs);
         }
 
-        template <typename Iterator, typename Filter>
-        T* find(Iterator& first, Iterator last, Filter filter) const
+        template <typename Iterator, typename CaseCompare>
+        T* find(Iterator& first, Iterator last, CaseCompare comp) const
         {
             if (first != last)
             {
                 Iterator save = first;
-                typename map_type::const_iterator
-                    i = map.find(filter(*first++));
-                if (i == map.end())
+                Char c = *first++;
+                if (T* p = find(c, first, last, comp))
                 {
-                    first = save;
-                    return 0;
+                    return p;
                 }
-                if (T* p = node::find(i->second.root, first, last, filter))
+
+                // keys may also start with the other case of c
+                Char other = other_case(c, comp);
+                if (other != c)
                 {
-                    return p;
+                    if (T* p = find(other, first, last, comp))
+                    {
+                        return p;
+                    }
                 }
-                return i->second.data;
+                first = save;
             }
             return 0;
         }
 
-        template <typename Iterator>
-        T* find(Iterator& first, Iterator last) const
-        {
-            return find(first, last, tst_pass_through());
-        }
-
         template <typename Iterator>
         bool add(
             Iterator first
@@ -78,20 +75,18 @@ namespace boost { namespace spirit { namespace x3
         {
             if (first != last)
             {
-                map_data x = {0, 0};
-                std::pair<typename map_type::iterator, bool>
-                    r = map.insert(std::pair<Char, map_data>(*first++, x));
+                map_data& x = map.insert(*first++);
 
                 if (first != last)
                 {
-                    return node::add(r.first->second.root
+                    return node::add(x.root
                       , first, last, val, this) ? true : false;
                 }
                 else
                 {
-                    if (r.first->second.data)
+                    if (x.data)
                         return false;
-                    r.first->second.data = this->new_data(val);
+                    x.data = this->new_data(val);
                 }
                 return true;
             }
@@ -103,21 +98,21 @@ namespace boost { namespace spirit { namespace x3
         {
             if (first != last)
             {
-                typename map_type::iterator i = map.find(*first++);
-                if (i != map.end())
+                Char c = *first++;
+                if (map_data* x = map.find(c))
                 {
                     if (first != last)
                     {
-                        node::remove(i->second.root, first, last, this);
+                        node::remove(x->root, first, last, this);
                     }
-                    else if (i->second.data)
+                    else if (x->data)
                     {
-                        this->delete_data(i->second.data);
-                        i->second.data = 0;
+                        this->delete_data(x->data);
+                        x->data = 0;
                     }
-                    if (i->second.data == 0 && i->second.root == 0)
+                    if (x->data == 0 && x->root == 0)
                     {
-                        map.erase(i);
+                        map.erase(c);
                     }
                 }
             }
@@ -125,11 +120,12 @@ namespace boost { namespace spirit { namespace x3
 
         void clear()
         {
-            for (typename map_type::value_type& x : map)
+            for (Char c : map.keys())
             {
-                node::destruct_node(x.second.root, this);
-                if (x.second.data)
-                    this->delete_data(x.second.data);
+                map_data const& x = *map.find(c);
+                node::destruct_node(x.root, this);
+                if (x.data)
+                    this->delete_data(x.data);
             }
             map.clear();
         }
@@ -137,12 +133,13 @@ namespace boost { namespace spirit { namespace x3
         template <typename F>
         void for_each(F f) const
         {
-            for (typename map_type::value_type const& x : map)
+            for (Char c : map.keys())
             {
-                std::basic_string<Char> s(1, x.first);
-                node::for_each(x.second.root, s, f);
-                if (x.second.data)
-                    f(s, *x.second.data);
+                map_data const& x = *map.find(c);
+                std::basic_string<Char> s(1, c);
+                node::for_each(x.root, s, f);
+                if (x.data)
+                    f(s, *x.data);
             }
         }
 
@@ -150,22 +147,47 @@ namespace boost { namespace spirit { namespace x3
 
         friend struct detail::tst_node<Char, T>;
 
-        struct map_data
+        template <typename Iterator, typename CaseCompare>
+        T* find(Char c, Iterator& first, Iterator last
+          , CaseCompare comp) const
         {
-            node* root;
-            T* data;
-        };
+            if (map_data const* x = map.find(c))
+            {
+                if (T* p = node::find(x->root, first, last, comp))
+                {
+                    return p;
+                }
+                return x->data;
+            }
+            return 0;
+        }
+
+        template <typename CaseCompare>
+        static Char other_case(Char c, CaseCompare)
+        {
+            return c;
+        }
+
+        template <typename Encoding>
+        static Char other_case(Char c, no_case_compare<Encoding>)
+        {
+            return Encoding::islower(c) ?
+                Encoding::toupper(c) : Encoding::tolower(c);
+        }
 
-        typedef std::unordered_map<Char, map_data> map_type;
+        // the roots are indexed by the first character of the keys
+        typedef spirit::detail::tst_root_table<Char, node, T> map_type;
+        typedef typename map_type::slot map_data;
 
         void copy(tst_map const& rhs)
         {
-            for (typename map_type::value_type const& x : rhs.map)
+            for (Char c : rhs.map.keys())
             {
-                map_data xx = {node::clone_node(x.second.root, this), 0};
-                if (x.second.data)
-                    xx.data = data_pool.construct(*x.second.data);
-                map[x.first] = xx;
+                map_data const& x = *rhs.map.find(c);
+                map_data& xx = map.insert(c);
+                xx.root = node::clone_node(x.root, this);
+                if (x.data)
+                    xx.data = data_pool.construct(*x.data);
             }
         }
 
@@ -173,11 +195,7 @@ namespace boost { namespace spirit { namespace x3
         {
             if (this != &rhs)
             {
-                for (typename map_type::value_type& x : map)
-                {
-                    node::destruct_node(x.second.root, this);
-                }
-                map.clear();
+                clear();
                 copy(rhs);
             }
             return *this;
@@ -204,7 +222,7 @@ namespace boost { namespace spirit { namespace x3
         }
 
         map_type map;
-        object_pool<node> node_pool;
+        spirit::detail::tst_node_pool<node> node_pool;
         object_pool<T> data_pool;
     };
 }}}
@@ -10,6 +10,11 @@
 #include <boost/range.hpp>
 #include <boost/type_traits/is_base_of.hpp>
 #include <boost/core/enable_if.hpp>
+#include <boost/cstdint.hpp>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
 
 namespace boost { namespace spirit { namespace x3
 {
@@ -28,6 +33,7 @@ namespace boost { namespace spirit { namespace x3
     public:
 
         typedef typename Container::value_type iterator_type;
+        typedef position_tagged tag_type;
 
         position_cache(
             iterator_type first
@@ -95,6 +101,116 @@ namespace boost { namespace spirit { namespace x3
         iterator_type last_;
     };
 
+    struct offset_position_tagged
+    {
+        // Use this to annotate an AST for an offset_position_cache (below).
+        // The id is a key to the start and end offsets of the AST node.
+        int id = -1;
+    };
+
+    // A position cache that stores the positions as offsets from the start
+    // of the input, Offset (32 bit by default) each, instead of iterators.
+    // AST nodes inheriting from offset_position_tagged need a single int.
+    // Offsets are computed and turned back into iterators with
+    // std::distance and std::next, which is O(1) for random access
+    // iterators only.
+    template <typename Iterator, typename Offset = boost::uint32_t>
+    class offset_position_cache
+    {
+    public:
+
+        typedef Iterator iterator_type;
+        typedef Offset offset_type;
+        typedef offset_position_tagged tag_type;
+
+        struct position
+        {
+            Offset first;
+            Offset last;
+        };
+
+        typedef std::vector<position> container_type;
+
+        offset_position_cache(
+            iterator_type first
+          , iterator_type last)
+          : first_(first), last_(last) {}
+
+        // This will catch all nodes inheriting from offset_position_tagged
+        boost::iterator_range<iterator_type>
+        position_of(offset_position_tagged const& ast) const
+        {
+            position const& pos = positions.at(ast.id); // throws if out of range
+            return boost::iterator_range<iterator_type>(
+                std::next(first_, pos.first), std::next(first_, pos.last));
+        }
+
+        // This will catch all nodes except those inheriting from
+        // offset_position_tagged
+        template <typename AST>
+        typename boost::enable_if_c<
+            (!is_base_of<offset_position_tagged, AST>::value)
+          , boost::iterator_range<iterator_type>
+        >::type
+        position_of(AST const& /* ast */) const
+        {
+            // returns an empty position
+            return boost::iterator_range<iterator_type>();
+        }
+
+        // This will catch all nodes except those inheriting from
+        // offset_position_tagged
+        template <typename AST>
+        void annotate(AST& /* ast */, iterator_type /* first */, iterator_type /* last */, mpl::false_)
+        {
+            // (no-op) no need for tags
+        }
+
+        // This will catch all nodes inheriting from offset_position_tagged
+        void annotate(offset_position_tagged& ast, iterator_type first, iterator_type last, mpl::true_)
+        {
+            if (positions.size() >= std::size_t((std::numeric_limits<int>::max)()))
+                throw std::length_error("offset_position_cache: too many nodes");
+
+            position pos = { offset(first), offset(last) };
+            ast.id = int(positions.size());
+            positions.push_back(pos);
+        }
+
+        template <typename AST>
+        void annotate(AST& ast, iterator_type first, iterator_type last)
+        {
+            annotate(ast, first, last, is_base_of<offset_position_tagged, AST>());
+        }
+
+        container_type const&
+        get_positions() const
+        {
+            return positions;
+        }
+
+        iterator_type first() const { return first_; }
+        iterator_type last() const { return last_; }
+
+    private:
+
+        Offset offset(iterator_type i) const
+        {
+            typename std::iterator_traits<iterator_type>::difference_type const
+                n = std::distance(first_, i);
+            if (n < 0 || static_cast<boost::uintmax_t>(n) >
+                    static_cast<boost::uintmax_t>((std::numeric_limits<Offset>::max)()))
+            {
+                throw std::length_error("offset_position_cache: offset out of range");
+            }
+            return Offset(n);
+        }
+
+        container_type positions;
+        iterator_type first_;
+        iterator_type last_;
+    };
+
 }}}
 
 #endif
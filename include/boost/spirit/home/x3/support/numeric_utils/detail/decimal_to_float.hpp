@@ -0,0 +1,344 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+    http://spirit.sourceforge.net/
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_DETAIL_DECIMAL_TO_FLOAT_OCTOBER_17_2026_1215PM)
+#define BOOST_SPIRIT_X3_DETAIL_DECIMAL_TO_FLOAT_OCTOBER_17_2026_1215PM
+
+#include <boost/spirit/home/x3/support/numeric_utils/detail/powers_of_five.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/limits.hpp>
+#include <cfloat>
+#include <cstring>
+
+#if defined(BOOST_MSVC) && defined(_M_X64)
+# include <intrin.h>
+#endif
+
+namespace boost { namespace spirit { namespace x3 { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //  Correctly rounded conversion of w * 10^q to float or double, where w
+    //  holds at most 19 significant decimal digits.
+    //
+    //  Exact cases are handled by Clinger's fast path (w and 10^|q| are
+    //  exactly representable, so a single rounding multiplication or
+    //  division is correct). Everything else goes through the Eisel-Lemire
+    //  algorithm, which multiplies w by a 128-bit approximation of 5^q and
+    //  detects the rare cases where that approximation is too coarse to
+    //  decide the rounding. In those cases decimal_to_float returns false
+    //  and the caller must fall back to a slower algorithm.
+    //
+    //  See D. Lemire, "Number Parsing at a Gigabyte per Second",
+    //  Software: Practice and Experience 51 (8), 2021.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct binary_format;
+
+    template <>
+    struct binary_format<double>
+    {
+        typedef boost::uint64_t bits_type;
+        static int const mantissa_explicit_bits = 52;
+        static int const minimum_exponent = -1023;
+        static int const infinite_power = 0x7ff;
+        static int const smallest_power_of_ten = -342;
+        static int const largest_power_of_ten = 308;
+        static int const min_exponent_round_to_even = -4;
+        static int const max_exponent_round_to_even = 23;
+        static int const max_exponent_fast_path = 22;
+
+        static double exact_power_of_ten(int q)
+        {
+            static double const powers[] =
+            {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            return powers[q];
+        }
+    };
+
+    template <>
+    struct binary_format<float>
+    {
+        typedef boost::uint32_t bits_type;
+        static int const mantissa_explicit_bits = 23;
+        static int const minimum_exponent = -127;
+        static int const infinite_power = 0xff;
+        static int const smallest_power_of_ten = -65;
+        static int const largest_power_of_ten = 38;
+        static int const min_exponent_round_to_even = -17;
+        static int const max_exponent_round_to_even = 10;
+        static int const max_exponent_fast_path = 10;
+
+        static float exact_power_of_ten(int q)
+        {
+            static float const powers[] =
+            {
+                1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+            };
+            return powers[q];
+        }
+    };
+
+    struct uint128
+    {
+        boost::uint64_t high;
+        boost::uint64_t low;
+    };
+
+    inline uint128 full_multiplication(boost::uint64_t a, boost::uint64_t b)
+    {
+        uint128 r;
+#if defined(BOOST_HAS_INT128)
+        boost::uint128_type const p = boost::uint128_type(a) * b;
+        r.high = boost::uint64_t(p >> 64);
+        r.low = boost::uint64_t(p);
+#elif defined(BOOST_MSVC) && defined(_M_X64)
+        r.low = _umul128(a, b, &r.high);
+#else
+        boost::uint64_t const a_lo = a & 0xffffffffu, a_hi = a >> 32;
+        boost::uint64_t const b_lo = b & 0xffffffffu, b_hi = b >> 32;
+        boost::uint64_t const lo_lo = a_lo * b_lo;
+        boost::uint64_t const hi_lo = a_hi * b_lo;
+        boost::uint64_t const lo_hi = a_lo * b_hi;
+        boost::uint64_t const hi_hi = a_hi * b_hi;
+        boost::uint64_t const cross =
+            (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+        r.high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        r.low = (cross << 32) | (lo_lo & 0xffffffffu);
+#endif
+        return r;
+    }
+
+    inline int leading_zeroes(boost::uint64_t w)
+    {
+#if defined(__GNUC__)
+        return __builtin_clzll(w);
+#else
+        int n = 0;
+        while (!(w & (boost::uint64_t(1) << 63)))
+        {
+            w <<= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    // floor(log2(10^q)) + 63, valid for q in [-1390, 1233]
+    inline int binary_power(int q)
+    {
+        return (((152170 + 65536) * q) >> 16) + 63;
+    }
+
+    template <typename T>
+    inline bool eisel_lemire(
+        boost::uint64_t w, int q, boost::uint64_t& mantissa, int& power2)
+    {
+        typedef binary_format<T> format;
+        typedef powers_of_five_128<> powers;
+
+        if (w == 0 || q < format::smallest_power_of_ten)
+        {
+            mantissa = 0;
+            power2 = 0;
+            return true;
+        }
+        if (q > format::largest_power_of_ten)
+        {
+            mantissa = 0;
+            power2 = format::infinite_power;
+            return true;
+        }
+
+        int const lz = leading_zeroes(w);
+        w <<= lz;
+
+        // Multiply by the truncated 5^q, refining with the next 64 bits
+        // only if the bits we need are not already decided.
+        int const index = 2 * (q - powers::smallest_power);
+        boost::uint64_t const precision_mask =
+            ~boost::uint64_t(0) >> (format::mantissa_explicit_bits + 3);
+        uint128 product = full_multiplication(w, powers::table[index]);
+        if ((product.high & precision_mask) == precision_mask)
+        {
+            uint128 const second =
+                full_multiplication(w, powers::table[index + 1]);
+            product.low += second.high;
+            if (second.high > product.low)
+                ++product.high;
+        }
+
+        // The product might still be off by one unit in the last place;
+        // outside of the range where 5^q is exact we can't tell.
+        if (product.low == ~boost::uint64_t(0) && (q < -27 || q > 55))
+            return false;
+
+        int const upperbit = int(product.high >> 63);
+        int const shift = upperbit + 64 - format::mantissa_explicit_bits - 3;
+        mantissa = product.high >> shift;
+        power2 = binary_power(q) + upperbit - lz - format::minimum_exponent;
+
+        if (power2 <= 0) // subnormal
+        {
+            if (-power2 + 1 >= 64)
+            {
+                mantissa = 0;
+                power2 = 0;
+                return true;
+            }
+            mantissa >>= -power2 + 1;
+            mantissa += (mantissa & 1); // round up
+            mantissa >>= 1;
+            power2 = (mantissa <
+                (boost::uint64_t(1) << format::mantissa_explicit_bits)) ? 0 : 1;
+            return true;
+        }
+
+        // We usually round up, but exactly halfway between two values we
+        // must round to even.
+        if (product.low <= 1
+         && q >= format::min_exponent_round_to_even
+         && q <= format::max_exponent_round_to_even
+         && (mantissa & 3) == 1
+         && (mantissa << shift) == product.high)
+        {
+            mantissa &= ~boost::uint64_t(1);
+        }
+
+        mantissa += (mantissa & 1); // round up
+        mantissa >>= 1;
+        if (mantissa >= (boost::uint64_t(2) << format::mantissa_explicit_bits))
+        {
+            mantissa = boost::uint64_t(1) << format::mantissa_explicit_bits;
+            ++power2;
+        }
+        mantissa &= ~(boost::uint64_t(1) << format::mantissa_explicit_bits);
+        if (power2 >= format::infinite_power)
+        {
+            mantissa = 0;
+            power2 = format::infinite_power;
+        }
+        return true;
+    }
+
+    template <typename T>
+    inline bool decimal_to_float(boost::uint64_t w, int q, T& n)
+    {
+        typedef binary_format<T> format;
+        typedef typename format::bits_type bits_type;
+
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+        // Clinger's fast path: needs strict IEEE arithmetic on T
+        if (q >= -format::max_exponent_fast_path
+         && q <= format::max_exponent_fast_path
+         && w <= (boost::uint64_t(2) << format::mantissa_explicit_bits))
+        {
+            n = T(w);
+            if (q < 0)
+                n /= format::exact_power_of_ten(-q);
+            else
+                n *= format::exact_power_of_ten(q);
+            return true;
+        }
+#endif
+        boost::uint64_t mantissa;
+        int power2;
+        if (!eisel_lemire<T>(w, q, mantissa, power2))
+            return false;
+
+        bits_type const bits = bits_type(mantissa)
+          | (bits_type(power2) << format::mantissa_explicit_bits);
+        std::memcpy(&n, &bits, sizeof(n));
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Collects the decimal digits of a real number into a 64-bit integer
+    //  and a power of ten. Digits beyond the 19th significant one are
+    //  dropped and only recorded as truncated.
+    ///////////////////////////////////////////////////////////////////////////
+    struct decimal_accumulator
+    {
+        decimal_accumulator()
+          : w(0), exp10(0), digits(0), truncated(false) {}
+
+        template <typename Iterator>
+        bool parse_digits(Iterator& first, Iterator const& last, bool frac)
+        {
+            Iterator i = first;
+
+            // leading zeros are not significant
+            if (digits == 0)
+            {
+                for (; i != last && *i == '0'; ++i)
+                {
+                    if (frac)
+                        --exp10;
+                }
+            }
+
+            int n = 0;
+            for (; i != last && digits + n < 19; ++i)
+            {
+                unsigned const d = static_cast<unsigned>(*i) - '0';
+                if (d > 9)
+                    break;
+                w = w * 10 + d;
+                ++n;
+            }
+            digits += n;
+            if (frac)
+                exp10 -= n;
+
+            // digits beyond the 19th only count for the magnitude
+            for (; i != last; ++i)
+            {
+                if (static_cast<unsigned>(*i) - '0' > 9)
+                    break;
+                truncated = true;
+                if (!frac)
+                    ++exp10;
+            }
+
+            bool const any = (i != first);
+            first = i;
+            return any;
+        }
+
+        template <typename T>
+        bool to_float(T& n) const
+        {
+            // Huge exponents are way out of range anyway, keep them from
+            // overflowing int.
+            long const q = exp10;
+            if (q < -100000 || q > 100000)
+                return false;
+            if (!truncated)
+                return decimal_to_float(w, int(q), n);
+
+            // The exact value is somewhere in [w, w + 1) * 10^q. If both
+            // ends round to the same number, so does the value.
+            T upper;
+            return decimal_to_float(w, int(q), n)
+                && decimal_to_float(w + 1, int(q), upper)
+                && n == upper;
+        }
+
+        boost::uint64_t w;  // the significant digits
+        long exp10;         // the power of ten to scale w by
+        int digits;         // the number of digits in w
+        bool truncated;     // true if more digits followed
+    };
+}}}}
+
+#endif
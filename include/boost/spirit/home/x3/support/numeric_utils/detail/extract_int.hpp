@@ -16,6 +16,7 @@
 #include <boost/spirit/home/x3/support/traits/move_to.hpp>
 #include <boost/spirit/home/x3/support/traits/numeric_traits.hpp>
 #include <boost/spirit/home/support/char_encoding/ascii.hpp>
+#include <boost/spirit/home/support/detail/swar_digits.hpp>
 
 #include <boost/preprocessor/repetition/repeat.hpp>
 #include <boost/preprocessor/iteration/local.hpp>
@@ -148,6 +149,12 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
             n += static_cast<T>(digit);
             return true;
         }
+
+        template <typename T>
+        inline static void add_block(T& n, T scale, T block) // unchecked add
+        {
+            n = n * scale + block;
+        }
     };
 
     template <unsigned Radix>
@@ -179,6 +186,12 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
             n -= static_cast<T>(digit);
             return true;
         }
+
+        template <typename T>
+        inline static void add_block(T& n, T scale, T block) // unchecked subtract
+        {
+            n = n * scale - block;
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -237,6 +250,68 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  Bulk conversion of decimal digits: as long as none of them can
+    //  overflow, take eight digits at a time from contiguous char ranges.
+    //  Stops at the first block that is not all digits, or that gets too
+    //  close to the overflow limit; the per-digit loop does the rest.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Accumulator>
+    struct is_block_accumulator : mpl::false_ {};
+
+    template <>
+    struct is_block_accumulator<positive_accumulator<10> > : mpl::true_ {};
+
+    template <>
+    struct is_block_accumulator<negative_accumulator<10> > : mpl::true_ {};
+
+    template <typename T>
+    struct has_eight_overflow_free_digits
+      : mpl::bool_<(digits_traits<T, 10>::value - 1 >= 8)> {};
+
+    template <unsigned Radix, typename Accumulator>
+    struct block_extractor
+    {
+        template <typename Iterator, typename T>
+        inline static void
+        call(Iterator& it, Iterator const& last, std::size_t& count, T& n, mpl::true_)
+        {
+            std::size_t constexpr overflow_free = digits_traits<T, 10>::value - 1;
+
+            while (count + 8 <= overflow_free && last - it >= 8)
+            {
+                boost::uint64_t const chunk = spirit::detail::load_eight_chars(it);
+                if (!spirit::detail::is_eight_digits(chunk))
+                    break;
+                Accumulator::add_block(n, T(100000000)
+                  , T(spirit::detail::eight_digits_value(chunk)));
+                it += 8;
+                count += 8;
+            }
+        }
+
+        template <typename Iterator, typename T>
+        inline static void
+        call(Iterator&, Iterator const&, std::size_t&, T&, mpl::false_)
+        {
+        }
+
+        template <typename Iterator, typename T>
+        inline static void
+        call(Iterator& it, Iterator const& last, std::size_t& count, T& n)
+        {
+            call(it, last, count, n
+              , typename mpl::and_<
+                    mpl::bool_<Radix == 10>
+                  , is_block_accumulator<Accumulator>
+                  , spirit::detail::is_swar_digits_iterator<Iterator>
+                  , is_integral<T>
+                  , has_eight_overflow_free_digits<T>
+                >::type()
+            );
+        }
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     //  End of loop checking: check if the number of digits
     //  being parsed exceeds MaxDigits. Note: if MaxDigits == -1
@@ -437,6 +512,7 @@ namespace boost { namespace spirit { namespace x3 { namespace detail
 
             count = 0;
             ++it;
+            block_extractor<Radix, Accumulator>::call(it, last, count, val);
             while (true)
             {
                 BOOST_PP_REPEAT(
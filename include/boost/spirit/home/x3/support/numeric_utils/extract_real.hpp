@@ -15,7 +15,10 @@
 #include <boost/spirit/home/x3/support/unused.hpp>
 #include <boost/spirit/home/x3/support/numeric_utils/pow10.hpp>
 #include <boost/spirit/home/x3/support/numeric_utils/sign.hpp>
+#include <boost/spirit/home/x3/support/numeric_utils/detail/decimal_to_float.hpp>
 #include <boost/spirit/home/x3/support/traits/move_to.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/assert.hpp>
 
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1400)
@@ -107,6 +110,23 @@ namespace boost { namespace spirit { namespace x3 { namespace extension
 
 namespace boost { namespace spirit { namespace x3
 {
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        //  Real policies opt into the fast path by defining
+        //  static bool const fast_path = true. The fast path scans decimal
+        //  digits itself and does not call parse_n and parse_frac_n.
+        ///////////////////////////////////////////////////////////////////////
+        template <typename RealPolicies, typename Enable = void>
+        struct use_fast_real_path
+          : mpl::false_ {};
+
+        template <typename RealPolicies>
+        struct use_fast_real_path<RealPolicies
+          , typename enable_if_c<RealPolicies::fast_path>::type>
+          : mpl::true_ {};
+    }
+
     template <typename T, typename RealPolicies>
     struct extract_real
     {
@@ -114,6 +134,101 @@ namespace boost { namespace spirit { namespace x3
         static bool
         parse(Iterator& first, Iterator const& last, Attribute& attr,
             RealPolicies const& p)
+        {
+            return parse(first, last, attr, p, mpl::bool_<
+                detail::use_fast_real_path<RealPolicies>::value
+             && (is_same<T, double>::value || is_same<T, float>::value)>());
+        }
+
+    private:
+
+        template <typename Iterator, typename Attribute>
+        static bool
+        parse(Iterator& first, Iterator const& last, Attribute& attr,
+            RealPolicies const& p, mpl::true_)
+        {
+            if (first == last)
+                return false;
+            Iterator save = first;
+
+            // This follows the structure of the generic parse below, but
+            // collects up to 19 significant digits in a 64-bit integer and
+            // converts that with the Eisel-Lemire algorithm.
+            bool neg = p.parse_sign(first, last);
+
+            detail::decimal_accumulator d;
+            bool got_a_number = d.parse_digits(first, last, false);
+
+            if (!got_a_number)
+            {
+                T n = 0;
+                if (p.parse_nan(first, last, n) ||
+                    p.parse_inf(first, last, n))
+                {
+                    traits::move_to(extension::negate(neg, n), attr);
+                    return true;
+                }
+
+                if (!p.allow_leading_dot)
+                {
+                    first = save;
+                    return false;
+                }
+            }
+
+            bool e_hit = false;
+            if (p.parse_dot(first, last))
+            {
+                if (!d.parse_digits(first, last, true)
+                    && (!got_a_number || !p.allow_trailing_dot))
+                {
+                    first = save;
+                    return false;
+                }
+                e_hit = p.parse_exp(first, last);
+            }
+            else
+            {
+                if (!got_a_number)
+                {
+                    first = save;
+                    return false;
+                }
+                e_hit = p.parse_exp(first, last);
+                if (p.expect_dot && !e_hit)
+                {
+                    first = save;
+                    return false;
+                }
+            }
+
+            if (e_hit)
+            {
+                int exp = 0;
+                if (!p.parse_exp_n(first, last, exp))
+                {
+                    first = save;
+                    return false;
+                }
+                d.exp10 += exp;
+            }
+
+            T n;
+            if (!d.to_float(n))
+            {
+                // A hard case: redo it the slow way
+                first = save;
+                return parse(first, last, attr, p, mpl::false_());
+            }
+
+            traits::move_to(extension::negate(neg, n), attr);
+            return true;
+        }
+
+        template <typename Iterator, typename Attribute>
+        static bool
+        parse(Iterator& first, Iterator const& last, Attribute& attr,
+            RealPolicies const& p, mpl::false_)
         {
             if (first == last)
                 return false;
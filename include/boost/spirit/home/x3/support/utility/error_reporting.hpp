@@ -13,6 +13,7 @@
 
 #include <boost/locale/encoding_utf.hpp>
 #include <boost/spirit/home/x3/support/ast/position_tagged.hpp>
+#include <boost/spirit/home/x3/support/utility/line_index.hpp>
 #include <ostream>
 
 // Clang-style error handling utilities
@@ -22,12 +23,18 @@ namespace boost { namespace spirit { namespace x3
     // tag used to get our error handler from the context
     struct error_handler_tag;
 
-    template <typename Iterator>
+    // PositionCache is position_cache<std::vector<Iterator>>, whose AST
+    // nodes inherit from position_tagged, or offset_position_cache<Iterator>
+    // for nodes inheriting from offset_position_tagged.
+    template <typename Iterator
+      , typename PositionCache = position_cache<std::vector<Iterator>>>
     class error_handler
     {
     public:
 
         typedef Iterator iterator_type;
+        typedef PositionCache position_cache_type;
+        typedef typename PositionCache::tag_type position_tag_type;
 
         error_handler(
             Iterator first, Iterator last, std::ostream& err_out
@@ -35,13 +42,14 @@ namespace boost { namespace spirit { namespace x3
           : err_out(err_out)
           , file(file)
           , tabs(tabs)
-          , pos_cache(first, last) {}
+          , pos_cache(first, last)
+          , lines(first, last) {}
 
         typedef void result_type;
 
         void operator()(Iterator err_pos, std::string const& error_message) const;
         void operator()(Iterator err_first, Iterator err_last, std::string const& error_message) const;
-        void operator()(position_tagged pos, std::string const& message) const
+        void operator()(position_tag_type pos, std::string const& message) const
         {
             auto where = pos_cache.position_of(pos);
             (*this)(where.begin(), where.end(), message);
@@ -53,16 +61,35 @@ namespace boost { namespace spirit { namespace x3
             return pos_cache.annotate(ast, first, last);
         }
 
-        boost::iterator_range<Iterator> position_of(position_tagged pos) const
+        boost::iterator_range<Iterator> position_of(position_tag_type pos) const
         {
             return pos_cache.position_of(pos);
         }
 
-        position_cache<std::vector<Iterator>> const& get_position_cache() const
+        PositionCache const& get_position_cache() const
         {
             return pos_cache;
         }
 
+        // Line and column of a position, for tools that do their own
+        // reporting. The line index is built on the first call.
+        typedef typename line_index<Iterator>::location location;
+
+        location location_of(Iterator pos) const
+        {
+            return lines.location_of(pos);
+        }
+
+        location location_of(position_tag_type pos) const
+        {
+            return lines.location_of(pos_cache.position_of(pos).begin());
+        }
+
+        line_index<Iterator> const& get_line_index() const
+        {
+            return lines;
+        }
+
     private:
 
         void print_file_line(std::size_t line) const;
@@ -70,17 +97,16 @@ namespace boost { namespace spirit { namespace x3
         void print_indicator(Iterator& line_start, Iterator last, char ind) const;
         void skip_whitespace(Iterator& err_pos, Iterator last) const;
         void skip_non_whitespace(Iterator& err_pos, Iterator last) const;
-        Iterator get_line_start(Iterator first, Iterator pos) const;
-        std::size_t position(Iterator i) const;
 
         std::ostream& err_out;
         std::string file;
         int tabs;
-        position_cache<std::vector<Iterator>> pos_cache;
+        PositionCache pos_cache;
+        line_index<Iterator> lines;
     };
 
-    template <typename Iterator>
-    void error_handler<Iterator>::print_file_line(std::size_t line) const
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::print_file_line(std::size_t line) const
     {
         if (file != "")
         {
@@ -99,8 +125,8 @@ namespace boost { namespace spirit { namespace x3
         err_out << "line " << line << ':' << std::endl;
     }
 
-    template <typename Iterator>
-    void error_handler<Iterator>::print_line(Iterator start, Iterator last) const
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::print_line(Iterator start, Iterator last) const
     {
         auto end = start;
         while (end != last)
@@ -116,8 +142,8 @@ namespace boost { namespace spirit { namespace x3
         err_out << locale::conv::utf_to_utf<char>(line) << std::endl;
     }
 
-    template <typename Iterator>
-    void error_handler<Iterator>::print_indicator(Iterator& start, Iterator last, char ind) const
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::print_indicator(Iterator& start, Iterator last, char ind) const
     {
         for (; start != last; ++start)
         {
@@ -132,8 +158,8 @@ namespace boost { namespace spirit { namespace x3
         }
     }
 
-    template <typename Iterator>
-    void error_handler<Iterator>::skip_whitespace(Iterator& err_pos, Iterator last) const
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::skip_whitespace(Iterator& err_pos, Iterator last) const
     {
         // make sure err_pos does not point to white space
         while (err_pos != last)
@@ -146,8 +172,8 @@ namespace boost { namespace spirit { namespace x3
         }
     }
 
-    template <typename Iterator>
-    void error_handler<Iterator>::skip_non_whitespace(Iterator& err_pos, Iterator last) const
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::skip_non_whitespace(Iterator& err_pos, Iterator last) const
     {
         // make sure err_pos does not point to white space
         while (err_pos != last)
@@ -160,77 +186,39 @@ namespace boost { namespace spirit { namespace x3
         }
     }
 
-    template <class Iterator>
-    inline Iterator error_handler<Iterator>::get_line_start(Iterator first, Iterator pos) const
-    {
-        Iterator latest = first;
-        for (Iterator i = first; i != pos; ++i)
-            if (*i == '\r' || *i == '\n')
-                latest = i;
-        return latest;
-    }
-
-    template <typename Iterator>
-    std::size_t error_handler<Iterator>::position(Iterator i) const
-    {
-        std::size_t line { 1 };
-        typename std::iterator_traits<Iterator>::value_type prev { 0 };
-
-        for (Iterator pos = pos_cache.first(); pos != i; ++pos) {
-            auto c = *pos;
-            switch (c) {
-            case '\n':
-                if (prev != '\r') ++line;
-                break;
-            case '\r':
-                ++line;
-                break;
-            default:
-                break;
-            }
-            prev = c;
-        }
-
-        return line;
-    }
-
-    template <typename Iterator>
-    void error_handler<Iterator>::operator()(
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::operator()(
         Iterator err_pos, std::string const& error_message) const
     {
-        Iterator first = pos_cache.first();
         Iterator last = pos_cache.last();
 
         // make sure err_pos does not point to white space
         skip_whitespace(err_pos, last);
 
-        print_file_line(position(err_pos));
+        std::size_t const line = lines.line(err_pos);
+        print_file_line(line);
         err_out << error_message << std::endl;
 
-        Iterator start = get_line_start(first, err_pos);
-        if (start != first)
-            ++start;
+        Iterator start = lines.line_start(line);
         print_line(start, last);
         print_indicator(start, err_pos, '_');
         err_out << "^_" << std::endl;
     }
 
-    template <typename Iterator>
-    void error_handler<Iterator>::operator()(
+    template <typename Iterator, typename PositionCache>
+    void error_handler<Iterator, PositionCache>::operator()(
         Iterator err_first, Iterator err_last, std::string const& error_message) const
     {
-        Iterator first = pos_cache.first();
         Iterator last = pos_cache.last();
 
         // make sure err_pos does not point to white space
         skip_whitespace(err_first, last);
 
-        print_file_line(position(err_first));
+        std::size_t const line = lines.line(err_first);
+        print_file_line(line);
         err_out << error_message << std::endl;
 
-        Iterator start = get_line_start(first, err_first);
-        if (start != first)
-            ++start;
+        Iterator start = lines.line_start(line);
         print_line(start, last);
         print_indicator(start, err_first, ' ');
         print_indicator(start, err_last, '~');
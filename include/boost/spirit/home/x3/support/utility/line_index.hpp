@@ -0,0 +1,151 @@
+/*=============================================================================
+    Copyright (c) 2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_LINE_INDEX_OCT_18_2026_1010AM)
+#define BOOST_SPIRIT_X3_LINE_INDEX_OCT_18_2026_1010AM
+
+#include <boost/spirit/home/support/detail/find_line_break.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace boost { namespace spirit { namespace x3
+{
+    // The line starts of an input range, used to map an iterator to its
+    // line and column in O(log n) instead of rescanning the input. A line
+    // ends with "\r\n", "\r" or "\n". The index is built on first use; the
+    // const member functions are therefore not safe to call concurrently
+    // before the first lookup. Lookups of iterators that are not random
+    // access still need a std::distance from the start of the input.
+    template <typename Iterator>
+    class line_index
+    {
+    public:
+
+        typedef Iterator iterator_type;
+
+        struct location
+        {
+            std::size_t line;       // 1 based
+            std::size_t column;     // 1 based, a tab counts as one column
+        };
+
+        line_index(Iterator first, Iterator last)
+          : first_(first), last_(last) {}
+
+        // The number of lines, an empty input has one (empty) line
+        std::size_t lines() const
+        {
+            return get_starts().size();
+        }
+
+        // The line holding pos
+        std::size_t line(Iterator pos) const
+        {
+            return line_of_offset(std::distance(first_, pos));
+        }
+
+        location location_of(Iterator pos) const
+        {
+            std::size_t const offset = std::distance(first_, pos);
+            std::size_t const line = line_of_offset(offset);
+            location result = { line, offset - get_starts()[line - 1] + 1 };
+            return result;
+        }
+
+        // The first character of the given line
+        Iterator line_start(std::size_t line) const
+        {
+            Iterator i = first_;
+            std::advance(i, get_starts().at(line - 1));
+            return i;
+        }
+
+        // The given line, without its line break
+        boost::iterator_range<Iterator> line_range(std::size_t line) const
+        {
+            Iterator start = line_start(line);
+            Iterator end = start;
+            while (end != last_ && *end != '\r' && *end != '\n')
+                ++end;
+            return boost::iterator_range<Iterator>(start, end);
+        }
+
+        Iterator first() const { return first_; }
+        Iterator last() const { return last_; }
+
+    private:
+
+        template <typename T>
+        struct is_contiguous_char
+          : std::integral_constant<bool,
+                std::is_same<T, char const*>::value
+             || std::is_same<T, char*>::value
+             || std::is_same<T, std::string::const_iterator>::value
+             || std::is_same<T, std::string::iterator>::value>
+        {};
+
+        std::size_t line_of_offset(std::size_t offset) const
+        {
+            std::vector<std::size_t> const& starts = get_starts();
+            return std::upper_bound(starts.begin(), starts.end(), offset)
+                - starts.begin();
+        }
+
+        std::vector<std::size_t> const& get_starts() const
+        {
+            if (starts.empty())
+            {
+                starts.push_back(0);
+                build(is_contiguous_char<Iterator>());
+            }
+            return starts;
+        }
+
+        void build(std::true_type) const
+        {
+            if (first_ == last_)
+                return;
+
+            char const* const base = &*first_;
+            char const* const end = base + (last_ - first_);
+            for (char const* i = base; ; ++i)
+            {
+                i = spirit::detail::find_line_break(i, end);
+                if (i == end)
+                    break;
+                if (*i == '\r' && i + 1 != end && i[1] == '\n')
+                    ++i;
+                starts.push_back(i + 1 - base);
+            }
+        }
+
+        void build(std::false_type) const
+        {
+            typename std::iterator_traits<Iterator>::value_type prev { 0 };
+            std::size_t offset = 0;
+            for (Iterator i = first_; i != last_; ++i)
+            {
+                auto c = *i;
+                ++offset;
+                if (c == '\n' && prev == '\r')
+                    starts.back() = offset;
+                else if (c == '\r' || c == '\n')
+                    starts.push_back(offset);
+                prev = c;
+            }
+        }
+
+        Iterator first_;
+        Iterator last_;
+        mutable std::vector<std::size_t> starts;    // empty until first use
+    };
+}}}
+
+#endif
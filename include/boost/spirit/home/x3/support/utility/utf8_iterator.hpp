@@ -0,0 +1,213 @@
+/*=============================================================================
+    Copyright (c) 2001-2014 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_X3_UTF8_ITERATOR_OCT_18_2026_1000PM)
+#define BOOST_SPIRIT_X3_UTF8_ITERATOR_OCT_18_2026_1000PM
+
+#include <boost/spirit/home/x3/support/utility/utf8.hpp>
+#include <boost/spirit/home/support/detail/find_non_ascii.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+namespace boost { namespace spirit { namespace x3
+{
+    namespace detail
+    {
+        // the number of bytes from pos on known to be ASCII, pos holds one
+        inline std::size_t utf8_ascii_run(char const* pos, char const* last)
+        {
+            return spirit::detail::find_non_ascii(pos, last) - pos;
+        }
+
+        template <typename Iterator>
+        std::size_t utf8_ascii_run(Iterator const&, Iterator const&)
+        {
+            return 1;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Decodes UTF-8 on the fly, presenting the bytes in [first, last) as a
+    //  sequence of code points that can be parsed with the unicode char
+    //  parsers. Over a char const* range, runs of ASCII are found with a
+    //  vector scan and then walked without decoding.
+    //
+    //  Ill-formed input decodes to U+FFFD, one for each maximal subpart of
+    //  an ill-formed sequence. base() is the position in the bytes.
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator>
+    class utf8_iterator
+      : public boost::iterator_facade<
+            utf8_iterator<Iterator>
+          , ucs4_char const
+          , std::forward_iterator_tag
+          , ucs4_char
+        >
+    {
+    public:
+
+        static ucs4_char const replacement_char = 0xFFFD;
+
+        utf8_iterator()
+          : pos(), last(), value(0), length(0), ascii(0) {}
+
+        utf8_iterator(Iterator pos, Iterator last)
+          : pos(pos), last(last), value(0), length(0), ascii(0)
+        {
+            read();
+        }
+
+        Iterator base() const
+        {
+            return pos;
+        }
+
+    private:
+
+        friend class boost::iterator_core_access;
+
+        ucs4_char dereference() const
+        {
+            return value;
+        }
+
+        bool equal(utf8_iterator const& x) const
+        {
+            return pos == x.pos;
+        }
+
+        void increment()
+        {
+            if (ascii > 1)
+            {
+                --ascii;
+                value = static_cast<unsigned char>(*++pos);
+                return;
+            }
+            std::advance(pos, length);
+            read();
+        }
+
+        void read()
+        {
+            ascii = 0;
+            if (pos == last)
+                return;
+
+            unsigned char const c = *pos;
+            if (c < 0x80)
+            {
+                value = c;
+                length = 1;
+                ascii = detail::utf8_ascii_run(pos, last);
+                return;
+            }
+
+            // the ranges of the second byte depend on the first one, this
+            // rejects overlong forms, surrogates and code points past
+            // U+10FFFF (see table 3-7 of the Unicode standard)
+            unsigned n;
+            unsigned char lo = 0x80, hi = 0xBF;
+            ucs4_char v;
+            if (c >= 0xC2 && c <= 0xDF)
+            {
+                n = 1;
+                v = c & 0x1F;
+            }
+            else if (c >= 0xE0 && c <= 0xEF)
+            {
+                n = 2;
+                v = c & 0x0F;
+                if (c == 0xE0)
+                    lo = 0xA0;
+                else if (c == 0xED)
+                    hi = 0x9F;
+            }
+            else if (c >= 0xF0 && c <= 0xF4)
+            {
+                n = 3;
+                v = c & 0x07;
+                if (c == 0xF0)
+                    lo = 0x90;
+                else if (c == 0xF4)
+                    hi = 0x8F;
+            }
+            else
+            {
+                value = replacement_char;
+                length = 1;
+                return;
+            }
+
+            value = replacement_char;
+            length = 1;
+            Iterator i = pos;
+            for (++i; n != 0; --n, ++i, ++length)
+            {
+                if (i == last)
+                    return;
+                unsigned char const b = *i;
+                if (b < lo || b > hi)
+                    return;
+                v = (v << 6) | (b & 0x3F);
+                lo = 0x80;
+                hi = 0xBF;
+            }
+            value = v;
+        }
+
+        Iterator pos;
+        Iterator last;
+        ucs4_char value;
+        unsigned char length;       // the bytes of the current code point
+        std::size_t ascii;          // the ASCII bytes from pos on
+    };
+
+    template <typename Iterator>
+    ucs4_char const utf8_iterator<Iterator>::replacement_char;
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Iterator>
+    struct utf8_view
+    {
+        typedef utf8_iterator<Iterator> iterator;
+        typedef iterator const_iterator;
+
+        utf8_view(Iterator first, Iterator last)
+          : first(first), last(last) {}
+
+        iterator begin() const
+        {
+            return iterator(first, last);
+        }
+
+        iterator end() const
+        {
+            return iterator(last, last);
+        }
+
+        Iterator first;
+        Iterator last;
+    };
+
+    template <typename Iterator>
+    inline utf8_view<Iterator> make_utf8_view(Iterator first, Iterator last)
+    {
+        return { first, last };
+    }
+
+    // strings are viewed through pointers, for the fast ASCII scan
+    template <typename Traits, typename Allocator>
+    inline utf8_view<char const*>
+    make_utf8_view(std::basic_string<char, Traits, Allocator> const& str)
+    {
+        return { str.data(), str.data() + str.size() };
+    }
+}}}
+
+#endif
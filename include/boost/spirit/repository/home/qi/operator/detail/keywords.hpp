@@ -13,6 +13,11 @@
 #include <boost/fusion/include/nview.hpp>
 #include <boost/spirit/home/qi/string/lit.hpp>
 #include <boost/fusion/include/at.hpp>
+#include <boost/array.hpp>
+#include <boost/assert.hpp>
+#include <boost/integer.hpp>
+#include <algorithm>
+#include <string>
 namespace boost { namespace spirit { namespace repository { namespace qi { namespace detail {
     // Variant visitor class which handles dispatching the parsing to the selected parser
     // This also handles passing the correct attributes and flags/counters to the subject parsers
@@ -124,6 +129,188 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
             Counters &counters;
             attr_reference attr;
         };
+    // Flat table of the string keywords, sorted by keyword. A lookup
+    // finds the keywords starting with the first input character, directly
+    // for narrow characters and by a binary search otherwise, compares
+    // them with the input and returns the longest match, as the tst lookup
+    // it replaces did. The table holds its N entries in place and keeps
+    // the characters of all the keywords in a single string.
+    template <typename Char, typename T, std::size_t N>
+    struct keyword_table
+    {
+        struct entry
+        {
+            std::size_t offset;
+            std::size_t size;
+            T value;
+        };
+
+        // orders the entries by keyword, the first added keyword first
+        struct entry_less
+        {
+            entry_less(Char const* chars) : chars(chars) {}
+
+            bool operator()(entry const& a, entry const& b) const
+            {
+                if (std::lexicographical_compare(
+                        chars + a.offset, chars + a.offset + a.size
+                      , chars + b.offset, chars + b.offset + b.size))
+                    return true;
+                if (std::lexicographical_compare(
+                        chars + b.offset, chars + b.offset + b.size
+                      , chars + a.offset, chars + a.offset + a.size))
+                    return false;
+                return a.offset < b.offset;
+            }
+
+            Char const* chars;
+        };
+
+        // compares the first character of the entries, the empty
+        // keywords, which are never found, come first
+        struct first_char_less
+        {
+            first_char_less(Char const* chars) : chars(chars) {}
+
+            bool operator()(entry const& e, Char ch) const
+            {
+                return e.size == 0 || chars[e.offset] < ch;
+            }
+
+            Char const* chars;
+        };
+
+        // narrow characters find the entries starting with them directly
+        typedef mpl::bool_<sizeof(Char) == 1> narrow_char;
+        typedef typename boost::uint_value_t<N>::least index_type;
+
+        struct index_range
+        {
+            index_type begin;
+            index_type end;
+        };
+
+        typedef typename mpl::if_<
+            narrow_char
+          , boost::array<index_range, 256>
+          , unused_type
+          >::type first_index_type;
+
+        keyword_table() : size(0) {}
+
+        template <typename Iterator>
+        void add(Iterator first, Iterator last, T const& value)
+        {
+            BOOST_ASSERT(size < N);
+            entry& e = entries[size++];
+            e.offset = chars.size();
+            chars.append(first, last);
+            e.size = chars.size() - e.offset;
+            e.value = value;
+        }
+
+        // to be called once all the keywords are added
+        void sort()
+        {
+            std::sort(entries.begin(), entries.begin() + size
+              , entry_less(chars.data()));
+            index_first(narrow_char());
+        }
+
+        template <typename Iterator, typename Filter>
+        T const* find(Iterator& first, Iterator const& last, Filter filter) const
+        {
+            if (first == last)
+                return 0;
+
+            entry const* lo;
+            entry const* hi;
+            narrow_first(filter(*first), lo, hi, narrow_char());
+
+            // compare the candidates, keeping the longest match
+            entry const* found = 0;
+            Iterator found_end = first;
+            for (; lo != hi; ++lo)
+            {
+                if (found && lo->size <= found->size)
+                    continue;
+
+                Char const* str = chars.data() + lo->offset;
+                Iterator i = first;
+                std::size_t k = 1;
+                for (++i; k != lo->size && i != last; ++k, ++i)
+                {
+                    if (str[k] != Char(filter(*i)))
+                        break;
+                }
+                if (k == lo->size)
+                {
+                    found = lo;
+                    found_end = i;
+                }
+            }
+
+            if (found)
+            {
+                first = found_end;
+                return &found->value;
+            }
+            return 0;
+        }
+
+        void narrow_first(Char ch
+          , entry const*& lo, entry const*& hi, mpl::true_) const
+        {
+            index_range const& r = first_index[static_cast<unsigned char>(ch)];
+            lo = entries.data() + r.begin;
+            hi = entries.data() + r.end;
+        }
+
+        void narrow_first(Char ch
+          , entry const*& lo, entry const*& hi, mpl::false_) const
+        {
+            lo = std::lower_bound(entries.data(), entries.data() + size
+              , ch, first_char_less(chars.data()));
+            hi = lo;
+            while (hi != entries.data() + size && chars[hi->offset] == ch)
+                ++hi;
+        }
+
+        void index_first(mpl::true_)
+        {
+            index_range const empty = {0, 0};
+            first_index.assign(empty);
+            for (std::size_t i = 0; i != size; )
+            {
+                // the entries of an empty keyword are never found
+                if (entries[i].size == 0)
+                {
+                    ++i;
+                    continue;
+                }
+
+                Char const ch = chars[entries[i].offset];
+                index_range& r = first_index[static_cast<unsigned char>(ch)];
+                r.begin = static_cast<index_type>(i);
+                while (i != size && entries[i].size != 0
+                    && chars[entries[i].offset] == ch)
+                {
+                    ++i;
+                }
+                r.end = static_cast<index_type>(i);
+            }
+        }
+
+        void index_first(mpl::false_)
+        {
+        }
+
+        boost::array<entry, N> entries;
+        std::size_t size;
+        std::basic_string<Char> chars;
+        first_index_type first_index;
+    };
+
     // string keyword loop handler
     template <typename Elements, typename StringKeywords, typename IndexList, typename FlagsType, typename Modifiers>
         struct string_keywords
@@ -220,8 +407,12 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                   , char_types >::type
                 >::type  char_type;
 
-            // Our symbols container
-            typedef spirit::qi::tst< char_type, parser_index_type> keywords_type;
+            // Our keywords container
+            typedef keyword_table<
+                char_type
+              , parser_index_type
+              , mpl::size<IndexList>::value
+              > keywords_type;
 
             // Filter functor used for case insensitive parsing
             template <typename CharEncoding>
@@ -355,7 +546,7 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
             {
                 typedef int result_type;
 
-                keyword_entry_adder(shared_ptr<keywords_type> lookup,FlagsType &flags, Elements &elements) :
+                keyword_entry_adder(keywords_type &lookup,FlagsType &flags, Elements &elements) :
                     lookup(lookup)
                     ,flags(flags)
                     ,elements(elements)
@@ -372,7 +563,7 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                     {
 
                         // Make the keyword/parse index entry in the tst parser
-                        lookup->add(
+                        lookup.add(
                                 traits::get_begin<char_type>(get_string(parser.subject.keyword)),
                                 traits::get_end<char_type>(get_string(parser.subject.keyword)),
                                 position
@@ -386,7 +577,7 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                     int call( const T & parser, const Position position) const
                     {
                         // Make the keyword/parse index entry in the tst parser
-                        lookup->add(
+                        lookup.add(
                                 traits::get_begin<char_type>(get_string(parser.keyword)),
                                 traits::get_end<char_type>(get_string(parser.keyword)),
                                 position
@@ -400,7 +591,7 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                     int call( const spirit::qi::hold_directive<T> & parser, const Position position) const
                     {
                         // Make the keyword/parse index entry in the tst parser
-                        lookup->add(
+                        lookup.add(
                                 traits::get_begin<char_type>(get_string(parser.subject.keyword)),
                                 traits::get_end<char_type>(get_string(parser.subject.keyword)),
                                 position
@@ -426,18 +617,18 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
    
 
 
-                shared_ptr<keywords_type> lookup;
+                keywords_type &lookup;
                 FlagsType & flags;
                 Elements &elements;
             };
 
-            string_keywords(Elements &elements,FlagsType &flags_init) : lookup(new keywords_type())
+            string_keywords(Elements &elements,FlagsType &flags_init)
             {
-                // Loop through all the subject parsers to build the keyword parser symbol parser
+                // Loop through all the subject parsers to build the keyword table
                 IndexList indexes;
                 keyword_entry_adder f1(lookup,flags_init,elements);
                 fusion::for_each(indexes,f1);
-
+                lookup.sort();
             }
             template <typename Iterator,typename ParseVisitor, typename Skipper>
                 bool parse(
@@ -446,8 +637,8 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                         const ParseVisitor &parse_visitor,
                         const Skipper &/*skipper*/) const
                 {
-                    if(parser_index_type* val_ptr =
-                            lookup->find(first,last,first_pass_filter_type()))
+                    if(parser_index_type const* val_ptr =
+                            lookup.find(first,last,first_pass_filter_type()))
                     {                        
                         if(!apply_visitor(parse_visitor,*val_ptr)){
                             return false;
@@ -466,8 +657,8 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                         const Skipper &/*skipper*/) const
                 {
                     Iterator saved_first = first;
-                    if(parser_index_type* val_ptr =
-                            lookup->find(first,last,first_pass_filter_type()))
+                    if(parser_index_type const* val_ptr =
+                            lookup.find(first,last,first_pass_filter_type()))
                     {
                         if(!apply_visitor(parse_visitor,*val_ptr)){
                             return false;
@@ -475,8 +666,8 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
             return true;
                     }
                     // Second pass case insensitive
-                    else if(parser_index_type* val_ptr
-                            = lookup->find(saved_first,last,nc_filter()))
+                    else if(parser_index_type const* val_ptr
+                            = lookup.find(saved_first,last,nc_filter()))
                     {
                         first = saved_first;
                         if(!apply_visitor(no_case_parse_visitor,*val_ptr)){
@@ -486,7 +677,7 @@ namespace boost { namespace spirit { namespace repository { namespace qi { names
                     }
                     return false;
                 }
-            shared_ptr<keywords_type> lookup;
+            keywords_type lookup;
 
 
         };
@@ -257,6 +257,19 @@ main()
 
     }
 
+    { // keywords sharing a prefix, the longest one is matched
+        BOOST_TEST(test("ab=1 a=2 abc=3 b=4", kwd("a")['=' > int_] / kwd("ab")['=' > int_] / kwd("abc")['=' > int_] / kwd("b")['=' > int_], space));
+        BOOST_TEST(test("abc=3 ab=1", kwd("abc")['=' > int_] / kwd("ab")['=' > int_] / kwd("a",0,1)['=' > int_], space));
+        BOOST_TEST(!test("abd=3", kwd("abc")['=' > int_] / kwd("ab")['=' > int_], space));
+        BOOST_TEST(test("aB=1 A=2 Abc=3", ikwd("a")['=' > int_] / ikwd("ab")['=' > int_] / ikwd("abc")['=' > int_], space));
+
+        boost::fusion::vector<int,int,int> data;
+        BOOST_TEST(test_attr("abc=3 a=1 ab=2", kwd("a")['=' > int_] / kwd("ab")['=' > int_] / kwd("abc")['=' > int_], data, space));
+        BOOST_TEST(boost::fusion::at_c<0>(data) == 1);
+        BOOST_TEST(boost::fusion::at_c<1>(data) == 2);
+        BOOST_TEST(boost::fusion::at_c<2>(data) == 3);
+    }
+
     { // attribute customization
 
 //        x_attr x;
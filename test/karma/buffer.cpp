@@ -11,8 +11,13 @@
 #include <boost/spirit/include/karma_operator.hpp>
 #include <boost/spirit/include/karma_directive.hpp>
 #include <boost/spirit/include/karma_char.hpp>
+#include <boost/spirit/include/karma_string.hpp>
+
+#include <boost/type_traits/is_same.hpp>
 
 #include <iostream>
+#include <sstream>
+#include <iomanip>
 #include "test.hpp"
 
 int
@@ -49,5 +54,38 @@ main()
             buffer['[' << +double_ << ']'], v, space));
     }
 
+    {
+        using boost::spirit::karma::detail::buffer_char_type;
+
+        // narrow sinks are buffered as narrow characters
+        BOOST_TEST((boost::is_same<char, buffer_char_type<
+            std::back_insert_iterator<std::string> >::type>::value));
+        BOOST_TEST((boost::is_same<char, buffer_char_type<char*>::type>::value));
+        BOOST_TEST((boost::is_same<wchar_t, buffer_char_type<
+            std::back_insert_iterator<std::wstring> >::type>::value));
+    }
+
+    {
+        using boost::spirit::karma::int_;
+        using boost::spirit::karma::right_align;
+        using boost::spirit::karma::left_align;
+        using boost::spirit::karma::string;
+
+        // each aligned field reuses the buffer of the previous one
+        std::vector<int> v;
+        std::ostringstream expected;
+        for (int i = 0; i != 20; ++i)
+        {
+            v.push_back(i * 1111);
+            expected << std::setw(6) << i * 1111 << '|';
+        }
+        BOOST_TEST(test(expected.str(), *(right_align(6)[int_] << '|'), v));
+
+        // nested buffers longer than any small string buffer
+        std::string s(50, 'x');
+        BOOST_TEST(test(std::string(10, ' ') + s + std::string(10, '-')
+          , left_align(70, '-')[right_align(60)[buffer[string]]], s));
+    }
+
     return boost::report_errors();
 }
@@ -22,6 +22,8 @@
 #include <boost/limits.hpp>
 #include "test.hpp"
 
+#include <cstdio>
+
 using namespace spirit_test;
 
 
@@ -159,6 +161,41 @@ main()
         BOOST_TEST(test_delimited("ff ", lower[lower[hex]], 0xff, char_(' ')));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    //  all decimal lengths, also through the buffering and counting of the
+    //  alignment directives
+    {
+        using namespace boost::spirit::ascii;
+        using boost::spirit::karma::right_align;
+
+        boost::ulong_long_type n = 1;
+        for (int i = 1; i <= 20; ++i, n *= 10)
+        {
+            char expected[32], padded[32];
+            boost::ulong_long_type const values[] = { n, n - 1, n + n / 3 };
+            for (int j = 0; j != 3; ++j)
+            {
+                sprintf(expected, "%llu", values[j]);
+                sprintf(padded, "%24llu", values[j]);
+                BOOST_TEST(test(expected, ulong_long, values[j]));
+                BOOST_TEST(test(padded, right_align(24)[ulong_long], values[j]));
+            }
+        }
+
+        BOOST_TEST(test("18446744073709551615", ulong_long
+          , (std::numeric_limits<boost::ulong_long_type>::max)()));
+        BOOST_TEST(test("-9223372036854775808", long_long
+          , (std::numeric_limits<boost::long_long_type>::min)()));
+        BOOST_TEST(test("4294967295", uint_
+          , (std::numeric_limits<unsigned>::max)()));
+        BOOST_TEST(test("-2147483648", int_
+          , (std::numeric_limits<int>::min)()));
+        BOOST_TEST(test("-32768", short_
+          , (std::numeric_limits<short>::min)()));
+        BOOST_TEST(test_delimited("65535 ", ushort_
+          , (std::numeric_limits<unsigned short>::max)(), char_(' ')));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     {
         using boost::spirit::karma::int_;
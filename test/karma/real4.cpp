@@ -0,0 +1,191 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "real.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+//  shortest_real_policies variants of the policies in real.hpp
+template <typename T>
+struct shortest_scientific_policy : boost::spirit::karma::shortest_real_policies<T>
+{
+    typedef boost::spirit::karma::real_policies<T> base_type;
+    static int floatfield(T) { return base_type::fmtflags::scientific; }
+};
+
+template <typename T>
+struct shortest_fixed_policy : boost::spirit::karma::shortest_real_policies<T>
+{
+    typedef boost::spirit::karma::real_policies<T> base_type;
+    static int floatfield(T) { return base_type::fmtflags::fixed; }
+};
+
+template <typename T>
+struct shortest_signed_policy : boost::spirit::karma::shortest_real_policies<T>
+{
+    static bool force_sign(T) { return true; }
+};
+
+// marks a zero fractional part with a different dot
+template <typename T>
+struct shortest_dot_policy : boost::spirit::karma::shortest_real_policies<T>
+{
+    template <typename OutputIterator>
+    static bool dot(OutputIterator& sink, T n, unsigned)
+    {
+        return boost::spirit::karma::char_inserter<>::call(
+            sink, n == 0 ? ':' : '.');
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//  the generated string must read back as exactly the same value
+inline double read_back(std::string const& s, double)
+{
+    return std::strtod(s.c_str(), 0);
+}
+
+inline float read_back(std::string const& s, float)
+{
+    return std::strtof(s.c_str(), 0);
+}
+
+template <typename T, typename Generator>
+bool roundtrip(Generator const& g, T n)
+{
+    std::string s;
+    std::back_insert_iterator<std::string> sink(s);
+    if (!boost::spirit::karma::generate(sink, g, n))
+        return false;
+    return read_back(s, n) == n && (n != 0 || s == "0.0");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    using namespace boost::spirit;
+    using boost::spirit::ascii::upper;
+
+    typedef karma::real_generator<double, karma::shortest_real_policies<double> >
+        shortest_type;
+    shortest_type const shortest = shortest_type();
+
+    {
+        // same format as the default real_policies, but all digits
+        BOOST_TEST(test("0.0", shortest, 0.0));
+        BOOST_TEST(test("0.0", shortest, -0.0));
+        BOOST_TEST(test("1.0", shortest, 1.0));
+        BOOST_TEST(test("1.0001", shortest, 1.0001));
+        BOOST_TEST(test("0.1", shortest, 0.1));
+        BOOST_TEST(test("0.3", shortest, 0.3));
+        BOOST_TEST(test("0.30000000000000004", shortest, 0.1 + 0.2));
+        BOOST_TEST(test("1.0000000000000002", shortest, 1.0000000000000002));
+        BOOST_TEST(test("1.2345e-04", shortest, 0.00012345));
+        BOOST_TEST(test("0.0012345", shortest, 0.0012345));
+        BOOST_TEST(test("12342.0", shortest, 12342.));
+        BOOST_TEST(test("99999.0", shortest, 99999.));
+        BOOST_TEST(test("1.2342e05", shortest, 123420.));
+        BOOST_TEST(test("1.0e23", shortest, 1e23));
+        BOOST_TEST(test("1.7976931348623157e308", shortest, 1.7976931348623157e308));
+        BOOST_TEST(test("2.2250738585072014e-308", shortest, 2.2250738585072014e-308));
+        BOOST_TEST(test("5.0e-324", shortest, 4.9406564584124654e-324));
+        BOOST_TEST(test("-1.5", shortest, -1.5));
+        BOOST_TEST(test("-1.2342e-10", shortest, -1.2342e-10));
+
+        BOOST_TEST(test("nan", shortest, std::numeric_limits<double>::quiet_NaN()));
+        BOOST_TEST(test("-inf", shortest, -std::numeric_limits<double>::infinity()));
+        BOOST_TEST(test("INF", upper[shortest], std::numeric_limits<double>::infinity()));
+        BOOST_TEST(test("1.5E10", upper[shortest], 1.5e10));
+    }
+
+    {
+        typedef karma::real_generator<double, shortest_fixed_policy<double> >
+            fixed_type;
+        fixed_type const fixed = fixed_type();
+
+        BOOST_TEST(test("0.0", fixed, 0.0));
+        BOOST_TEST(test("0.000012345", fixed, 0.000012345));
+        BOOST_TEST(test("123.45", fixed, 123.45));
+        BOOST_TEST(test("123420000000000000000.0", fixed, 1.23420e20));
+        BOOST_TEST(test("100000000000000000000000.0", fixed, 1e23));
+        BOOST_TEST(test("-0.5", fixed, -0.5));
+
+        typedef karma::real_generator<double, shortest_scientific_policy<double> >
+            science_type;
+        science_type const science = science_type();
+
+        BOOST_TEST(test("0.0e00", science, 0.0));
+        BOOST_TEST(test("1.0e00", science, 1.0));
+        BOOST_TEST(test("1.2345e02", science, 123.45));
+        BOOST_TEST(test("-1.2345e-05", science, -0.000012345));
+
+        typedef karma::real_generator<double, shortest_signed_policy<double> >
+            signed_type;
+        signed_type const signed_ = signed_type();
+
+        BOOST_TEST(test("0.0", signed_, 0.0));
+        BOOST_TEST(test("+0.25", signed_, 0.25));
+        BOOST_TEST(test("-0.25", signed_, -0.25));
+        BOOST_TEST(test("+1.25e10", signed_, 1.25e10));
+
+        // the dot gets the fractional digits
+        typedef karma::real_generator<double, shortest_dot_policy<double> >
+            dot_type;
+        dot_type const dot = dot_type();
+
+        BOOST_TEST(test("1:0", dot, 1.0));
+        BOOST_TEST(test("12342:0", dot, 12342.));
+        BOOST_TEST(test("0.5", dot, 0.5));
+        BOOST_TEST(test("1:0e10", dot, 1e10));
+        BOOST_TEST(test("1.25e10", dot, 1.25e10));
+    }
+
+    {
+        typedef karma::real_generator<float, karma::shortest_real_policies<float> >
+            shortest_float_type;
+        shortest_float_type const shortest_float = shortest_float_type();
+
+        BOOST_TEST(test("0.1", shortest_float, 0.1f));
+        BOOST_TEST(test("1.6777216e07", shortest_float, 16777216.0f));
+        BOOST_TEST(test("3.4028235e38", shortest_float, 3.4028235e38f));
+        BOOST_TEST(test("1.0e-45", shortest_float, 1e-45f));
+
+        // other types fall back to the precision based conversion
+        typedef karma::real_generator<long double
+          , karma::shortest_real_policies<long double> > shortest_long_type;
+        BOOST_TEST(test("1.5", shortest_long_type(), 1.5L));
+    }
+
+    {
+        // round trip of pseudo-random values
+        typedef karma::real_generator<float, karma::shortest_real_policies<float> >
+            shortest_float_type;
+
+        boost::uint64_t state = 0x9e3779b97f4a7c15ull;
+        for (int i = 0; i != 20000; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            double d;
+            std::memcpy(&d, &state, sizeof(d));
+            if (!boost::math::isnan(d) && !boost::math::isinf(d))
+                BOOST_TEST(roundtrip(shortest, d));
+
+            float f;
+            boost::uint32_t const bits = boost::uint32_t(state >> 32);
+            std::memcpy(&f, &bits, sizeof(f));
+            if (!boost::math::isnan(f) && !boost::math::isinf(f))
+                BOOST_TEST(roundtrip(shortest_float_type(), f));
+        }
+    }
+
+    return boost::report_errors();
+}
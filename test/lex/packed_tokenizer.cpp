@@ -0,0 +1,186 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/spirit/home/lex/lexer/lexertl/iterator_tokenizer.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/packed_iterator_tokenizer.hpp>
+#include <boost/spirit/home/support/detail/lexer/generator.hpp>
+#include <boost/spirit/home/support/detail/lexer/rules.hpp>
+#include <boost/spirit/home/support/detail/lexer/state_machine.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex::lexertl;
+
+typedef boost::lexer::basic_rules<char> rules_type;
+typedef boost::lexer::basic_state_machine<char> state_machine_type;
+typedef boost::lexer::basic_generator<char> generator_type;
+
+struct token
+{
+    std::size_t id;
+    std::size_t unique_id;
+    std::size_t state;
+    std::size_t end;
+
+    bool operator==(token const& rhs) const
+    {
+        return id == rhs.id && unique_id == rhs.unique_id &&
+            state == rhs.state && end == rhs.end;
+    }
+};
+
+template <typename Tokeniser, typename StateMachine>
+std::vector<token> tokenize(StateMachine const& sm, char const* input
+  , bool multi_state)
+{
+    std::vector<token> result;
+    char const* first = input;
+    char const* last = input + std::strlen(input);
+    std::size_t state = 0;
+    bool bol = true;
+
+    while (true)
+    {
+        token t;
+        t.id = multi_state ?
+            Tokeniser::next(sm, state, bol, first, last, t.unique_id) :
+            Tokeniser::next(sm, bol, first, last, t.unique_id);
+        t.state = state;
+        t.end = first - input;
+        result.push_back(t);
+
+        if (t.id == 0 || t.id == boost::lexer::npos)
+            break;
+    }
+    return result;
+}
+
+template <typename Index>
+bool compare(state_machine_type const& sm, char const* input, bool multi_state)
+{
+    typedef lex::basic_iterator_tokeniser<char const*> tokeniser;
+    typedef lex::basic_packed_iterator_tokeniser<char const*, Index>
+        packed_tokeniser;
+
+    lex::basic_packed_state_machine<char, Index> packed(sm);
+
+    return tokenize<tokeniser>(sm, input, multi_state) ==
+        tokenize<packed_tokeniser>(packed, input, multi_state);
+}
+
+bool compare_all(state_machine_type const& sm, char const* input
+  , bool multi_state)
+{
+    return compare<boost::uint16_t>(sm, input, multi_state) &&
+        compare<boost::uint32_t>(sm, input, multi_state);
+}
+
+int main()
+{
+    {
+        // single state, no assertions
+        rules_type rules;
+        rules.add("[a-zA-Z_][a-zA-Z0-9_]*", 1);
+        rules.add("[0-9]+", 2);
+        rules.add("[0-9]+\\.[0-9]*", 3);
+        rules.add("\\s+", 4);
+        rules.add("\\\"([^\\\"\\\\]|\\\\.)*\\\"", 5);
+        rules.add("if", 6);
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+
+        char const* input = "if iff x_1 = 42 + 3.14 \"a \\\"b\\\"\"\n\t 7.";
+        BOOST_TEST(compare_all(sm, input, false));
+        BOOST_TEST(compare_all(sm, "1 2 3 ?", false));
+        BOOST_TEST(tokenize<lex::basic_packed_iterator_tokeniser<char const*> >(
+            lex::packed_state_machine(sm), "1 2 3 ?", false).size() == 7);
+        BOOST_TEST(compare_all(sm, "\"unterminated", false));
+        BOOST_TEST(compare_all(sm, "", false));
+
+        generator_type::minimise(sm);
+        BOOST_TEST(compare_all(sm, input, false));
+    }
+
+    {
+        // every byte value in a class of its own
+        rules_type rules;
+        for (int c = 1; c != 256; ++c)
+        {
+            char const s[] = { '\\', 'x', "0123456789abcdef"[c / 16]
+              , "0123456789abcdef"[c % 16], '\0' };
+            rules.add(s, c);
+        }
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+
+        char input[256];
+        for (int c = 1; c != 256; ++c)
+            input[c - 1] = static_cast<char>(c);
+        input[255] = '\0';
+
+        // 256 rows of 258 entries need 32 bit offsets
+        BOOST_TEST(compare<boost::uint32_t>(sm, input, false));
+    }
+
+    {
+        // beginning and end of line assertions
+        rules_type rules;
+        rules.add("^#[^\\n]*", 1);
+        rules.add("[a-z]+$", 2);
+        rules.add("[a-z]+", 3);
+        rules.add("[ \\n#]", 4);
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+
+        char const* input = "#pragma\nabc def\n  # no\nxyz\n#last\nend";
+        BOOST_TEST(compare_all(sm, input, false));
+        BOOST_TEST(compare_all(sm, input, true));
+    }
+
+    {
+        // multiple lexer states, including a rule without an id
+        rules_type rules;
+        rules.add_state("COMMENT");
+        rules.add("INITIAL", "[a-z]+", 1, ".");
+        rules.add("INITIAL", "\\s+", 2, ".");
+        rules.add("INITIAL", "\\/\\*", "COMMENT");
+        rules.add("COMMENT", "[^*]+|\\*", 3, ".");
+        rules.add("COMMENT", "\\*\\/", 4, "INITIAL");
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+
+        char const* input = "abc /* x * y */ def/**/g /* open";
+        BOOST_TEST(compare_all(sm, input, true));
+    }
+
+    {
+        // tables which do not fit into the index type are rejected
+        rules_type rules;
+        rules.add("[a-z]{60}", 1);
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+
+        bool caught = false;
+        try
+        {
+            lex::basic_packed_state_machine<char, boost::uint8_t> packed(sm);
+        }
+        catch (boost::lexer::runtime_error const&)
+        {
+            caught = true;
+        }
+        BOOST_TEST(caught);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,136 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/spirit/home/support/detail/lexer/generator.hpp>
+#include <boost/spirit/home/support/detail/lexer/rules.hpp>
+#include <boost/spirit/home/support/detail/lexer/runtime_error.hpp>
+#include <boost/spirit/home/support/detail/lexer/state_machine.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+
+typedef boost::lexer::basic_rules<char> rules_type;
+typedef boost::lexer::basic_state_machine<char> state_machine_type;
+typedef boost::lexer::basic_generator<char> generator_type;
+
+// states S0 .. Sn, each with its own keywords and a few shared rules
+void add_rules(rules_type& rules, std::size_t states)
+{
+    rules.add_macro("IDENT", "[a-zA-Z_][a-zA-Z0-9_]*");
+    for (std::size_t i = 0; i != states; ++i)
+    {
+        std::ostringstream name;
+        name << 'S' << i;
+        rules.add_state(name.str().c_str());
+    }
+    for (std::size_t i = 0; i != states; ++i)
+    {
+        std::ostringstream name, next, keyword;
+        name << 'S' << i;
+        next << 'S' << (i + 1) % states;
+        keyword << "kw" << i << "_[a-f]{" << i % 4 + 1 << "}";
+
+        std::string const state = name.str();
+        rules.add(state.c_str(), keyword.str(), 100 + i, ".");
+        rules.add(state.c_str(), "{IDENT}", 1, ".");
+        rules.add(state.c_str(), "[0-9]+(\\.[0-9]*)?", 2, ".");
+        rules.add(state.c_str(), "\\s+", 3, ".");
+        rules.add(state.c_str(), "@", 4, next.str().c_str());
+        if (i % 3 == 0)
+            rules.add(state.c_str(), "^#[^\\n]*", 5, ".");
+        if (i % 5 == 0)
+            rules.add(state.c_str(), "[;]$", 6, ".");
+    }
+}
+
+void check_identical(rules_type const& rules)
+{
+    state_machine_type serial;
+    generator_type::build(rules, serial);
+
+    for (std::size_t threads = 0; threads != 6; ++threads)
+    {
+        state_machine_type parallel;
+        generator_type::build_parallel(rules, parallel, false, threads);
+        BOOST_TEST(parallel == serial);
+        BOOST_TEST(parallel.data()._seen_BOL_assertion ==
+            serial.data()._seen_BOL_assertion);
+        BOOST_TEST(parallel.data()._seen_EOL_assertion ==
+            serial.data()._seen_EOL_assertion);
+    }
+
+    state_machine_type minimised;
+    generator_type::build(rules, minimised);
+    generator_type::minimise(minimised);
+
+    for (std::size_t threads = 0; threads != 6; ++threads)
+    {
+        state_machine_type parallel;
+        generator_type::build_parallel(rules, parallel, true, threads);
+        BOOST_TEST(parallel == minimised);
+    }
+}
+
+int main()
+{
+    {
+        // many states
+        rules_type rules;
+        add_rules(rules, 24);
+        check_identical(rules);
+    }
+
+    {
+        // a single state, and states without rules
+        rules_type rules;
+        add_rules(rules, 1);
+        check_identical(rules);
+
+        rules.add_state("EMPTY1");
+        rules.add_state("EMPTY2");
+        check_identical(rules);
+    }
+
+    {
+        // assertions seen in one state only
+        rules_type rules;
+        rules.add_state("OTHER");
+        rules.add("INITIAL", "[a-z]+", 1, ".");
+        rules.add("OTHER", "^[a-z]+$", 2, ".");
+        check_identical(rules);
+    }
+
+    {
+        // the error of the first broken state is reported
+        rules_type rules;
+        add_rules(rules, 8);
+        rules.add("S2", "(", 7, ".");
+        rules.add("S6", "[", 8, ".");
+
+        std::string serial, parallel;
+        try
+        {
+            state_machine_type sm;
+            generator_type::build(rules, sm);
+        }
+        catch (boost::lexer::runtime_error const& e)
+        {
+            serial = e.what();
+        }
+        try
+        {
+            state_machine_type sm;
+            generator_type::build_parallel(rules, sm, false, 4);
+        }
+        catch (boost::lexer::runtime_error const& e)
+        {
+            parallel = e.what();
+        }
+        BOOST_TEST(!serial.empty());
+        BOOST_TEST(parallel == serial);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,238 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/iterator_tokenizer.hpp>
+#include <boost/spirit/home/support/detail/lexer/generator.hpp>
+#include <boost/spirit/home/support/detail/lexer/rules.hpp>
+#include <boost/spirit/home/support/detail/lexer/serialise.hpp>
+#include <boost/spirit/home/support/detail/lexer/state_machine.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lex = boost::spirit::lex;
+
+typedef boost::lexer::basic_rules<char> rules_type;
+typedef boost::lexer::basic_state_machine<char> state_machine_type;
+typedef boost::lexer::basic_generator<char> generator_type;
+
+std::vector<std::size_t> tokenize(state_machine_type const& sm
+  , char const* input)
+{
+    typedef lex::lexertl::basic_iterator_tokeniser<char const*> tokeniser;
+
+    std::vector<std::size_t> result;
+    char const* first = input;
+    char const* last = input + std::strlen(input);
+    std::size_t state = 0;
+    bool bol = true;
+
+    while (true)
+    {
+        std::size_t unique_id = 0;
+        std::size_t id = tokeniser::next(sm, state, bol, first, last, unique_id);
+        result.push_back(id);
+        result.push_back(unique_id);
+        result.push_back(state);
+        result.push_back(first - input);
+
+        if (id == 0 || id == boost::lexer::npos)
+            break;
+    }
+    return result;
+}
+
+void add_rules(rules_type& rules)
+{
+    rules.add_state("COMMENT");
+    rules.add_macro("IDENT", "[a-zA-Z_][a-zA-Z0-9_]*");
+    rules.add("INITIAL", "{IDENT}", 1, ".");
+    rules.add("INITIAL", "^#[^\\n]*", 2, ".");
+    rules.add("INITIAL", "[0-9]+$", 3, ".");
+    rules.add("INITIAL", "[0-9]+", 4, ".");
+    rules.add("INITIAL", "\\s+", 5, ".");
+    rules.add("INITIAL", "\\/\\*", "COMMENT");
+    rules.add("COMMENT", "[^*]+|\\*", 6, ".");
+    rules.add("COMMENT", "\\*\\/", 7, "INITIAL");
+}
+
+std::string save(state_machine_type const& sm, rules_type const& rules)
+{
+    std::ostringstream os;
+    boost::lexer::save_binary(sm, boost::lexer::hash_rules(rules), os);
+    return os.str();
+}
+
+// overwrites the entry at index of the tables in image
+void corrupt(std::string& image, std::size_t index, std::size_t value)
+{
+    std::size_t const dfas = 2;
+    std::size_t const tables = sizeof(boost::lexer::detail::binary_header)
+      + dfas * 3 * sizeof(boost::uint64_t);
+    std::memcpy(&image[tables + index * sizeof(std::size_t)], &value
+      , sizeof(std::size_t));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Lexer>
+struct word_count_tokens : lex::lexer<Lexer>
+{
+    word_count_tokens()
+    {
+        this->self.add
+            ("[a-z]+", 1)
+            ("[0-9]+", 2)
+            ("[ \\t\\n]+", 3)
+        ;
+    }
+};
+
+int main()
+{
+    char const* input = "#if x_1\n42 abc /* a * b */ 7\n# 1";
+
+    {
+        // an image loads back into an identical state machine
+        rules_type rules;
+        add_rules(rules);
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+
+        std::string const image = save(sm, rules);
+        BOOST_TEST(image.size() % 8 == 0);
+
+        state_machine_type loaded;
+        BOOST_TEST(boost::lexer::load_binary(image.data(), image.size()
+          , boost::lexer::hash_rules(rules), loaded));
+        BOOST_TEST(loaded == sm);
+        BOOST_TEST(tokenize(loaded, input) == tokenize(sm, input));
+
+        // and so does the image of a minimised one
+        generator_type::minimise(sm);
+        std::string const minimised = save(sm, rules);
+        BOOST_TEST(boost::lexer::load_binary(minimised.data()
+          , minimised.size(), boost::lexer::hash_rules(rules), loaded));
+        BOOST_TEST(loaded == sm);
+        BOOST_TEST(tokenize(loaded, input) == tokenize(sm, input));
+    }
+
+    {
+        // images of other rules and damaged images are rejected
+        rules_type rules;
+        add_rules(rules);
+
+        state_machine_type sm;
+        generator_type::build(rules, sm);
+        std::string const image = save(sm, rules);
+        boost::uint64_t const hash = boost::lexer::hash_rules(rules);
+
+        rules_type other;
+        add_rules(other);
+        other.add("INITIAL", "@", 8, ".");
+        BOOST_TEST(boost::lexer::hash_rules(other) != hash);
+
+        rules_type same;
+        add_rules(same);
+        BOOST_TEST(boost::lexer::hash_rules(same) == hash);
+
+        state_machine_type loaded;
+        BOOST_TEST(!boost::lexer::load_binary(image.data(), image.size()
+          , boost::lexer::hash_rules(other), loaded));
+        BOOST_TEST(loaded.empty());
+
+        BOOST_TEST(!boost::lexer::load_binary(image.data(), image.size() - 8
+          , hash, loaded));
+        BOOST_TEST(!boost::lexer::load_binary(image.data(), 16, hash, loaded));
+
+        std::string damaged(image);
+        damaged[0] = 'X';
+        BOOST_TEST(!boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+
+        // a table size pointing past the end of the image
+        damaged = image;
+        damaged[sizeof(boost::lexer::detail::binary_header) + 7] = '\x7f';
+        BOOST_TEST(!boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+        BOOST_TEST(loaded.empty());
+
+        // an alphabet smaller than the fixed columns of a row
+        damaged = image;
+        damaged[sizeof(boost::lexer::detail::binary_header) + 8] = '\x01';
+        std::memset(&damaged[sizeof(boost::lexer::detail::binary_header) + 9]
+          , 0, 7);
+        BOOST_TEST(!boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+
+        // a character mapped past the last column of the DFA
+        damaged = image;
+        corrupt(damaged, 'a', sm.data()._dfa_alphabet[0]);
+        BOOST_TEST(!boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+
+        // a transition to a row past the end of the DFA
+        std::size_t const rows = sm.data()._dfa[0]->size()
+          / sm.data()._dfa_alphabet[0];
+        damaged = image;
+        corrupt(damaged, boost::lexer::num_chars + sm.data()._dfa_alphabet[0]
+          + boost::lexer::dfa_offset, rows);
+        BOOST_TEST(!boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+
+        // a switch to a lex state that does not exist
+        damaged = image;
+        corrupt(damaged, boost::lexer::num_chars + sm.data()._dfa_alphabet[0]
+          + boost::lexer::state_index, 2);
+        BOOST_TEST(!boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+        BOOST_TEST(loaded.empty());
+
+        // while valid entries are accepted
+        damaged = image;
+        corrupt(damaged, boost::lexer::num_chars + sm.data()._dfa_alphabet[0]
+          + boost::lexer::dfa_offset, rows - 1);
+        BOOST_TEST(boost::lexer::load_binary(damaged.data(), damaged.size()
+          , hash, loaded));
+    }
+
+    {
+        // the lexer saves its DFA and a second instance picks it up
+        typedef lex::lexertl::token<char const*> token_type;
+        typedef lex::lexertl::lexer<token_type> lexer_type;
+
+        word_count_tokens<lexer_type> first_lexer;
+        std::ostringstream os;
+        BOOST_TEST(first_lexer.save_dfa(os));
+        std::string const image = os.str();
+
+        word_count_tokens<lexer_type> second_lexer;
+        BOOST_TEST(second_lexer.load_dfa(image.data(), image.size()));
+
+        char const* text = "abc 42\tdef\n";
+        char const* first = text;
+        char const* last = text + std::strlen(text);
+        std::vector<std::size_t> ids;
+        for (lexer_type::iterator_type it = second_lexer.begin(first, last)
+              , end = second_lexer.end(); it != end && token_is_valid(*it); ++it)
+        {
+            ids.push_back(it->id());
+        }
+
+        std::size_t const expected[] = { 1, 3, 2, 3, 1, 3 };
+        BOOST_TEST(ids == std::vector<std::size_t>(expected, expected + 6));
+        BOOST_TEST(first == last);
+
+        // an image of another lexer is not used
+        word_count_tokens<lexer_type> third_lexer;
+        third_lexer.self.add("[A-Z]+", 4);
+        BOOST_TEST(!third_lexer.load_dfa(image.data(), image.size()));
+    }
+
+    return boost::report_errors();
+}
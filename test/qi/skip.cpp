@@ -11,6 +11,7 @@
 #include <boost/spirit/include/phoenix_core.hpp>
 
 #include <iostream>
+#include <string>
 #include "test.hpp"
 
 int
@@ -51,5 +52,23 @@ main()
         BOOST_TEST((test("a b c d", skip(val(space))[*char_])));
     }
 
+    { // long white space runs on contiguous input (vectorized skipping)
+        std::string ws(" \t\n\v\f\r");
+        for (int i = 0; i != 6; ++i)
+            ws += ws;
+        std::string in = "a" + ws + "b" + ws.substr(0, 17) + "c" + ws;
+        BOOST_TEST((test(in.c_str(), lit('a') >> 'b' >> 'c', space)));
+        BOOST_TEST((test(in.c_str(), lit('a') >> 'b' >> 'c', boost::spirit::standard::space)));
+        BOOST_TEST(!(test(in.c_str(), lit('a') >> 'c', space)));
+
+        std::string s;
+        BOOST_TEST((test_attr(in.c_str(), *char_, s, space)));
+        BOOST_TEST(s == "abc");
+
+        // non-ASCII white space is still left to the skipper
+        std::string nbsp = "a" + ws.substr(0, 20) + "\xa0" + ws + "b";
+        BOOST_TEST((test(nbsp.c_str(), lit('a') >> 'b', boost::spirit::iso8859_1::space)));
+    }
+
     return boost::report_errors();
 }
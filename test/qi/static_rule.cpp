@@ -0,0 +1,173 @@
+/*=============================================================================
+    Copyright (c) 2001-2011 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/qi_operator.hpp>
+#include <boost/spirit/include/qi_char.hpp>
+#include <boost/spirit/include/qi_string.hpp>
+#include <boost/spirit/include/qi_numeric.hpp>
+#include <boost/spirit/include/qi_auxiliary.hpp>
+#include <boost/spirit/include/qi_directive.hpp>
+#include <boost/spirit/include/qi_nonterminal.hpp>
+#include <boost/spirit/include/qi_static_rule.hpp>
+#include <boost/spirit/include/qi_action.hpp>
+#include <boost/spirit/include/phoenix_core.hpp>
+#include <boost/spirit/include/phoenix_operator.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+// count the heap allocations made while defining and copying rules, the
+// replacements are not inlined so that the compiler does not pair their
+// std::free with the new expressions of the callers
+static std::size_t allocations = 0;
+
+BOOST_NOINLINE void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+BOOST_NOINLINE void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+BOOST_NOINLINE void operator delete(void* p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+BOOST_NOINLINE void operator delete[](void* p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+BOOST_NOINLINE void operator delete(void* p, std::size_t)
+    BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+BOOST_NOINLINE void operator delete[](void* p, std::size_t)
+    BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+#endif
+
+int
+main()
+{
+    using spirit_test::test_attr;
+    using spirit_test::test;
+
+    using namespace boost::spirit::ascii;
+    using namespace boost::spirit::qi::labels;
+    using boost::spirit::qi::rule;
+    using boost::spirit::qi::int_;
+    using boost::spirit::qi::lit;
+#if !defined(BOOST_NO_CXX11_FUNCTION_TEMPLATE_DEFAULT_ARGS)
+    using boost::spirit::qi::make_static_rule;
+#endif
+    using boost::spirit::qi::on_error;
+    using boost::spirit::qi::fail;
+
+    typedef char const* iterator_type;
+
+    { // defining and copying rules does not allocate
+        rule<iterator_type, int()> a, b;
+        rule<iterator_type, std::vector<int>()> c;
+
+        std::size_t const before = allocations;
+        a = int_;
+        b = '(' >> a >> ')' | a;
+        c = b % ',';
+        rule<iterator_type, std::vector<int>()> d(c);
+        d = c;
+        BOOST_TEST_EQ(allocations, before);
+
+        std::vector<int> v;
+        BOOST_TEST(test_attr("1,(2),3", d, v));
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST(!test("1,(2", d));
+    }
+
+    { // parsers too large for the rule keep working from the heap
+        rule<iterator_type> a, r;
+        a = 'a';
+        r = a >> a >> a >> a >> a >> a >> a >> a >> a >> a >> a >> a
+            >> a >> a >> a >> a >> a >> a >> a >> a >> a >> a >> a >> a;
+
+        rule<iterator_type> copy(r);
+        BOOST_TEST(test("aaaaaaaaaaaaaaaaaaaaaaaa", copy));
+        BOOST_TEST(!test("aaaaaaaaaaaaaaaaaaaaaaa", copy));
+    }
+
+    { // the handlers wrap the parser of a rule
+        rule<iterator_type> r;
+        r = lit('a') > 'b';
+
+        int errors = 0;
+        on_error<fail>(r, ++boost::phoenix::ref(errors));
+        BOOST_TEST(test("ab", r));
+        BOOST_TEST(!test("ac", r));
+        BOOST_TEST_EQ(errors, 1);
+    }
+
+#if !defined(BOOST_NO_CXX11_FUNCTION_TEMPLATE_DEFAULT_ARGS) && \
+    !defined(BOOST_NO_CXX11_AUTO_DECLARATIONS)
+    { // static rules
+        auto const number = make_static_rule<iterator_type, int()>(
+            int_ | lit("none")[_val = -1], "number");
+        BOOST_TEST(number.name() == "number");
+
+        int i = 0;
+        BOOST_TEST(test_attr("42", number, i) && i == 42);
+        BOOST_TEST(test_attr("none", number, i) && i == -1);
+        BOOST_TEST(!test("x", number));
+
+        // within rules and other static rules
+        rule<iterator_type, std::vector<int>(), space_type> list;
+        list = '[' >> (number % ',') >> ']';
+
+        std::vector<int> v;
+        BOOST_TEST(test_attr("[ 1, none ,3 ]", list, v, space));
+        BOOST_TEST_EQ(v.size(), 3u);
+
+        auto const pair = make_static_rule<iterator_type
+          , std::vector<int>(), space_type>(number >> ':' >> number);
+        v.clear();
+        BOOST_TEST(test_attr("1 : 2", pair, v, space));
+        BOOST_TEST_EQ(v.size(), 2u);
+
+        // without a skipper, a static rule is an implied lexeme
+        auto const word = make_static_rule<iterator_type, std::string()>(
+            +alpha);
+        std::vector<std::string> words;
+        BOOST_TEST(test_attr(" ab  cd ", *word, words, space));
+        BOOST_TEST_EQ(words.size(), 2u);
+
+        // inherited attributes
+        auto const scaled = make_static_rule<iterator_type, int(int)>(
+            int_[_val = _1 * _r1]);
+        BOOST_TEST(test_attr("7", scaled(3), i) && i == 21);
+
+        // copies refer to themselves
+        auto const copy = number;
+        BOOST_TEST(test_attr("5", copy, i) && i == 5);
+        BOOST_TEST(test_attr("6", copy.alias(), i) && i == 6);
+    }
+#endif
+
+    return boost::report_errors();
+}
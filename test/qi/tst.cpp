@@ -9,6 +9,7 @@
 #include <boost/spirit/home/qi/string/tst_map.hpp>
 
 #include <string>
+#include <vector>
 #include <cctype>
 #include <iostream>
 
@@ -349,6 +350,87 @@ void tests()
     }
 }
 
+struct collect
+{
+    collect(std::vector<int>& values)
+      : values(values) {}
+
+    template <typename String>
+    void operator()(String const&, int data) const
+    {
+        values.push_back(data);
+    }
+
+    std::vector<int>& values;
+};
+
+// keys starting with every kind of character the root table indexes
+void root_tests()
+{
+    using boost::spirit::qi::tst_map;
+
+    {
+        tst_map<char, int> lookup;
+        char const high[] = { '\xe9', 't', '\xe9', 0 };
+        char const low[] = { '\x01', 0 };
+        add(lookup, high, 1);
+        add(lookup, low, 2);
+        add(lookup, "z", 3);
+        docheck(lookup, high, true, 3, 1);
+        docheck(lookup, low, true, 1, 2);
+        docheck(lookup, "zz", true, 1, 3);
+        docheck(lookup, "y", false);
+
+        tst_map<char, int> copy(lookup);
+        remove(lookup, high);
+        docheck(lookup, high, false);
+        docheck(copy, high, true, 3, 1);
+
+        lookup = copy;
+        docheck(lookup, high, true, 3, 1);
+        lookup.clear();
+        docheck(lookup, "z", false);
+        docheck(copy, "z", true, 1, 3);
+    }
+
+    {
+        tst_map<wchar_t, int> lookup;
+        wchar_t const cyrillic[] = { 0x0434, 0x0430, 0 };
+        wchar_t const cjk[] = { 0x4e2d, 0x6587, 0 };
+        wchar_t const neighbour[] = { 0x4e2e, 0 };
+        add(lookup, L"ascii", 1);
+        add(lookup, cyrillic, 2);
+        add(lookup, cjk, 3);
+        docheck(lookup, L"ascii", true, 5, 1);
+        docheck(lookup, cyrillic, true, 2, 2);
+        docheck(lookup, cjk, true, 2, 3);
+        docheck(lookup, neighbour, false);
+
+        // the entries are visited in the order of their first character
+        std::vector<int> values;
+        lookup.for_each(collect(values));
+        BOOST_TEST(values.size() == 3u);
+        BOOST_TEST(values[0] == 1 && values[1] == 2 && values[2] == 3);
+
+        if (sizeof(wchar_t) > 2)
+        {
+            // characters beyond U+10FFFF
+            wchar_t const beyond[] = {
+                static_cast<wchar_t>(0x7fffffff), L'x', 0 };
+            wchar_t const negative[] = { static_cast<wchar_t>(-2), 0 };
+            add(lookup, beyond, 4);
+            add(lookup, negative, 5);
+            docheck(lookup, beyond, true, 2, 4);
+            docheck(lookup, negative, true, 1, 5);
+
+            tst_map<wchar_t, int> copy(lookup);
+            remove(lookup, beyond);
+            docheck(lookup, beyond, false);
+            docheck(copy, beyond, true, 2, 4);
+        }
+    }
+}
+
 int main()
 {
     using boost::spirit::qi::tst;
@@ -356,6 +438,7 @@ int main()
 
     tests<tst<char, int>, tst<wchar_t, int> >();
     tests<tst_map<char, int>, tst_map<wchar_t, int> >();
+    root_tests();
 
     return boost::report_errors();
 }
@@ -0,0 +1,188 @@
+//  Copyright (c) 2001-2011 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/include/support_multi_pass.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace spirit = boost::spirit;
+namespace qi = boost::spirit::qi;
+
+typedef std::istreambuf_iterator<char> base_iterator_type;
+typedef spirit::multi_pass<base_iterator_type
+  , spirit::iterator_policies::default_policy<
+        spirit::iterator_policies::ref_counted
+      , spirit::iterator_policies::no_check
+      , spirit::iterator_policies::buffering_input_iterator
+      , spirit::iterator_policies::split_chunked_queue<4> > >
+iterator_type;
+
+typedef spirit::iterator_policies::split_chunked_queue<4>::chunk<char>
+chunk_type;
+
+// the chunks still in use, from the oldest to the newest
+std::size_t chunks_in_use(iterator_type const& it)
+{
+    std::size_t n = 0;
+    for (chunk_type const* c = it.shared()->first_chunk; c != 0; c = c->next)
+        ++n;
+    return n;
+}
+
+// a storage policy written before the clone() hook, it does not buffer
+struct unbuffered
+{
+    template <typename Value>
+    struct unique
+    {
+        void swap(unique&) {}
+
+        template <typename MultiPass>
+        static void destroy(MultiPass&) {}
+
+        template <typename MultiPass>
+        static typename MultiPass::reference dereference(MultiPass const& mp)
+        {
+            return MultiPass::get_input(mp);
+        }
+
+        template <typename MultiPass>
+        static void increment(MultiPass& mp)
+        {
+            MultiPass::advance_input(mp);
+        }
+
+        template <typename MultiPass>
+        static void clear_queue(MultiPass&) {}
+
+        template <typename MultiPass>
+        static bool is_eof(MultiPass const& mp)
+        {
+            return MultiPass::input_at_eof(mp);
+        }
+
+        template <typename MultiPass>
+        static bool equal_to(MultiPass const& mp, MultiPass const& x)
+        {
+            return mp.shared() == x.shared();
+        }
+
+        template <typename MultiPass>
+        static bool less_than(MultiPass const&, MultiPass const&)
+        {
+            return false;
+        }
+    };
+
+    template <typename Value>
+    struct shared {};
+};
+
+typedef spirit::multi_pass<base_iterator_type
+  , spirit::iterator_policies::default_policy<
+        spirit::iterator_policies::ref_counted
+      , spirit::iterator_policies::no_check
+      , spirit::iterator_policies::buffering_input_iterator
+      , unbuffered> >
+unbuffered_iterator_type;
+
+int main()
+{
+    {   // copies see the same input, across chunk boundaries
+        std::istringstream in("0123456789abcdefghij");
+        iterator_type first(base_iterator_type(in.rdbuf()));
+        iterator_type const last;
+
+        iterator_type saved = first;
+        std::string s1, s2;
+        for (int i = 0; i != 13; ++i, ++first)
+            s1 += *first;
+        for (; saved != last; ++saved)
+            s2 += *saved;
+        BOOST_TEST_EQ(s1, "0123456789abc");
+        BOOST_TEST_EQ(s2, "0123456789abcdefghij");
+
+        for (; first != last; ++first)
+            s1 += *first;
+        BOOST_TEST_EQ(s1, s2);
+    }
+
+    {   // chunks behind the oldest iterator are recycled
+        std::string input;
+        for (int i = 0; i != 10000; ++i)
+            input += "x";
+        std::istringstream in(input);
+        iterator_type first(base_iterator_type(in.rdbuf()));
+        iterator_type const last;
+
+        iterator_type mark = first;
+        std::size_t n = 0, most = 0;
+        for (; first != last; ++first, ++n)
+        {
+            if (n % 10 == 0)
+                mark = first;       // backtracking point, 10 behind at most
+            std::size_t const used = chunks_in_use(first);
+            if (used > most)
+                most = used;
+        }
+        BOOST_TEST_EQ(n, 10000u);
+        BOOST_TEST(most <= 5u);
+    }
+
+    {   // a single iterator does not buffer
+        std::istringstream in("abcdefghijklmnopqrstuvwxyz");
+        iterator_type first(base_iterator_type(in.rdbuf()));
+        iterator_type const last;
+        std::string s;
+        for (; first != last; ++first)
+            s += *first;
+        BOOST_TEST_EQ(s, "abcdefghijklmnopqrstuvwxyz");
+    }
+
+    {   // parsing with backtracking
+        std::istringstream in("1,2,3,4,5,6,7,8,9,10,11,12;");
+        iterator_type first(base_iterator_type(in.rdbuf()));
+        iterator_type const last;
+
+        std::vector<int> v;
+        BOOST_TEST(qi::parse(first, last
+          , *((qi::int_ >> ';') | (qi::int_ >> ',')), v));
+        BOOST_TEST(first == last);
+        BOOST_TEST_EQ(v.size(), 12u);
+        BOOST_TEST_EQ(v.back(), 12);
+    }
+
+    {   // clearing the queue keeps the current position
+        std::istringstream in("abcdefghij");
+        iterator_type first(base_iterator_type(in.rdbuf()));
+        iterator_type saved = first;
+        ++first; ++first; ++first; ++first; ++first;
+        saved = first;
+        first.clear_queue();
+        BOOST_TEST_EQ(*first, 'f');
+        ++first;
+        BOOST_TEST_EQ(*first, 'g');
+    }
+
+    {   // storage policies do not need to implement clone()
+        std::istringstream in("abc");
+        unbuffered_iterator_type first(base_iterator_type(in.rdbuf()));
+        unbuffered_iterator_type const last;
+
+        unbuffered_iterator_type copy = first;
+        std::string s;
+        for (; copy != last; ++copy)
+            s += *copy;
+        BOOST_TEST_EQ(s, "abc");
+        BOOST_TEST(first == last);
+    }
+
+    return boost::report_errors();
+}
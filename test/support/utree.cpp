@@ -16,6 +16,45 @@
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
+#include <new>
+
+// the number of live heap allocations
+static long live_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++live_allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) BOOST_NOEXCEPT
+{
+    if (p)
+        --live_allocations;
+    std::free(p);
+}
+
+void operator delete[](void* p) BOOST_NOEXCEPT
+{
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) BOOST_NOEXCEPT
+{
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) BOOST_NOEXCEPT
+{
+    operator delete(p);
+}
 
 inline bool check(boost::spirit::utree const& val, std::string expected)
 {
@@ -497,5 +536,98 @@ int main()
         }
     }
 
+#if !defined(BOOST_SPIRIT_NO_UTREE_ARENA_SCOPE)
+    {
+        // arena allocated trees
+        using boost::spirit::utree_arena;
+        using boost::spirit::stored_function;
+
+        utree_arena arena(256);
+        utree copy;
+        {
+            utree_arena::scope scope(arena);
+
+            utree val;
+            val.push_back(123);
+            val.push_back("a string too long to be stored in-situ");
+            utree inner;
+            for (int i = 0; i != 100; ++i)
+                inner.push_back(i);
+            val.push_back(inner);
+            val.tag(42);
+            BOOST_TEST(arena.size() != 0);
+
+            val.pop_front();
+            val.push_front(456);
+            val.front().tag(7);
+
+            utree tree;
+            tree.push_back(val);
+            tree.push_back(val);
+            BOOST_TEST_EQ(tree.front(), tree.back());
+            BOOST_TEST_EQ(tree.front().tag(), 42);
+
+            copy = tree;    // still inside the scope: allocated in the arena
+            BOOST_TEST_EQ(copy, tree);
+
+            utree f = stored_function<one_two_three>();
+            copy.front().push_back(f);
+        }
+
+        // a copy made outside of the scope is independent of the arena
+        utree heap_copy = copy;
+        utree::iterator it = copy.begin();
+        copy.erase(it);
+        BOOST_TEST_EQ(copy.size(), 1U);
+        copy.clear();
+
+        BOOST_TEST_EQ(heap_copy.size(), 2U);
+        BOOST_TEST(check(heap_copy.front().front(), "456"));
+        BOOST_TEST_EQ(heap_copy.front().front().tag(), 7);
+        BOOST_TEST(check(heap_copy.front().back().eval(utree()), "123"));
+        BOOST_TEST_EQ(heap_copy.back().size(), 3U);
+
+        arena.release();
+        BOOST_TEST_EQ(arena.size(), 0U);
+        BOOST_TEST(check(get(heap_copy.back(), 1),
+            "\"a string too long to be stored in-situ\""));
+        BOOST_TEST_EQ(get(heap_copy.back(), 2).size(), 100U);
+    }
+
+    {
+        // the elements of arena lists release what they own on the heap
+        using boost::spirit::utree_arena;
+
+        utree_arena arena;
+        long allocated = 0;
+        {
+            utree val;
+            {
+                utree_arena::scope scope(arena);
+                val.push_back(1);
+                val.push_back(2);
+            }
+            allocated = live_allocations;
+
+            val.front() = "a string too long to be stored in-situ";
+            BOOST_TEST(live_allocations > allocated);
+
+            // arena lists cannot grow outside of a scope of the arena
+            bool thrown = false;
+            try
+            {
+                val.push_back(3);
+            }
+            catch (boost::spirit::bad_type_exception const&)
+            {
+                thrown = true;
+            }
+            BOOST_TEST(thrown);
+            BOOST_TEST_EQ(val.size(), 2U);
+        }
+        BOOST_TEST_EQ(live_allocations, allocated);
+    }
+#endif
+
     return boost::report_errors();
 }
@@ -250,5 +250,58 @@ main()
         BOOST_TEST_EQ(st.val, 42);
     }
 
+    { // branches passed over on their first character
+        using boost::spirit::x3::space;
+        using boost::spirit::x3::no_case;
+        using boost::spirit::x3::no_skip;
+
+        auto keywords = lit("if") | lit("else") | lit("while") | char_('{') | int_;
+        BOOST_TEST((test("  while", keywords, space)));
+        BOOST_TEST((test(" { ", keywords, space)));
+        BOOST_TEST((test(" 42", keywords, space)));
+        BOOST_TEST((!test(" for", keywords, space)));
+        BOOST_TEST((test("ELSE", no_case[lit("if") | lit("else")])));
+        BOOST_TEST((test("", lit("a") | lit("b") | lit(""))));
+
+        // a branch passed over still skips before it fails
+        BOOST_TEST((!test(" b", lit('a') | lit('c') | no_skip[' ' >> lit('b')], space)));
+        BOOST_TEST((test(" b", no_skip[' ' >> lit('b')] | lit('a') | lit('c'), space)));
+
+        typedef boost::variant<undefined, int, char> attr_type;
+        attr_type v;
+        BOOST_TEST((test_attr("x", lit("rock") | lit("roll") | char_('x') | int_, v)));
+        BOOST_TEST(boost::get<char>(v) == 'x');
+        BOOST_TEST((test_attr("12", lit("rock") | (lit("roll") | char_('x')) | int_, v)));
+        BOOST_TEST(boost::get<int>(v) == 12);
+
+        std::string const s = "roll";
+        auto first = s.begin();
+        BOOST_TEST((boost::spirit::x3::parse(first, s.end(), lit("rock") | lit("roll"))));
+        BOOST_TEST(first == s.end());
+
+        // the skipper runs once over the input before the branch tried (and
+        // phrase_parse skips the space after it)
+        int skipped = 0;
+        auto const count = [&](auto&) { ++skipped; };
+        std::string const in = "   b y";
+        auto i = in.begin();
+        BOOST_TEST((boost::spirit::x3::phrase_parse(i, in.end()
+          , lit('a') | lit('c') | lit('b'), space[count])));
+        BOOST_TEST_EQ(skipped, 4);
+
+        skipped = 0;
+        i = in.begin();
+        BOOST_TEST((boost::spirit::x3::phrase_parse(i, in.end()
+          , (lit('a') >> 'x') | (lit('b') >> 'y'), space[count])));
+        BOOST_TEST(i == in.end());
+        BOOST_TEST_EQ(skipped, 4);
+
+        // a sequence tried and failing still restores the input
+        i = in.begin();
+        BOOST_TEST((!boost::spirit::x3::phrase_parse(i, in.end()
+          , (lit('b') >> 'x') | lit('a') | lit('c'), space)));
+        BOOST_TEST(i == in.begin() + 3);
+    }
+
     return boost::report_errors();
 }
@@ -8,6 +8,10 @@
 #include <boost/detail/lightweight_test.hpp>
 #include <boost/spirit/home/x3.hpp>
 #include <boost/spirit/home/x3/support/utility/annotate_on_success.hpp>
+#include <boost/spirit/home/x3/support/utility/line_index.hpp>
+#include <boost/fusion/include/adapt_struct.hpp>
+#include <list>
+#include <vector>
 #include <string>
 #include <sstream>
 
@@ -34,6 +38,21 @@ auto const test_rule_def = x3::lit("foo") > x3::lit("bar") > x3::lit("git");
 
 BOOST_SPIRIT_DEFINE(test_rule);
 
+struct offset_pair : x3::offset_position_tagged
+{
+    int first;
+    int second;
+};
+
+BOOST_FUSION_ADAPT_STRUCT(offset_pair, first, second)
+
+struct offset_pair_class : x3::annotate_on_success {};
+
+x3::rule<offset_pair_class, offset_pair> const offset_pair_rule;
+auto const offset_pair_rule_def = '(' >> x3::int_ >> ',' >> x3::int_ >> ')';
+
+BOOST_SPIRIT_DEFINE(offset_pair_rule);
+
 void test(std::string const& line_break) {
     std::string const input("foo" + line_break + "  foo" + line_break + "git");
     auto const begin = std::begin(input);
@@ -46,12 +65,102 @@ void test(std::string const& line_break) {
     x3::phrase_parse(begin, end, parser, x3::space);
 
     BOOST_TEST_EQ(stream.str(), "In line 2:\nError! Expecting: \"bar\" here:\n  foo\n__^_\n");
+
+    auto const where = error_handler.location_of(begin + 3 + line_break.size() + 2);
+    BOOST_TEST_EQ(where.line, 2u);
+    BOOST_TEST_EQ(where.column, 3u);
+    BOOST_TEST_EQ(error_handler.get_line_index().lines(), 3u);
+}
+
+void test_offset_position_cache()
+{
+    static_assert(sizeof(x3::offset_position_tagged) == sizeof(int), "");
+
+    typedef std::string::const_iterator iterator_type;
+    typedef x3::error_handler<
+        iterator_type, x3::offset_position_cache<iterator_type>>
+    error_handler_type;
+
+    std::string const input("(1, 2)\n  (3,4) (5, 6)");
+    std::stringstream stream;
+    error_handler_type error_handler{input.begin(), input.end(), stream};
+
+    std::vector<offset_pair> ast;
+    auto const parser = x3::with<x3::error_handler_tag>(std::ref(error_handler))[
+        *offset_pair_rule];
+    BOOST_TEST(x3::phrase_parse(input.begin(), input.end(), parser, x3::space, ast));
+    BOOST_TEST_EQ(ast.size(), 3u);
+    BOOST_TEST_EQ(error_handler.get_position_cache().get_positions().size(), 3u);
+
+    auto const where = error_handler.position_of(ast[1]);
+    BOOST_TEST_EQ(std::string(where.begin(), where.end()), "(3,4)");
+    BOOST_TEST_EQ(error_handler.location_of(ast[2]).column, 9u);
+
+    error_handler(ast[1], "Error!");
+    BOOST_TEST_EQ(stream.str(), "In line 2:\nError!\n  (3,4) (5, 6)\n  ~~~~~ <<-- Here\n");
+
+    // nodes that are not tagged have no position
+    BOOST_TEST(error_handler.get_position_cache().position_of(42).empty());
+}
+
+template <typename Iterator>
+void test_line_index(Iterator first, Iterator last)
+{
+    // "ab\r\ncd\r\re\nf\n"
+    x3::line_index<Iterator> index(first, last);
+    BOOST_TEST_EQ(index.lines(), 6u);
+
+    std::size_t const lines[] = { 1, 1, 1, 1, 2, 2, 2, 3, 4, 4, 5, 5 };
+    std::size_t const columns[] = { 1, 2, 3, 4, 1, 2, 3, 1, 1, 2, 1, 2 };
+    std::size_t n = 0;
+    for (Iterator i = first; i != last; ++i, ++n)
+    {
+        auto const where = index.location_of(i);
+        BOOST_TEST_EQ(where.line, lines[n]);
+        BOOST_TEST_EQ(where.column, columns[n]);
+        BOOST_TEST_EQ(index.line(i), lines[n]);
+    }
+    BOOST_TEST_EQ(index.line(last), 6u);
+
+    auto const line2 = index.line_range(2);
+    BOOST_TEST_EQ(std::string(line2.begin(), line2.end()), "cd");
+    auto const line3 = index.line_range(3);
+    BOOST_TEST(line3.empty());
+    auto const line6 = index.line_range(6);
+    BOOST_TEST(line6.begin() == last && line6.empty());
+}
+
+void test_line_index()
+{
+    std::string const s = "ab\r\ncd\r\re\nf\n";
+    test_line_index(s.begin(), s.end());
+    test_line_index(s.data(), s.data() + s.size());
+    std::list<char> const l(s.begin(), s.end());
+    test_line_index(l.begin(), l.end());
+
+    // long lines exercise the vectorized scan
+    std::string const long_lines =
+        std::string(100, 'x') + "\r\n" + std::string(40, 'y') + "\n";
+    x3::line_index<char const*> index(
+        long_lines.data(), long_lines.data() + long_lines.size());
+    BOOST_TEST_EQ(index.lines(), 3u);
+    BOOST_TEST_EQ(index.line(long_lines.data() + 101), 1u);
+    BOOST_TEST_EQ(index.line(long_lines.data() + 102), 2u);
+    BOOST_TEST_EQ(index.location_of(long_lines.data() + 141).column, 40u);
+
+    std::string const empty;
+    x3::line_index<std::string::const_iterator> empty_index(
+        empty.begin(), empty.end());
+    BOOST_TEST_EQ(empty_index.lines(), 1u);
+    BOOST_TEST_EQ(empty_index.line(empty.end()), 1u);
 }
 
 int main() {
     test("\n");
     test("\r");
     test("\r\n");
+    test_line_index();
+    test_offset_position_cache();
 
     return boost::report_errors();
 }
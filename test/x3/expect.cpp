@@ -9,10 +9,45 @@
 #include <boost/fusion/include/vector.hpp>
 #include <boost/fusion/include/at.hpp>
 
+#include <cstring>
+#include <functional>
 #include <string>
 #include <iostream>
 #include "test.hpp"
 
+namespace x3 = boost::spirit::x3;
+
+int on_error_calls = 0;
+std::string on_error_which;
+x3::error_handler_result on_error_result = x3::error_handler_result::fail;
+
+struct nothrow_rule_class
+{
+    template <typename Iterator, typename Exception, typename Context>
+    x3::error_handler_result on_error(
+        Iterator&, Iterator const&, Exception const& x, Context const&) const
+    {
+        ++on_error_calls;
+        on_error_which = x.which();
+        return on_error_result;
+    }
+};
+
+x3::rule<nothrow_rule_class> const nothrow_rule = "nothrow_rule";
+auto const nothrow_rule_def = x3::lit('a') > 'b';
+
+BOOST_SPIRIT_DEFINE(nothrow_rule);
+
+template <typename Parser>
+bool parse_nothrow(char const* input, Parser const& p
+  , x3::expectation_failure_info<char const*>& failure)
+{
+    char const* first = input;
+    char const* last = input + std::strlen(input);
+    return x3::parse(first, last, x3::with<x3::expectation_failure_tag>(failure)[p])
+        && first == last;
+}
+
 int
 main()
 {
@@ -143,5 +178,96 @@ main()
         }
     }
 
+    { // non-throwing expectations
+        using x3::expectation_failure_info;
+
+        try
+        {
+            char const* input = "xi";
+            expectation_failure_info<char const*> failure;
+            char const* first = input;
+            BOOST_TEST(!x3::parse(first, input + 2
+              , x3::with<x3::expectation_failure_tag>(failure)[
+                    char_('x') > char_('o')]));
+            BOOST_TEST(failure.failed());
+            BOOST_TEST(failure.where() == input + 1);
+            BOOST_TEST_EQ(failure.which(), x3::what(char_('o')));
+
+            failure.clear();
+            BOOST_TEST(!failure.failed());
+            BOOST_TEST(parse_nothrow("xi", char_('x') > char_('i'), failure));
+            BOOST_TEST(!failure.failed());
+
+            // the first (innermost) failure is kept
+            char const* abd = "abd";
+            BOOST_TEST(!parse_nothrow(abd, lit('a') > (lit('b') > 'c'), failure));
+            BOOST_TEST(failure.where() == abd + 2);
+            BOOST_TEST_EQ(failure.which(), "'c'");
+
+            // the info keeps what it needs for which()
+            expectation_failure_info<char const*> copy(failure);
+            BOOST_TEST(copy.failed() && copy.where() == abd + 2);
+            BOOST_TEST_EQ(copy.which(), "'c'");
+
+            // no backtracking over a failure
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("x", (lit('x') > 'o') | lit('x'), failure));
+            BOOST_TEST(failure.failed());
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("aba", *(lit('a') > 'b') >> 'a', failure));
+            BOOST_TEST(failure.failed());
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("a", -(lit('a') > 'b') >> 'a', failure));
+            BOOST_TEST(failure.failed());
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("a", !(lit('a') > 'b') >> 'a', failure));
+            BOOST_TEST(failure.failed());
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("a,a", (lit('a') > 'b') % ',' >> ",a", failure));
+            BOOST_TEST(failure.failed());
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("aax", x3::seek[lit('a') > 'x'], failure));
+            BOOST_TEST(failure.failed());
+            failure.clear();
+            BOOST_TEST(!parse_nothrow("ab", x3::matches[lit('a') > 'x'] >> 'a' >> 'b', failure));
+            BOOST_TEST(failure.failed());
+
+            // also works with a std::reference_wrapper
+            failure.clear();
+            char const* xi = "xi";
+            BOOST_TEST(!x3::parse(xi, xi + 2
+              , x3::with<x3::expectation_failure_tag>(std::ref(failure))[
+                    char_('x') > char_('o')]));
+            BOOST_TEST(failure.failed());
+
+            // rules with an on_error handler see the failure
+            failure.clear();
+            on_error_result = x3::error_handler_result::fail;
+            BOOST_TEST(!parse_nothrow("ac", nothrow_rule, failure));
+            BOOST_TEST_EQ(on_error_calls, 1);
+            BOOST_TEST_EQ(on_error_which, "'b'");
+            BOOST_TEST(!failure.failed());
+            BOOST_TEST(parse_nothrow("c", nothrow_rule | 'c', failure));
+            BOOST_TEST_EQ(on_error_calls, 1);
+
+            on_error_result = x3::error_handler_result::rethrow;
+            BOOST_TEST(!parse_nothrow("ac", nothrow_rule | "ac", failure));
+            BOOST_TEST_EQ(on_error_calls, 2);
+            BOOST_TEST(failure.failed());
+
+            failure.clear();
+            on_error_result = x3::error_handler_result::accept;
+            char const* ac = "ac";
+            char const* ac_first = ac;
+            BOOST_TEST(x3::parse(ac_first, ac + 2
+              , x3::with<x3::expectation_failure_tag>(failure)[nothrow_rule]));
+            BOOST_TEST(!failure.failed());
+        }
+        catch (expectation_failure<char const*> const&)
+        {
+            BOOST_TEST(false);
+        }
+    }
+
     return boost::report_errors();
 }
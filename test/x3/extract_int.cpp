@@ -10,6 +10,8 @@
 #include <cstdio>
 #include <iosfwd>
 #include <limits>
+#include <sstream>
+#include <string>
 
 struct custom_int
 {
@@ -68,6 +70,78 @@ public:
 
 }
 
+// Parse the decimal form of n, followed by tail, back into a T.
+template <typename T>
+bool check_digits(T n, char const* tail)
+{
+    std::ostringstream oss;
+    oss << n;
+    std::string const digits = oss.str();
+    std::string const s = digits + tail;
+    char const* it = s.data();
+    char const* const end = it + s.size();
+    T x = 0;
+    return boost::spirit::x3::extract_int<T, 10, 1, -1>::call(it, end, x)
+        && x == n && it == s.data() + digits.size();
+}
+
+// Numbers of all lengths, so that the eight digit blocks start and end
+// everywhere, including right at the overflow limits.
+template <typename T>
+void check_block_digits()
+{
+    char const* const tails[] = { "", ",", "x12345678", " 1234567" };
+    T const max = (std::numeric_limits<T>::max)();
+    T const min = (std::numeric_limits<T>::min)();
+    for (std::size_t t = 0; t != sizeof(tails) / sizeof(tails[0]); ++t)
+    {
+        char const* tail = tails[t];
+        T n = 1;
+        for (int i = 0; i != std::numeric_limits<T>::digits10; ++i)
+        {
+            BOOST_TEST(check_digits<T>(n, tail));
+            BOOST_TEST(check_digits<T>(n - 1, tail));
+            BOOST_TEST(check_digits<T>(n * 7 + n / 3, tail));
+            BOOST_TEST(check_digits<T>(min + n, tail));
+            BOOST_TEST(check_digits<T>(max - n, tail));
+            n *= 10;
+        }
+        BOOST_TEST(check_digits<T>(max, tail));
+        BOOST_TEST(check_digits<T>(min, tail));
+    }
+
+    T const limits[] = { max, min };
+    for (int l = 0; l != 2; ++l)
+    {
+        std::ostringstream oss;
+        oss << limits[l];
+        std::string s = oss.str();
+        if (s == "0")
+            continue;
+
+        // one past the limit (the limits never end in a 9), then ten times
+        // the limit
+        std::string const past[] = {
+            s.substr(0, s.size() - 1) + char(s[s.size() - 1] + 1), s + '0' };
+        for (int i = 0; i != 2; ++i)
+        {
+            char const* const begin = past[i].data();
+            char const* it = begin;
+            T x = 0;
+            BOOST_TEST(!(boost::spirit::x3::extract_int<T, 10, 1, -1>::call(
+                it, begin + past[i].size(), x)));
+            BOOST_TEST(it == begin);
+        }
+    }
+
+    std::string const zeros = std::string(20, '0') + "1234567890123456";
+    char const* it = zeros.data();
+    boost::long_long_type ll = 0;
+    BOOST_TEST((boost::spirit::x3::extract_int<boost::long_long_type, 10, 1, -1>::call(
+        it, zeros.data() + zeros.size(), ll)));
+    BOOST_TEST(ll == 1234567890123456LL && it == zeros.data() + zeros.size());
+}
+
 int main()
 {
     namespace x3 = boost::spirit::x3;
@@ -128,5 +202,11 @@ int main()
         }
     }
 
+    check_block_digits<int>();
+    check_block_digits<unsigned>();
+    check_block_digits<long>();
+    check_block_digits<boost::long_long_type>();
+    check_block_digits<boost::ulong_long_type>();
+
     return boost::report_errors();
 }
@@ -0,0 +1,166 @@
+/*=============================================================================
+    Copyright (c) 2001-2015 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/home/x3.hpp>
+
+#include <string>
+#include <iostream>
+#include "test.hpp"
+
+namespace x3 = boost::spirit::x3;
+
+namespace
+{
+    int calls = 0;
+    auto const count = [](auto&) { ++calls; };
+
+    // forces the attribute, which the semantic action would disable
+    x3::rule<class digits, int, true> const digits = "digits";
+    auto const digits_def = x3::int_[count];
+
+    BOOST_SPIRIT_DEFINE(digits);
+
+    // both branches start with the same rule, and so does every level of
+    // nesting: without memoization the parse is exponential in the depth
+    x3::rule<class nested> const nested = "nested";
+    auto const nested_def =
+            '(' >> x3::memoize[nested] >> ')' >> '+'
+        |   '(' >> x3::memoize[nested] >> ')'
+        |   x3::memoize[digits]
+        ;
+
+    BOOST_SPIRIT_DEFINE(nested);
+
+    x3::rule<class word> const word = "word";
+    auto const word_def = +x3::alpha;
+
+    BOOST_SPIRIT_DEFINE(word);
+}
+
+int
+main()
+{
+    using spirit_test::test;
+    using spirit_test::test_attr;
+    using x3::char_;
+    using x3::int_;
+    using x3::memo_table;
+    using x3::memo_table_tag;
+    using x3::memoize;
+    using x3::with;
+
+    typedef char const* iterator_type;
+
+    {   // without a memo_table the subject is parsed
+        BOOST_TEST((test("123", memoize[int_])));
+        int i = 0;
+        BOOST_TEST((test_attr("123", memoize[int_], i)));
+        BOOST_TEST_EQ(i, 123);
+    }
+
+    {   // the subject of both branches is parsed once
+        std::string const input = "1234y";
+        iterator_type first = input.c_str();
+        iterator_type const last = first + input.size();
+
+        memo_table<iterator_type> table(first);
+        auto const number = memoize[digits];
+        int i = 0;
+
+        calls = 0;
+        BOOST_TEST((x3::parse(first, last
+          , with<memo_table_tag>(table)[
+                (number >> 'x') | (number >> 'y')], i)));
+        BOOST_TEST(first == last);
+        BOOST_TEST_EQ(i, 1234);
+        BOOST_TEST_EQ(calls, 1);
+        BOOST_TEST_EQ(table.hits(), 1u);
+        BOOST_TEST_EQ(table.size(), 1u);
+    }
+
+    {   // failures are memoized too
+        std::string const input = "abc";
+        iterator_type first = input.c_str();
+        memo_table<iterator_type> table(first);
+        auto const number = memoize[digits];
+
+        calls = 0;
+        BOOST_TEST((x3::parse(first, first + input.size()
+          , with<memo_table_tag>(table)[
+                (number >> 'x') | (number >> 'y') | +char_])));
+        BOOST_TEST_EQ(table.hits(), 1u);
+        BOOST_TEST_EQ(calls, 0);
+    }
+
+    {   // nested rules stay linear
+        std::string input;
+        for (int i = 0; i != 20; ++i)
+            input += '(';
+        input += "42";
+        for (int i = 0; i != 20; ++i)
+            input += ')';
+
+        iterator_type first = input.c_str();
+        iterator_type const last = first + input.size();
+        memo_table<iterator_type> table(first);
+
+        calls = 0;
+        BOOST_TEST((x3::phrase_parse(first, last
+          , with<memo_table_tag>(table)[nested], x3::space)));
+        BOOST_TEST(first == last);
+        BOOST_TEST_EQ(calls, 1);
+        BOOST_TEST(table.size() <= 22u);
+    }
+
+    {   // a bounded table drops the lowest offsets first
+        std::string const input = "1 2 3 4";
+        iterator_type first = input.c_str();
+        iterator_type const last = first + input.size();
+        memo_table<iterator_type> table(first, 2);
+
+        std::vector<int> v;
+        BOOST_TEST((x3::phrase_parse(first, last
+          , with<memo_table_tag>(table)[*memoize[int_]], x3::space, v)));
+        BOOST_TEST_EQ(v.size(), 4u);
+        BOOST_TEST_EQ(table.size(), 2u);
+
+        table.evict_before(last);
+        BOOST_TEST_EQ(table.size(), 1u);     // the failure at the end
+        table.clear();
+        BOOST_TEST_EQ(table.size(), 0u);
+    }
+
+    {   // a failure recorded as an expectation failure is not memoized
+        std::string const input = "1,";
+        iterator_type first = input.c_str();
+        memo_table<iterator_type> table(first);
+        x3::expectation_failure_info<iterator_type> failure;
+
+        BOOST_TEST((!x3::parse(first, first + input.size()
+          , with<memo_table_tag>(table)[
+                with<x3::expectation_failure_tag>(failure)[
+                    memoize[int_ > ',' > int_]]])));
+        BOOST_TEST(failure.failed());
+        BOOST_TEST_EQ(table.size(), 0u);
+    }
+
+    {   // results in a lexeme are not replayed where the input is skipped
+        std::string const input = "ab c?";
+        iterator_type first = input.c_str();
+        iterator_type const last = first + input.size();
+        memo_table<iterator_type> table(first);
+
+        BOOST_TEST((x3::phrase_parse(first, last
+          , with<memo_table_tag>(table)[
+                x3::lexeme[memoize[word] >> '!'] | (memoize[word] >> '?')]
+          , x3::space)));
+        BOOST_TEST(first == last);
+        BOOST_TEST_EQ(table.size(), 2u);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,114 @@
+/*=============================================================================
+    Copyright (c) 2001-2015 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/core/parse_parallel.hpp>
+
+#include <string>
+#include <vector>
+
+namespace x3 = boost::spirit::x3;
+
+int
+main()
+{
+    using x3::int_;
+    using x3::eol;
+    using x3::omit;
+
+    std::string input;
+    for (int i = 0; i != 10000; ++i)
+        input += "key" + std::to_string(i) + "," + std::to_string(i) + "\n";
+    char const* const begin = input.data();
+    char const* const end = begin + input.size();
+
+    x3::parallel_options options;
+    options.chunk_size = 1000;
+    options.threads = 4;
+
+    auto const record = omit[+x3::alnum] >> ',' >> int_ >> eol;
+
+    {   // the records come out in input order
+        std::vector<int> v;
+        char const* first = begin;
+        BOOST_TEST(x3::parse_parallel(first, end, record
+          , x3::line_boundary(), v, options));
+        BOOST_TEST(first == end);
+        BOOST_TEST_EQ(v.size(), 10000u);
+        bool ordered = true;
+        for (int i = 0; i != int(v.size()); ++i)
+            ordered = ordered && v[i] == i;
+        BOOST_TEST(ordered);
+    }
+
+    {   // a single chunk, and the default options
+        std::vector<int> v;
+        char const* first = begin;
+        BOOST_TEST(x3::parse_parallel(first, end, record
+          , x3::line_boundary(), v));
+        BOOST_TEST_EQ(v.size(), 10000u);
+    }
+
+    {   // an error is reported at its position in the input
+        std::string bad = input;
+        std::size_t const line = bad.find("key5000,");
+        bad[line + 7] = ';';
+        char const* const bad_begin = bad.data();
+        std::vector<int> v;
+        char const* first = bad_begin;
+        BOOST_TEST(!x3::parse_parallel(first, bad_begin + bad.size()
+          , record, x3::line_boundary(), v, options));
+        BOOST_TEST_EQ(std::size_t(first - bad_begin), line);
+
+        // the records of the chunks before the error are kept
+        BOOST_TEST(v.size() <= 5000u);
+        BOOST_TEST(v.size() > 4000u);
+        BOOST_TEST_EQ(v.back(), int(v.size()) - 1);
+    }
+
+    {   // expectation failures are rethrown with their global position
+        std::string bad = input;
+        std::size_t const line = bad.find("key7777,");
+        bad[line + 8] = 'x';
+        char const* first = bad.data();
+        std::vector<int> v;
+        try
+        {
+            x3::parse_parallel(first, first + bad.size()
+              , omit[+x3::alnum] >> ',' > int_ > eol
+              , x3::line_boundary(), v, options);
+            BOOST_TEST(false);
+        }
+        catch (x3::expectation_failure<char const*> const& x)
+        {
+            BOOST_TEST_EQ(std::size_t(x.where() - bad.data()), line + 8);
+        }
+    }
+
+    {   // skipping, and lines ending in "\r\n"
+        std::string const lines = "  1  \r\n2\r\n  3 \r\n";
+        std::vector<int> v;
+        std::string::const_iterator first = lines.begin();
+        x3::parallel_options small;
+        small.chunk_size = 1;
+        BOOST_TEST(x3::phrase_parse_parallel(first, lines.end()
+          , int_ >> eol, x3::blank, x3::line_boundary(), v, small));
+        BOOST_TEST(first == lines.end());
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST_EQ(v[2], 3);
+    }
+
+    {   // empty input
+        std::vector<int> v;
+        char const* first = begin;
+        BOOST_TEST(x3::parse_parallel(first, begin, record
+          , x3::line_boundary(), v, options));
+        BOOST_TEST(v.empty());
+    }
+
+    return boost::report_errors();
+}
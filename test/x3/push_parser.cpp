@@ -0,0 +1,104 @@
+/*=============================================================================
+    Copyright (c) 2001-2015 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/core/push_parser.hpp>
+#include <boost/fusion/include/std_pair.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace x3 = boost::spirit::x3;
+
+int
+main()
+{
+    using x3::int_;
+    using x3::char_;
+    using x3::lit;
+    using x3::make_push_parser;
+
+    {   // records are handed out as soon as they are complete
+        std::vector<int> v;
+        auto p = make_push_parser<int>(int_ >> ';', [&](int i) { v.push_back(i); });
+
+        BOOST_TEST(p.feed("1"));
+        BOOST_TEST(v.empty());
+        BOOST_TEST(p.feed("2;3"));
+        BOOST_TEST_EQ(v.size(), 1u);
+        BOOST_TEST_EQ(v[0], 12);
+        BOOST_TEST_EQ(p.buffered(), 1u);     // only the unconsumed tail
+        BOOST_TEST(p.feed(";4;"));
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST_EQ(v[2], 4);
+        BOOST_TEST_EQ(p.buffered(), 0u);
+        BOOST_TEST_EQ(p.consumed(), 7u);
+        BOOST_TEST(p.finish());
+    }
+
+    {   // a record that ends at the end of the input waits for more
+        std::vector<int> v;
+        auto p = make_push_parser<int>(int_, x3::space
+          , [&](int i) { v.push_back(i); });
+
+        BOOST_TEST(p.feed("  10 2"));
+        BOOST_TEST_EQ(v.size(), 1u);
+        BOOST_TEST(p.feed("0 "));
+        BOOST_TEST_EQ(v.size(), 2u);
+        BOOST_TEST_EQ(v[1], 20);
+        BOOST_TEST(p.feed("3"));
+        BOOST_TEST_EQ(v.size(), 2u);
+        BOOST_TEST(p.finish());
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST_EQ(v[2], 3);
+    }
+
+    {   // attributes of composite records
+        std::vector<std::pair<char, int>> v;
+        auto p = make_push_parser<std::pair<char, int>>(
+            char_("a-z") >> '=' >> int_ >> ';'
+          , [&](std::pair<char, int>&& kv) { v.push_back(kv); });
+
+        std::string const input = "a=1;b=22;c=333;";
+        for (char c : input)
+            BOOST_TEST(p.feed(&c, 1));
+        BOOST_TEST(p.finish());
+        BOOST_TEST_EQ(v.size(), 3u);
+        BOOST_TEST_EQ(v[1].first, 'b');
+        BOOST_TEST_EQ(v[2].second, 333);
+    }
+
+    {   // an expectation that fails at the end of a chunk is retried
+        std::vector<int> v;
+        auto p = make_push_parser<int>(lit('#') > int_ > ';'
+          , [&](int i) { v.push_back(i); });
+
+        BOOST_TEST(p.feed("#1;#"));
+        BOOST_TEST(p.feed("2"));
+        BOOST_TEST(!p.feed(";#x;"));
+        BOOST_TEST(p.failed());
+        BOOST_TEST_EQ(v.size(), 2u);
+        BOOST_TEST_EQ(p.consumed(), 7u);
+        BOOST_TEST(!p.which().empty());
+        BOOST_TEST(!p.feed("#3;"));
+    }
+
+    {   // errors, and input left over at the end
+        auto p = make_push_parser<int>(int_ >> ';', [](int) {});
+        BOOST_TEST(p.feed("1;"));
+        BOOST_TEST(!p.feed("x;"));
+        BOOST_TEST_EQ(p.consumed(), 2u);
+
+        auto q = make_push_parser<int>(int_ >> ';', [](int) {});
+        BOOST_TEST(q.feed("1;2"));
+        BOOST_TEST(!q.finish());
+        BOOST_TEST_EQ(q.consumed(), 2u);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,155 @@
+/*=============================================================================
+    Copyright (c) 2001-2015 Joel de Guzman
+    Copyright (c) 2001-2011 Hartmut Kaiser
+
+    Use, modification and distribution is subject to the Boost Software
+    License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+    http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+
+#include "real.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    namespace x3 = boost::spirit::x3;
+
+    struct strict_fast_policies : x3::fast_real_policies<double>
+    {
+        static bool const expect_dot = true;
+        static bool const allow_trailing_dot = false;
+    };
+
+    x3::real_parser<double, x3::fast_real_policies<double> > const fast_double;
+    x3::real_parser<float, x3::fast_real_policies<float> > const fast_float;
+
+    // the fast path must match strtod bit for bit
+    bool check_double(char const* s)
+    {
+        char const* first = s;
+        char const* last = s + std::strlen(s);
+        double d = 0;
+        if (!x3::parse(first, last, fast_double, d) || first != last)
+            return false;
+        double const expected = std::strtod(s, 0);
+        return std::memcmp(&d, &expected, sizeof(d)) == 0;
+    }
+
+    bool check_float(char const* s)
+    {
+        char const* first = s;
+        char const* last = s + std::strlen(s);
+        float f = 0;
+        if (!x3::parse(first, last, fast_float, f) || first != last)
+            return false;
+        float const expected = std::strtof(s, 0);
+        return std::memcmp(&f, &expected, sizeof(f)) == 0;
+    }
+}
+
+int
+main()
+{
+    using spirit_test::test;
+    using spirit_test::test_attr;
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  same syntax as the default policies
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        double d;
+
+        BOOST_TEST(test_attr("-1234", fast_double, d) && d == -1234);
+        BOOST_TEST(test_attr("+1.2e3", fast_double, d) && d == 1.2e3);
+        BOOST_TEST(test_attr("-0.1", fast_double, d) && d == -0.1);
+        BOOST_TEST(test_attr("-1.e2", fast_double, d) && d == -1.e2);
+        BOOST_TEST(test_attr("-.2e3", fast_double, d) && d == -.2e3);
+        BOOST_TEST(test_attr("1.", fast_double, d) && d == 1.);
+        BOOST_TEST(test_attr("0.000", fast_double, d) && d == 0);
+        BOOST_TEST(test_attr("-0", fast_double, d) && d == 0
+            && boost::math::signbit(d));
+
+        BOOST_TEST(!test("-e3", fast_double));
+        BOOST_TEST(!test("-1.2e", fast_double));
+        BOOST_TEST(!test(".", fast_double));
+        BOOST_TEST(!test("", fast_double));
+        BOOST_TEST(test("1.2e3x", fast_double, false));
+
+        BOOST_TEST(test_attr("nan", fast_double, d) && boost::math::isnan(d));
+        BOOST_TEST(test_attr("-inf", fast_double, d)
+            && boost::math::isinf(d) && d < 0);
+        BOOST_TEST(test_attr("infinity", fast_double, d) && boost::math::isinf(d));
+
+        x3::real_parser<double, x3::fast_ureal_policies<double> > fast_udouble;
+        BOOST_TEST(!test("-1.2", fast_udouble));
+        BOOST_TEST(test_attr("1.25", fast_udouble, d) && d == 1.25);
+    }
+
+    {
+        x3::real_parser<double, strict_fast_policies> strict;
+        double d;
+
+        BOOST_TEST(!test("1", strict));
+        BOOST_TEST(test_attr("1e3", strict, d) && d == 1e3);
+        BOOST_TEST(test_attr("1.5", strict, d) && d == 1.5);
+        BOOST_TEST(!test("1.", strict));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  correct rounding
+    ///////////////////////////////////////////////////////////////////////////
+    {
+        char const* const numbers[] =
+        {
+            "0.1", "0.3", "1e23", "8.988465674311579e+307",
+            "1.7976931348623157e308", "1.7976931348623158e308", "1.8e308",
+            "2.2250738585072011e-308", "2.2250738585072014e-308",
+            "4.9406564584124654e-324", "2.4703282292062328e-324",
+            "2.4703282292062327e-324", "1e-400", "1e400",
+            "-5.7222349715140557e+307", "2.0332938517515416e-308",
+            "9007199254740993", "9007199254740992.000000000000000000001",
+            "3.14159265358979323846264338327950288419716939937510",
+            "0.000000000000000000000000000000000000000000001",
+            "123456789012345678901234567890e-10",
+            "7.2057594037927933e16", "1.00000000000000011102230246251565404236316680908203124",
+            "179769313486231570000000000000000e276"
+        };
+        for (std::size_t i = 0; i != sizeof(numbers) / sizeof(numbers[0]); ++i)
+            BOOST_TEST(check_double(numbers[i]));
+
+        // round trip of pseudo-random doubles
+        boost::uint64_t state = 0x9e3779b97f4a7c15ull;
+        for (int i = 0; i != 20000; ++i)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            double d;
+            std::memcpy(&d, &state, sizeof(d));
+            if (boost::math::isnan(d) || boost::math::isinf(d))
+                continue;
+
+            char buf[64];
+            std::sprintf(buf, "%.17g", d);
+            BOOST_TEST(check_double(buf));
+            std::sprintf(buf, "%.6g", d);
+            BOOST_TEST(check_double(buf));
+        }
+    }
+
+    {
+        char const* const numbers[] =
+        {
+            "0.1", "1e38", "3.4028235e38", "3.4028236e38", "1e-45",
+            "1.17549435e-38", "16777217", "1.00000006", "7.038531e-26"
+        };
+        for (std::size_t i = 0; i != sizeof(numbers) / sizeof(numbers[0]); ++i)
+            BOOST_TEST(check_float(numbers[i]));
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,170 @@
+/*=============================================================================
+    Copyright (c) 2001-2015 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/nonterminal/rule_profiler.hpp>
+
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace x3 = boost::spirit::x3;
+
+namespace grammar
+{
+    using x3::int_;
+
+    x3::rule<class expr, int> const expr("expr");
+    auto const expr_def = '(' >> expr >> ')' | int_;
+    BOOST_SPIRIT_DEFINE(expr)
+}
+
+x3::rule_profiler::rule_stats
+find(x3::rule_profiler const& profiler, char const* name)
+{
+    for (auto const& s : profiler.stats())
+    {
+        if (std::strcmp(s.name, name) == 0)
+            return s;
+    }
+    return x3::rule_profiler::rule_stats();
+}
+
+int
+main()
+{
+    using x3::int_;
+    using x3::lit;
+    using x3::rule;
+    using x3::rule_profiler;
+    using x3::rule_profiler_tag;
+    using x3::with;
+
+    auto const num = rule<class num, int>("num") = int_;
+    auto const x = rule<class x>("x") = lit('x');
+    auto const y = rule<class y>("y") = lit('y');
+    auto const alt = rule<class alt, int>("alt") = (num >> x) | (num >> y);
+    auto const list = rule<class list, std::vector<int>>("list") = alt % ',';
+
+    {   // without a profiler the rules are parsed as usual
+        std::string const input = "12y,3x";
+        auto first = input.begin();
+        std::vector<int> v;
+        BOOST_TEST(x3::parse(first, input.end(), list, v));
+        BOOST_TEST(first == input.end());
+        BOOST_TEST_EQ(v.size(), 2u);
+    }
+
+    {   // counts, consumed and backtracked bytes
+        rule_profiler profiler;
+        std::string const input = "12y,3x";
+        auto first = input.begin();
+        std::vector<int> v;
+        BOOST_TEST(x3::parse(first, input.end()
+          , with<rule_profiler_tag>(profiler)[list], v));
+        BOOST_TEST_EQ(v.size(), 2u);
+        BOOST_TEST_EQ(v[0], 12);
+
+        BOOST_TEST_EQ(profiler.stats().size(), 5u);
+
+        auto const n = find(profiler, "num");
+        BOOST_TEST_EQ(n.calls, 3u);
+        BOOST_TEST_EQ(n.successes, 3u);
+        BOOST_TEST_EQ(n.consumed, 5u);
+
+        auto const xs = find(profiler, "x");
+        BOOST_TEST_EQ(xs.calls, 2u);
+        BOOST_TEST_EQ(xs.successes, 1u);
+        BOOST_TEST_EQ(xs.failures, 1u);
+
+        auto const a = find(profiler, "alt");
+        BOOST_TEST_EQ(a.calls, 2u);
+        BOOST_TEST_EQ(a.consumed, 5u);
+        BOOST_TEST_EQ(a.backtracked, 2u);      // "12" is parsed twice
+
+        auto const l = find(profiler, "list");
+        BOOST_TEST_EQ(l.calls, 1u);
+        BOOST_TEST_EQ(l.consumed, 6u);
+        BOOST_TEST_EQ(l.backtracked, 0u);
+        BOOST_TEST(l.inclusive >= a.inclusive);
+        BOOST_TEST(l.inclusive >= l.exclusive);
+
+        std::ostringstream table;
+        profiler.report(table);
+        BOOST_TEST(table.str().find("backtracked") != std::string::npos);
+        BOOST_TEST(table.str().find("\nalt ") != std::string::npos);
+
+        // the formatting of the stream is left alone
+        std::ostringstream formatted;
+        formatted.precision(3);
+        profiler.report(formatted);
+        BOOST_TEST_EQ(formatted.precision(), 3);
+        BOOST_TEST(!(formatted.flags() & std::ios_base::fixed));
+        formatted.str("");
+        formatted << 0.5;
+        BOOST_TEST_EQ(formatted.str(), "0.5");
+
+        profiler.clear();
+        BOOST_TEST(profiler.stats().empty());
+    }
+
+    {   // call paths of recursive rules, passing the profiler by reference
+        rule_profiler profiler;
+        std::string const input = "((1))";
+        auto first = input.begin();
+        int i = 0;
+        BOOST_TEST(x3::parse(first, input.end()
+          , with<rule_profiler_tag>(std::ref(profiler))[grammar::expr], i));
+        BOOST_TEST_EQ(i, 1);
+
+        auto const e = find(profiler, "expr");
+        BOOST_TEST_EQ(e.calls, 3u);
+        BOOST_TEST_EQ(e.successes, 3u);
+        BOOST_TEST(e.inclusive >= e.exclusive);
+
+        std::ostringstream folded;
+        profiler.folded_stacks(folded);
+        std::istringstream lines(folded.str());
+        std::string line;
+        bool deepest = false;
+        while (std::getline(lines, line))
+        {
+            BOOST_TEST(line.compare(0, 4, "expr") == 0);
+            deepest = deepest || line.compare(0, 15, "expr;expr;expr ") == 0;
+        }
+        BOOST_TEST(deepest);
+    }
+
+    {   // rules left by an exception are recorded as failures
+        rule_profiler profiler;
+        auto const strict = rule<class strict, int>("strict") = '(' > num > ')';
+        std::string const input = "(1]";
+        auto first = input.begin();
+        int i = 0;
+        try
+        {
+            x3::parse(first, input.end()
+              , with<rule_profiler_tag>(profiler)[strict], i);
+            BOOST_TEST(false);
+        }
+        catch (x3::expectation_failure<std::string::const_iterator> const&)
+        {
+        }
+        BOOST_TEST_EQ(find(profiler, "strict").failures, 1u);
+        BOOST_TEST_EQ(find(profiler, "num").successes, 1u);
+
+        std::string const next = "2";
+        auto next_first = next.begin();
+        BOOST_TEST(x3::parse(next_first, next.end()
+          , with<rule_profiler_tag>(profiler)[num], i));
+        BOOST_TEST_EQ(find(profiler, "num").successes, 2u);
+    }
+
+    return boost::report_errors();
+}
@@ -9,6 +9,7 @@
 #include <boost/spirit/home/x3.hpp>
 
 #include <iostream>
+#include <string>
 #include "test.hpp"
 
 int
@@ -44,5 +45,23 @@ main()
         BOOST_TEST(!(test("a bcd", lexeme[lexeme[lit('a') >> 'b' >> skip[lit('c') >> 'd']]], space)));
     }
 
+    { // long white space runs on contiguous input (vectorized skipping)
+        std::string ws(" \t\n\v\f\r");
+        for (int i = 0; i != 6; ++i)
+            ws += ws;
+        std::string in = "a" + ws + "b" + ws.substr(0, 17) + "c" + ws;
+        BOOST_TEST((test(in.c_str(), lit('a') >> 'b' >> 'c', space)));
+        BOOST_TEST((test(in.c_str(), lit('a') >> 'b' >> 'c', boost::spirit::x3::standard::space)));
+        BOOST_TEST(!(test(in.c_str(), lit('a') >> 'c', space)));
+
+        std::string s;
+        BOOST_TEST((test_attr(in.c_str(), *char_, s, space)));
+        BOOST_TEST(s == "abc");
+
+        // non-ASCII white space is still left to the skipper
+        std::string nbsp = "a" + ws.substr(0, 20) + "\xa0" + ws + "b";
+        BOOST_TEST((test(nbsp.c_str(), lit('a') >> 'b', boost::spirit::x3::iso8859_1::space)));
+    }
+
     return boost::report_errors();
 }
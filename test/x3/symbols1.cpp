@@ -6,6 +6,7 @@
 =============================================================================*/
 #include <boost/detail/lightweight_test.hpp>
 #include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/string/frozen_tst.hpp>
 
 #include <iostream>
 #include "test.hpp"
@@ -183,5 +184,32 @@ main()
         BOOST_TEST((!test("XXX", sym[f])));
     }
 
+    { // frozen lookup
+        namespace x3 = boost::spirit::x3;
+        typedef x3::symbols_parser<boost::spirit::char_encoding::standard
+          , int, x3::frozen_tst<char, int> > frozen_symbols;
+
+        frozen_symbols sym;
+        sym.add
+            ("joel", 1)
+            ("ruby", 2)
+            ("joey", 3)
+            ("joeyboy", 4)
+        ;
+        sym.freeze();
+
+        int i = 0;
+        BOOST_TEST((test_attr("joel", sym, i)));
+        BOOST_TEST(i == 1);
+        BOOST_TEST((test_attr("joeyboy", sym, i)));
+        BOOST_TEST(i == 4);
+        BOOST_TEST((test_attr("JOEY", no_case[sym], i)));
+        BOOST_TEST(i == 3);
+        BOOST_TEST((test("joeyb", sym, false)));
+        BOOST_TEST((!test("XXX", sym)));
+        BOOST_TEST(sym.find("ruby") && *sym.find("ruby") == 2);
+        BOOST_TEST(!sym.find("rub"));
+    }
+
     return boost::report_errors();
 }
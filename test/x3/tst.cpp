@@ -7,6 +7,7 @@
 #include <boost/detail/lightweight_test.hpp>
 #include <boost/spirit/home/x3/string/tst.hpp>
 #include <boost/spirit/home/x3/string/tst_map.hpp>
+#include <boost/spirit/home/x3/string/frozen_tst.hpp>
 #include <boost/spirit/home/x3/support/no_case.hpp>
 #include <boost/spirit/home/support/char_encoding/standard.hpp>
 #include <boost/spirit/home/support/char_encoding/standard_wide.hpp>
@@ -325,13 +326,102 @@ void tests()
     }
 }
 
+template <typename Lookup, typename WideLookup>
+void frozen_tests()
+{
+    { // lookups on the frozen form
+        Lookup lookup;
+        add(lookup, "pineapple", 1);
+        add(lookup, "orange", 2);
+        add(lookup, "banana", 3);
+        add(lookup, "applepie", 4);
+        add(lookup, "apple", 5);
+        lookup.freeze();
+        BOOST_TEST(lookup.frozen());
+
+        docheck(lookup, ncomp, "pineapple", true, 9, 1);
+        docheck(lookup, ncomp, "orange", true, 6, 2);
+        docheck(lookup, ncomp, "banana", true, 6, 3);
+        docheck(lookup, ncomp, "apple", true, 5, 5);
+        docheck(lookup, ncomp, "pizza", false);
+        docheck(lookup, ncomp, "", false);
+        docheck(lookup, ncomp, "applepie", true, 8, 4);
+        docheck(lookup, ncomp, "bananarama", true, 6, 3);
+        docheck(lookup, ncomp, "applet", true, 5, 5);
+        docheck(lookup, ncomp, "applepi", true, 5, 5);
+        docheck(lookup, ncomp, "appl", false);
+
+        docheck(lookup, nc_ncomp, "PINEAPPLE", true, 9, 1);
+        docheck(lookup, nc_ncomp, "aPPLe", true, 5, 5);
+        docheck(lookup, nc_ncomp, "ApplePiez", true, 8, 4);
+
+        print(lookup);
+    }
+
+    { // wide char tests
+        WideLookup lookup;
+        add(lookup, L"apple", 5);
+        add(lookup, L"applepie", 4);
+        lookup.freeze();
+
+        docheck(lookup, wcomp, L"apple", true, 5, 5);
+        docheck(lookup, wcomp, L"applepix", true, 5, 5);
+        docheck(lookup, wcomp, L"applepiez", true, 8, 4);
+        docheck(lookup, nc_wcomp, L"APPLEPIE", true, 8, 4);
+    }
+
+    { // add/remove after freeze thaws the tree
+        Lookup lookup;
+        add(lookup, "apple", 5);
+        add(lookup, "banana", 3);
+        lookup.freeze();
+
+        add(lookup, "applepie", 4);
+        BOOST_TEST(!lookup.frozen());
+        docheck(lookup, ncomp, "applepie", true, 8, 4);
+        docheck(lookup, ncomp, "banana", true, 6, 3);
+
+        lookup.freeze();
+        remove(lookup, "banana");
+        docheck(lookup, ncomp, "banana", false);
+        docheck(lookup, ncomp, "apple", true, 5, 5);
+
+        lookup.freeze();
+        docheck(lookup, ncomp, "banana", false);
+        docheck(lookup, ncomp, "applepie", true, 8, 4);
+    }
+
+    { // copy/assign/clear test
+        Lookup lookupa;
+        add(lookupa, "orange", 2);
+        add(lookupa, "apple", 5);
+        lookupa.freeze();
+
+        Lookup lookupb(lookupa); // copy ctor
+        BOOST_TEST(lookupb.frozen());
+        docheck(lookupb, ncomp, "orange", true, 6, 2);
+        docheck(lookupb, ncomp, "apple", true, 5, 5);
+
+        lookupb.clear(); // clear
+        BOOST_TEST(!lookupb.frozen());
+        docheck(lookupb, ncomp, "orange", false);
+
+        lookupb = lookupa; // assign
+        docheck(lookupb, ncomp, "orange", true, 6, 2);
+        docheck(lookupb, ncomp, "apple", true, 5, 5);
+    }
+}
+
 int main()
 {
     using boost::spirit::x3::tst;
     using boost::spirit::x3::tst_map;
+    using boost::spirit::x3::frozen_tst;
 
     tests<tst<char, int>, tst<wchar_t, int> >();
-//~    tests<tst_map<char, int>, tst_map<wchar_t, int> >();
+    tests<frozen_tst<char, int>, frozen_tst<wchar_t, int> >();
+    frozen_tests<frozen_tst<char, int>, frozen_tst<wchar_t, int> >();
+    tests<tst_map<char, int>, tst_map<wchar_t, int> >();
 
     return boost::report_errors();
 }
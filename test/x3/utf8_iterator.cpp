@@ -0,0 +1,158 @@
+/*=============================================================================
+    Copyright (c) 2001-2015 Joel de Guzman
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+=============================================================================*/
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/char/unicode.hpp>
+#include <boost/spirit/home/x3/support/utility/utf8_iterator.hpp>
+
+#include <string>
+#include <vector>
+
+namespace x3 = boost::spirit::x3;
+
+template <typename Iterator>
+x3::ucs4_string decode(Iterator first, Iterator last)
+{
+    auto const view = x3::make_utf8_view(first, last);
+    return x3::ucs4_string(view.begin(), view.end());
+}
+
+x3::ucs4_string decode(std::string const& s)
+{
+    auto const view = x3::make_utf8_view(s);
+    return x3::ucs4_string(view.begin(), view.end());
+}
+
+template <typename Tag, typename Context>
+bool ascii_agrees(x3::unicode_char_class<Tag> const& p, Context const& ctx)
+{
+    for (x3::ucs4_char ch = 0; ch != 0x80; ++ch)
+    {
+        if (p.test(ch, ctx) != x3::unicode_char_class_base::is(Tag(), ch))
+            return false;
+    }
+    return true;
+}
+
+int
+main()
+{
+    x3::ucs4_char const fffd = 0xFFFD;
+
+    {   // well formed input, through pointers and through other iterators
+        std::string const s = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z";
+        x3::ucs4_string const expected = { 'a', 0xE9, 0x20AC, 0x1F600, 'z' };
+        BOOST_TEST(decode(s) == expected);
+        BOOST_TEST(decode(s.begin(), s.end()) == expected);
+        BOOST_TEST(decode(std::string()).empty());
+    }
+
+    {   // ill-formed input decodes to U+FFFD, once per maximal subpart
+        BOOST_TEST(decode(std::string("\xC0\x80")) == x3::ucs4_string(2, fffd));
+        BOOST_TEST(decode(std::string("\xED\xA0\x80")) == x3::ucs4_string(3, fffd));
+        BOOST_TEST(decode(std::string("\xF4\x90\x80\x80")) == x3::ucs4_string(4, fffd));
+        BOOST_TEST(decode(std::string("\xE2\x82")) == x3::ucs4_string(1, fffd));
+        BOOST_TEST(decode(std::string("\xE2\x82x"))
+            == (x3::ucs4_string{ fffd, 'x' }));
+        BOOST_TEST(decode(std::string("\xFF" "a")) == (x3::ucs4_string{ fffd, 'a' }));
+    }
+
+    {   // long ASCII runs, with code points between and at the ends
+        std::string s;
+        x3::ucs4_string expected;
+        for (int i = 0; i != 200; ++i)
+        {
+            for (int j = 0; j != i % 70; ++j)
+            {
+                s += char('a' + j % 26);
+                expected += x3::ucs4_char('a' + j % 26);
+            }
+            s += "\xD0\x96";            // U+0416
+            expected += 0x416;
+        }
+        BOOST_TEST(decode(s) == expected);
+        BOOST_TEST(decode(s.begin(), s.end()) == expected);
+    }
+
+    {   // parsing UTF-8 with the unicode char parsers
+        using x3::unicode::alpha;
+        using x3::unicode::space;
+
+        std::string const input = "gr\xC3\xBC\xC3\x9F" "e \xD0\xBC\xD0\xB8\xD1\x80 42";
+        auto const view = x3::make_utf8_view(input);
+        auto first = view.begin();
+
+        std::vector<x3::ucs4_string> words;
+        BOOST_TEST(x3::phrase_parse(first, view.end()
+          , +x3::lexeme[+alpha] >> x3::omit[x3::int_], space, words));
+        BOOST_TEST(first == view.end());
+        BOOST_TEST_EQ(words.size(), 2u);
+        BOOST_TEST((words[1] == x3::ucs4_string{ 0x43C, 0x438, 0x440 }));
+
+        first = view.begin();
+        x3::ucs4_string word;
+        BOOST_TEST(x3::parse(first, view.end(), +alpha, word));
+        BOOST_TEST((word == x3::ucs4_string{ 'g', 'r', 0xFC, 0xDF, 'e' }));
+        BOOST_TEST_EQ(first.base() - input.data(), 7);
+    }
+
+    {   // the ASCII bitmaps agree with the UCD tables
+        x3::unused_type const ctx;
+        BOOST_TEST(ascii_agrees(x3::unicode::alnum, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::alpha, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::digit, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::xdigit, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::cntrl, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::graph, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::lower, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::print, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::punct, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::space, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::blank, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::upper, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::letter, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::number, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::separator, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::other, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::punctuation, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::symbol, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::uppercase_letter, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::lowercase_letter, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::decimal_number, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::space_separator, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::control, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::dash_punctuation, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::open_punctuation, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::close_punctuation, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::connector_punctuation, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::other_punctuation, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::math_symbol, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::currency_symbol, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::modifier_symbol, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::alphabetic, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::uppercase, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::lowercase, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::white_space, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::hex_digit, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::latin, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::common, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::greek, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::mark, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::unknown, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::noncharacter_code_point, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::default_ignorable_code_point, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::titlecase_letter, ctx));
+        BOOST_TEST(ascii_agrees(x3::unicode::format, ctx));
+
+        BOOST_TEST(x3::unicode::alpha.test(x3::ucs4_char(0x416), ctx));
+        BOOST_TEST(!x3::unicode::digit.test(x3::ucs4_char(0x416), ctx));
+        BOOST_TEST(x3::unicode::alpha.test('x', ctx));
+        BOOST_TEST(x3::unicode::alpha.test(L'x', ctx));
+    }
+
+    return boost::report_errors();
+}
@@ -8,12 +8,42 @@
 #include <boost/spirit/include/karma.hpp>
 #include <boost/format.hpp>
 
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 
+#if defined(__has_include)
+# if __has_include(<charconv>) && __cplusplus >= 201703L
+#  include <charconv>
+# endif
+#endif
+
 #include "../high_resolution_timer.hpp"
 
 #define NUMITERATIONS 1000000
 
+///////////////////////////////////////////////////////////////////////////////
+// The shortest round trip conversions are compared on varied doubles: the
+// number of digits they generate depends on the value.
+#define NUMVALUES 1000
+
+double values[NUMVALUES];
+
+void init_values()
+{
+    // a fixed pseudo-random mix of signs, magnitudes and digit counts
+    unsigned long state = 12345;
+    for (int i = 0; i < NUMVALUES; ++i) {
+        state = (state * 1103515245UL + 12345UL) & 0x7fffffffUL;
+        double const mantissa = 1. + state / double(0x7fffffffUL) * 9.;
+        int const digits = int(state % 17) + 1;
+        double const scale = std::pow(10., double(digits - 1));
+        double d = std::floor(mantissa * scale) / scale;
+        d *= std::pow(10., double(int(state % 41) - 20));
+        values[i] = (state & 0x100) ? -d : d;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // We generate plain floating point numbers in this test
 //[karma_double_performance_definitions
@@ -105,6 +135,46 @@ void format_performance_string()
 //     std::cout << generated << std::endl;
 }
 
+void format_performance_karma_varied()
+{
+    using boost::spirit::karma::generate;
+
+    char buffer[256];
+    util::high_resolution_timer t;
+    for (int i = 0; i < NUMITERATIONS; ++i) {
+        char *p = buffer;
+        generate(p, double_, values[i % NUMVALUES]);
+        *p = '\0';
+    }
+
+    std::cout << "karma (varied):\t" << t.elapsed() << std::endl;
+}
+
+void format_performance_karma_shortest()
+{
+    using boost::spirit::karma::generate;
+
+    //[karma_double_performance_shortest
+    typedef boost::spirit::karma::real_generator<
+        double, boost::spirit::karma::shortest_real_policies<double>
+    > shortest_type;
+    shortest_type const shortest_double = shortest_type();
+
+    char buffer[256];
+    //<-
+    util::high_resolution_timer t;
+    //->
+    for (int i = 0; i < NUMITERATIONS; ++i) {
+        char *p = buffer;
+        generate(p, shortest_double, values[i % NUMVALUES]);
+        *p = '\0';
+    }
+    //]
+
+    std::cout << "karma (shortest):\t" << t.elapsed() << std::endl;
+//     std::cout << buffer << std::endl;
+}
+
 // Boost.Format  
 void format_performance_boost_format()
 {
@@ -137,6 +207,39 @@ void format_performance_sprintf()
 //     std::cout << buffer << std::endl;
 }
 
+void format_performance_sprintf_roundtrip()
+{
+    util::high_resolution_timer t;
+
+    // the shortest precision which always round trips
+    char buffer[256];
+    for (int i = 0; i < NUMITERATIONS; ++i) {
+        sprintf(buffer, "%.17g", values[i % NUMVALUES]);
+    }
+
+    std::cout << "sprintf (%.17g):\t" << t.elapsed() << std::endl;
+//     std::cout << buffer << std::endl;
+}
+
+#if defined(__cpp_lib_to_chars)
+void format_performance_to_chars()
+{
+    util::high_resolution_timer t;
+
+    // std::to_chars without a precision generates the shortest round trip
+    // representation
+    char buffer[256];
+    for (int i = 0; i < NUMITERATIONS; ++i) {
+        char *p = std::to_chars(buffer, buffer + sizeof(buffer)
+          , values[i % NUMVALUES]).ptr;
+        *p = '\0';
+    }
+
+    std::cout << "std::to_chars:\t" << t.elapsed() << std::endl;
+//     std::cout << buffer << std::endl;
+}
+#endif
+
 void format_performance_iostreams()
 {
     //[karma_double_performance_iostreams
@@ -157,13 +260,21 @@ void format_performance_iostreams()
 ///////////////////////////////////////////////////////////////////////////////
 int main()
 {
+    init_values();
+
     format_performance_sprintf();
+    format_performance_sprintf_roundtrip();
+#if defined(__cpp_lib_to_chars)
+    format_performance_to_chars();
+#endif
     format_performance_iostreams();
     format_performance_boost_format();
     format_performance_karma();
     format_performance_string();
     format_performance_rule();
     format_performance_direct();
+    format_performance_karma_varied();
+    format_performance_karma_shortest();
     return 0;
 }
 
@@ -4,6 +4,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <climits>
+#include <cstdio>
 #include <cstdlib>
 
 #include <iostream> 
@@ -12,6 +13,12 @@
 
 #include "../high_resolution_timer.hpp"
 
+#if defined(__has_include)
+# if __has_include(<charconv>) && __cplusplus >= 201703L
+#  include <charconv>
+# endif
+#endif
+
 //  This value specifies, how to unroll the integer string generation loop in 
 //  Karma.
 //      Set this to some integer in between 0 (no unrolling) and max expected 
@@ -48,6 +55,7 @@ int main()
     std::vector<int> v (MAX_ITERATION);
     std::generate(v.begin(), v.end(), random_fill()); // randomly fill the vector
 
+#if defined(_WIN32)
     // test the C libraries ltoa function (the most low level function for
     // string conversion available)
     {
@@ -68,6 +76,38 @@ int main()
 
         cout << "ltoa:\t\t" << t.elapsed() << " [s]" << flush << endl;
     }
+#endif
+
+    // test the C libraries sprintf function
+    {
+        char buffer[65]; // we don't expect more than 64 bytes to be generated here
+        std::string str;
+        util::high_resolution_timer t;
+        for (int i = 0; i < MAX_ITERATION; ++i)
+        {
+            sprintf(buffer, "%d", v[i]);
+            str = buffer;      // compensate for string ops in other benchmarks
+        }
+
+        cout << "sprintf:\t" << t.elapsed() << " [s]" << flush << endl;
+    }
+
+#if defined(__cpp_lib_to_chars)
+    // test std::to_chars
+    {
+        char buffer[65]; // we don't expect more than 64 bytes to be generated here
+        std::string str;
+        util::high_resolution_timer t;
+        for (int i = 0; i < MAX_ITERATION; ++i)
+        {
+            char *ptr = std::to_chars(buffer, buffer + sizeof(buffer), v[i]).ptr;
+            *ptr = '\0';
+            str = buffer;      // compensate for string ops in other benchmarks
+        }
+
+        cout << "std::to_chars:\t" << t.elapsed() << " [s]" << flush << endl;
+    }
+#endif
 
     // test the iostreams library
     {
@@ -124,6 +164,22 @@ int main()
         cout << "int_:\t\t" << t.elapsed() << " [s]" << flush << endl;
     }
 
+    // test the Karma int_ generation routines through an output_iterator
+    // tracking the position, as used by the alignment directives
+    {
+        std::string str;
+        util::high_resolution_timer t;
+
+        for (int i = 0; i < MAX_ITERATION; ++i)
+        {
+            str.clear();
+            std::back_insert_iterator<std::string> sink(str);
+            karma::generate(sink, karma::right_align(12)[int_], v[i]);
+        }
+
+        cout << "int_ (aligned):\t" << t.elapsed() << " [s]" << flush << endl;
+    }
+
     return 0;
 }
 
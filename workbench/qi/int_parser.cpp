@@ -9,6 +9,7 @@
 #include <vector>
 #include <cstdlib>
 #include <boost/spirit/include/qi.hpp>
+#include <boost/spirit/home/x3.hpp>
 
 namespace
 {
@@ -31,6 +32,11 @@ namespace
     char const* first[9];
     char const* last[9];
 
+    // long long numbers with 10 .. 18 digits
+    std::string long_numbers[9];
+    char const* long_first[9];
+    char const* long_last[9];
+
     ///////////////////////////////////////////////////////////////////////////
     struct atoi_test : test::base
     {
@@ -69,6 +75,82 @@ namespace
                 this->val += parse(first[i], last[i]);
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct x3_int_test : test::base
+    {
+        static int parse(char const* first, char const* last)
+        {
+            int n;
+            namespace x3 = boost::spirit::x3;
+            x3::parse(first, last, x3::int_, n);
+            return n;
+        }
+
+        void benchmark()
+        {
+            for (int i = 0; i < 9; ++i)
+                this->val += parse(first[i], last[i]);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct atoll_test : test::base
+    {
+        void benchmark()
+        {
+            for (int i = 0; i < 9; ++i)
+                this->val += static_cast<int>(atoll(long_first[i]));
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct strtoll_test : test::base
+    {
+        void benchmark()
+        {
+            for (int i = 0; i < 9; ++i)
+                this->val += static_cast<int>(strtoll(
+                    long_first[i], const_cast<char**>(&long_last[i]), 10));
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct spirit_long_long_test : test::base
+    {
+        static long long parse(char const* first, char const* last)
+        {
+            long long n;
+            namespace qi = boost::spirit::qi;
+            using qi::long_long;
+            qi::parse(first, last, long_long, n);
+            return n;
+        }
+
+        void benchmark()
+        {
+            for (int i = 0; i < 9; ++i)
+                this->val += static_cast<int>(parse(long_first[i], long_last[i]));
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct x3_long_long_test : test::base
+    {
+        static long long parse(char const* first, char const* last)
+        {
+            long long n;
+            namespace x3 = boost::spirit::x3;
+            x3::parse(first, last, x3::long_long, n);
+            return n;
+        }
+
+        void benchmark()
+        {
+            for (int i = 0; i < 9; ++i)
+                this->val += static_cast<int>(parse(long_first[i], long_last[i]));
+        }
+    };
 }
 
 int main()
@@ -89,14 +171,36 @@ int main()
             last[i]++;
         std::cout << i+1 << " digit number:" << numbers[i] << std::endl;
     }
+    for (int i = 0; i < 9; ++i)
+    {
+        long_numbers[i] = gen_int(i+10);
+        long_first[i] = long_numbers[i].c_str();
+        long_last[i] = long_first[i];
+        while (*long_last[i])
+            long_last[i]++;
+        std::cout << i+10 << " digit number:" << long_numbers[i] << std::endl;
+    }
     std::cout << "///////////////////////////////////////////////////////////////////////////" << std::endl;
 
-    BOOST_SPIRIT_TEST_BENCHMARK(
-        10000000,     // This is the maximum repetitions to execute
-        (atoi_test)
-        (strtol_test)
-        (spirit_int_test)
-    )
+    {
+        BOOST_SPIRIT_TEST_BENCHMARK(
+            10000000,     // This is the maximum repetitions to execute
+            (atoi_test)
+            (strtol_test)
+            (spirit_int_test)
+            (x3_int_test)
+        )
+    }
+
+    {
+        BOOST_SPIRIT_TEST_BENCHMARK(
+            10000000,     // This is the maximum repetitions to execute
+            (atoll_test)
+            (strtoll_test)
+            (spirit_long_long_test)
+            (x3_long_long_test)
+        )
+    }
     
     // This is ultimately responsible for preventing all the test code
     // from being optimized away.  Change this to return 0 and you
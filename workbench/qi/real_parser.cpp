@@ -7,8 +7,11 @@
 #include "../measure.hpp"
 #include <string>
 #include <vector>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <boost/spirit/include/qi.hpp>
+#include <boost/spirit/home/x3.hpp>
 
 namespace
 {   
@@ -29,6 +32,11 @@ namespace
     char const* first[ndigits];
     char const* last[ndigits];
 
+    // round trip corpus: pseudo-random doubles printed with %.17g
+    int const nroundtrip = 1000;
+    std::string roundtrip[nroundtrip];
+    double roundtrip_values[nroundtrip];
+
     ///////////////////////////////////////////////////////////////////////////
     struct atof_test : test::base
     {
@@ -76,6 +84,99 @@ namespace
             }
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct x3_double_test : test::base
+    {
+        static double parse(char const* first, char const* last)
+        {
+            double n;
+            namespace x3 = boost::spirit::x3;
+            x3::parse(first, last, x3::double_, n);
+            return n;
+        }
+
+        void benchmark()
+        {
+            for (int i = 0; i < ndigits; ++i)
+            {
+                double d = parse(first[i], last[i]);
+                this->val += *reinterpret_cast<int*>(&d);
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct x3_fast_double_test : test::base
+    {
+        static double parse(char const* first, char const* last)
+        {
+            double n;
+            namespace x3 = boost::spirit::x3;
+            x3::real_parser<double, x3::fast_real_policies<double> > fast_double;
+            x3::parse(first, last, fast_double, n);
+            return n;
+        }
+
+        void benchmark()
+        {
+            for (int i = 0; i < ndigits; ++i)
+            {
+                double d = parse(first[i], last[i]);
+                this->val += *reinterpret_cast<int*>(&d);
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //  Round trip: parse back what printf("%.17g") produced
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Parser>
+    struct roundtrip_test : test::base
+    {
+        roundtrip_test() : index(0) {}
+
+        void benchmark()
+        {
+            for (int i = 0; i < ndigits; ++i)
+            {
+                std::string const& s = roundtrip[index];
+                if (++index == nroundtrip)
+                    index = 0;
+                double d = Parser::parse(s.c_str(), s.c_str() + s.size());
+                this->val += *reinterpret_cast<int*>(&d);
+            }
+        }
+
+        int index;
+    };
+
+    struct strtod_parser
+    {
+        static double parse(char const* first, char const*)
+        {
+            return strtod(first, 0);
+        }
+    };
+
+    typedef roundtrip_test<strtod_parser> strtod_roundtrip_test;
+    typedef roundtrip_test<spirit_double_test> spirit_double_roundtrip_test;
+    typedef roundtrip_test<x3_double_test> x3_double_roundtrip_test;
+    typedef roundtrip_test<x3_fast_double_test> x3_fast_double_roundtrip_test;
+
+    template <typename Parser>
+    int count_exact_roundtrips()
+    {
+        int exact = 0;
+        for (int i = 0; i < nroundtrip; ++i)
+        {
+            char const* f = roundtrip[i].c_str();
+            double d = Parser::parse(f, f + roundtrip[i].size());
+            if (std::memcmp(&d, &roundtrip_values[i], sizeof(d)) == 0)
+                ++exact;
+        }
+        return exact;
+    }
 }
 
 int main()
@@ -92,23 +193,65 @@ int main()
     }
     std::cout.precision(17);
     std::cout << "///////////////////////////////////////////////////////////////////////////" << std::endl;
-    std::cout << "atof/strtod/qi.double results:" << std::endl;
+    std::cout << "atof/strtod/qi.double/x3.double/x3.fast_double results:" << std::endl;
     for (int i = 0; i < ndigits; ++i)
     {
         std::cout 
             << atof(first[i]) << ','
             << strtod(first[i], const_cast<char**>(&last[i])) << ','
             << spirit_double_test::parse(first[i], last[i]) << ','
+            << x3_double_test::parse(first[i], last[i]) << ','
+            << x3_fast_double_test::parse(first[i], last[i]) << ','
             << std::endl;
     }
     std::cout << "///////////////////////////////////////////////////////////////////////////" << std::endl;
 
-    BOOST_SPIRIT_TEST_BENCHMARK(
-        10000000,     // This is the maximum repetitions to execute
-        (atof_test)
-        (strtod_test)
-        (spirit_double_test)
-    )
+    unsigned long long state = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < nroundtrip; ++i)
+    {
+        double d;
+        do
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            std::memcpy(&d, &state, sizeof(d));
+        }
+        while (d != d || d - d != 0);   // skip NaN and Inf
+
+        char buffer[32];
+        std::sprintf(buffer, "%.17g", d);
+        roundtrip[i] = buffer;
+        roundtrip_values[i] = d;
+    }
+    std::cout << "exact round trips out of " << nroundtrip
+        << " (strtod/qi.double/x3.double/x3.fast_double): "
+        << count_exact_roundtrips<strtod_parser>() << '/'
+        << count_exact_roundtrips<spirit_double_test>() << '/'
+        << count_exact_roundtrips<x3_double_test>() << '/'
+        << count_exact_roundtrips<x3_fast_double_test>() << std::endl;
+    std::cout << "///////////////////////////////////////////////////////////////////////////" << std::endl;
+
+    {
+        BOOST_SPIRIT_TEST_BENCHMARK(
+            10000000,     // This is the maximum repetitions to execute
+            (atof_test)
+            (strtod_test)
+            (spirit_double_test)
+            (x3_double_test)
+            (x3_fast_double_test)
+        )
+    }
+
+    {
+        BOOST_SPIRIT_TEST_BENCHMARK(
+            10000000,     // This is the maximum repetitions to execute
+            (strtod_roundtrip_test)
+            (spirit_double_roundtrip_test)
+            (x3_double_roundtrip_test)
+            (x3_fast_double_roundtrip_test)
+        )
+    }
     
     // This is ultimately responsible for preventing all the test code
     // from being optimized away.  Change this to return 0 and you
@@ -0,0 +1,374 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_WORKBENCH_CORPUS_HPP)
+#define BOOST_SPIRIT_WORKBENCH_CORPUS_HPP
+
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+//  Corpus generators shared by the benchmarks. All corpora are generated
+//  from a fixed seed with our own generator, so they are identical across
+//  platforms and releases, and built on first use only.
+///////////////////////////////////////////////////////////////////////////////
+namespace suite
+{
+    typedef std::pair<char const*, char const*> range;
+
+    // 32-bit xorshift, fixed seed
+    struct random
+    {
+        explicit random(boost::uint32_t seed = 2463534242u) : x(seed) {}
+
+        boost::uint32_t operator()()
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            return x;
+        }
+
+        // uniform in [0, n)
+        unsigned operator()(unsigned n)
+        {
+            return (*this)() % n;
+        }
+
+        boost::uint32_t x;
+    };
+
+    // A text of space separated items plus the ranges of the items
+    struct corpus
+    {
+        std::string text;
+        std::vector<range> items;
+
+        void add(std::string const& item)
+        {
+            offsets.push_back(std::make_pair(text.size(), item.size()));
+            text += item;
+            text += ' ';
+        }
+
+        // call after the last add(), text does not change anymore
+        void finish()
+        {
+            char const* base = text.data();
+            for (std::size_t i = 0; i != offsets.size(); ++i)
+            {
+                items.push_back(range(base + offsets[i].first
+                  , base + offsets[i].first + offsets[i].second));
+            }
+            offsets.clear();
+        }
+
+    private:
+        std::vector<std::pair<std::size_t, std::size_t> > offsets;
+    };
+
+    std::size_t const corpus_items = 100000;
+
+    // Decimal integers with 1 to 9 digits, about half of them negative
+    inline corpus const& ints()
+    {
+        static corpus c;
+        if (c.items.empty())
+        {
+            random rnd(1);
+            for (std::size_t i = 0; i != corpus_items; ++i)
+            {
+                std::string s;
+                if (rnd(2))
+                    s += '-';
+                int digits = 1 + rnd(9);
+                s += char('1' + rnd(9));
+                for (int d = 1; d < digits; ++d)
+                    s += char('0' + rnd(10));
+                c.add(s);
+            }
+            c.finish();
+        }
+        return c;
+    }
+
+    // The values of ints()
+    inline std::vector<int> const& int_values()
+    {
+        static std::vector<int> v;
+        if (v.empty())
+        {
+            corpus const& c = ints();
+            for (std::size_t i = 0; i != c.items.size(); ++i)
+                v.push_back(std::atoi(c.items[i].first));
+        }
+        return v;
+    }
+
+    // A mix of short decimals, exponents and %.17g round trip values
+    inline corpus const& reals()
+    {
+        static corpus c;
+        if (c.items.empty())
+        {
+            random rnd(2);
+            char buffer[64];
+            for (std::size_t i = 0; i != corpus_items; ++i)
+            {
+                double mantissa = double(rnd()) / 4294967296.0;
+                switch (rnd(3))
+                {
+                case 0:
+                    std::sprintf(buffer, "%.2f", mantissa * 10000.0);
+                    break;
+                case 1:
+                    std::sprintf(buffer, "%.6e"
+                      , mantissa * (rnd(2) ? 1e100 : 1e-100));
+                    break;
+                default:
+                    std::sprintf(buffer, "%.17g", (rnd(2) ? -1 : 1) *
+                        mantissa * double(rnd(1000000)));
+                    break;
+                }
+                c.add(buffer);
+            }
+            c.finish();
+        }
+        return c;
+    }
+
+    // The values of reals()
+    inline std::vector<double> const& real_values()
+    {
+        static std::vector<double> v;
+        if (v.empty())
+        {
+            corpus const& c = reals();
+            for (std::size_t i = 0; i != c.items.size(); ++i)
+                v.push_back(std::strtod(c.items[i].first, 0));
+        }
+        return v;
+    }
+
+    inline std::string random_identifier(random& rnd, std::size_t min_length
+      , std::size_t max_length)
+    {
+        static char const alnum[] =
+            "abcdefghijklmnopqrstuvwxyz_0123456789";
+        std::size_t length = min_length + rnd(unsigned(max_length - min_length + 1));
+        std::string s(1, alnum[rnd(27)]);
+        while (s.size() < length)
+            s += alnum[rnd(37)];
+        return s;
+    }
+
+    // The keywords of the symbols() corpus
+    inline std::vector<std::string> const& keywords()
+    {
+        static std::vector<std::string> v;
+        if (v.empty())
+        {
+            random rnd(3);
+            while (v.size() != 1000)
+                v.push_back(random_identifier(rnd, 2, 16));
+        }
+        return v;
+    }
+
+    // Words from keywords(), one in ten of them not a keyword
+    inline corpus const& symbols()
+    {
+        static corpus c;
+        if (c.items.empty())
+        {
+            random rnd(4);
+            std::vector<std::string> const& kw = keywords();
+            for (std::size_t i = 0; i != corpus_items; ++i)
+            {
+                if (rnd(10) == 0)
+                    c.add(random_identifier(rnd, 2, 16) + "#");
+                else
+                    c.add(kw[rnd(unsigned(kw.size()))]);
+            }
+            c.finish();
+        }
+        return c;
+    }
+
+    // Double quoted strings, some with \" and \\ escapes
+    inline corpus const& strings()
+    {
+        static corpus c;
+        if (c.items.empty())
+        {
+            random rnd(5);
+            static char const chars[] =
+                "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ.,;:!?";
+            for (std::size_t i = 0; i != corpus_items; ++i)
+            {
+                std::string s = "\"";
+                std::size_t length = rnd(40);
+                for (std::size_t j = 0; j != length; ++j)
+                {
+                    switch (rnd(32))
+                    {
+                    case 0: s += "\\\""; break;
+                    case 1: s += "\\\\"; break;
+                    default: s += chars[rnd(sizeof(chars) - 1)]; break;
+                    }
+                }
+                s += '"';
+                c.add(s);
+            }
+            c.finish();
+        }
+        return c;
+    }
+
+    namespace detail
+    {
+        inline void json_value(std::string& out, random& rnd, int depth)
+        {
+            unsigned kind = depth > 4 ? 2 + rnd(4) : rnd(6);
+            switch (kind)
+            {
+            case 0:
+                {
+                    out += '{';
+                    unsigned n = 1 + rnd(6);
+                    for (unsigned i = 0; i != n; ++i)
+                    {
+                        if (i)
+                            out += ", ";
+                        out += '"';
+                        out += random_identifier(rnd, 3, 12);
+                        out += "\": ";
+                        json_value(out, rnd, depth + 1);
+                    }
+                    out += '}';
+                }
+                break;
+            case 1:
+                {
+                    out += '[';
+                    unsigned n = rnd(8);
+                    for (unsigned i = 0; i != n; ++i)
+                    {
+                        if (i)
+                            out += ", ";
+                        json_value(out, rnd, depth + 1);
+                    }
+                    out += ']';
+                }
+                break;
+            case 2:
+                {
+                    char buffer[32];
+                    std::sprintf(buffer, "%d", int(rnd(2000000)) - 1000000);
+                    out += buffer;
+                }
+                break;
+            case 3:
+                {
+                    char buffer[32];
+                    std::sprintf(buffer, "%.6g"
+                      , double(rnd()) / double(1 + rnd(100000)));
+                    out += buffer;
+                }
+                break;
+            case 4:
+                out += '"';
+                out += random_identifier(rnd, 0, 24);
+                out += '"';
+                break;
+            default:
+                {
+                    static char const* literals[] = { "true", "false", "null" };
+                    out += literals[rnd(3)];
+                }
+                break;
+            }
+        }
+    }
+
+    // A JSON document of about 2 MB: an array of random records
+    inline std::string const& json()
+    {
+        static std::string s;
+        if (s.empty())
+        {
+            random rnd(6);
+            s += "[\n";
+            for (std::size_t i = 0; s.size() < 2 * 1024 * 1024; ++i)
+            {
+                if (i)
+                    s += ",\n";
+                s += "  ";
+                detail::json_value(s, rnd, 0);
+            }
+            s += "\n]\n";
+        }
+        return s;
+    }
+
+    // About 2 MB of C-like source text: identifiers, numbers, operators,
+    // whitespace and comments
+    inline std::string const& source()
+    {
+        static std::string s;
+        if (s.empty())
+        {
+            random rnd(7);
+            static char const* operators[] = {
+                "+", "-", "*", "/", "=", "==", "<", "<=", "(", ")", "{", "}"
+              , ";", ","
+            };
+            char buffer[32];
+            while (s.size() < 2 * 1024 * 1024)
+            {
+                switch (rnd(8))
+                {
+                case 0: case 1: case 2:
+                    s += random_identifier(rnd, 1, 12);
+                    break;
+                case 3:
+                    std::sprintf(buffer, "%u", rnd(100000));
+                    s += buffer;
+                    break;
+                case 4: case 5:
+                    // the blank keeps "/" "*" from starting a comment
+                    s += operators[rnd(sizeof(operators)/sizeof(operators[0]))];
+                    s += ' ';
+                    break;
+                case 6:
+                    s += rnd(4) ? " " : "\n    ";
+                    break;
+                default:
+                    if (rnd(8) == 0)
+                    {
+                        s += "/* ";
+                        s += random_identifier(rnd, 10, 40);
+                        s += " */";
+                    }
+                    else
+                    {
+                        s += ' ';
+                    }
+                    break;
+                }
+            }
+            s += '\n';
+        }
+        return s;
+    }
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+///////////////////////////////////////////////////////////////////////////////
+//  Generator output: integers and floating point numbers into a character
+//  buffer, and a list of records into a std::string
+///////////////////////////////////////////////////////////////////////////////
+#include "suite.hpp"
+#include "corpus.hpp"
+
+#include <boost/spirit/include/karma.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+# if __has_include(<charconv>) && __cplusplus >= 201703L
+#  include <charconv>
+# endif
+#endif
+
+namespace karma = boost::spirit::karma;
+
+namespace
+{
+    template <typename Generator, typename T>
+    void generate_all(std::vector<T> const& v, Generator const& g
+      , suite::state& state)
+    {
+        char buffer[128];
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            char* p = buffer;
+            karma::generate(p, g, v[i]);
+            state.bytes += p - buffer;
+            state.checksum += buffer[0];
+        }
+        state.items += v.size();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(sprintf_int, "gen_int", "baseline")
+{
+    std::vector<int> const& v = suite::int_values();
+    char buffer[128];
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        state.bytes += std::sprintf(buffer, "%d", v[i]);
+        state.checksum += buffer[0];
+    }
+    state.items += v.size();
+}
+
+#if defined(__cpp_lib_to_chars)
+BOOST_SPIRIT_BENCHMARK(to_chars_int, "gen_int", "baseline")
+{
+    std::vector<int> const& v = suite::int_values();
+    char buffer[128];
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        char* p = std::to_chars(buffer, buffer + sizeof(buffer), v[i]).ptr;
+        state.bytes += p - buffer;
+        state.checksum += buffer[0];
+    }
+    state.items += v.size();
+}
+#endif
+
+BOOST_SPIRIT_BENCHMARK(karma_int, "gen_int", "karma")
+{
+    generate_all(suite::int_values(), karma::int_, state);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(sprintf_double, "gen_real", "baseline")
+{
+    std::vector<double> const& v = suite::real_values();
+    char buffer[128];
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        state.bytes += std::sprintf(buffer, "%.17g", v[i]);
+        state.checksum += buffer[0];
+    }
+    state.items += v.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(karma_double, "gen_real", "karma")
+{
+    generate_all(suite::real_values(), karma::double_, state);
+}
+
+BOOST_SPIRIT_BENCHMARK(karma_double_shortest, "gen_real", "karma")
+{
+    karma::real_generator<double, karma::shortest_real_policies<double> > const
+        shortest_double;
+    generate_all(suite::real_values(), shortest_double, state);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Records "key = value;" with right aligned values, into a std::string
+BOOST_SPIRIT_BENCHMARK(sprintf_records, "gen_records", "baseline")
+{
+    std::vector<int> const& v = suite::int_values();
+    std::vector<std::string> const& keys = suite::keywords();
+    std::string out;
+    char buffer[128];
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        int n = std::sprintf(buffer, "%s = %12d;\n"
+          , keys[i % keys.size()].c_str(), v[i]);
+        out.append(buffer, n);
+    }
+    state.bytes += out.size();
+    state.items += v.size();
+    state.checksum += out.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(karma_records, "gen_records", "karma")
+{
+    using karma::int_;
+    using karma::string;
+    using karma::right_align;
+
+    std::vector<int> const& v = suite::int_values();
+    std::vector<std::string> const& keys = suite::keywords();
+    std::string out;
+    std::back_insert_iterator<std::string> sink(out);
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        karma::generate(sink
+          , string << " = " << right_align(12)[int_] << ";\n"
+          , keys[i % keys.size()], v[i]);
+    }
+    state.bytes += out.size();
+    state.items += v.size();
+    state.checksum += out.size();
+}
@@ -0,0 +1,252 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+///////////////////////////////////////////////////////////////////////////////
+//  Recognizing a JSON document: the same grammar written with X3, Qi and as
+//  a hand-written recursive descent parser. Nothing is stored, so this
+//  measures the grammar machinery, skipping and the numeric parsers.
+///////////////////////////////////////////////////////////////////////////////
+#include "suite.hpp"
+#include "corpus.hpp"
+
+#include <boost/spirit/include/qi.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace qi = boost::spirit::qi;
+namespace x3 = boost::spirit::x3;
+
+///////////////////////////////////////////////////////////////////////////////
+namespace x3_json
+{
+    using x3::lit;
+    using x3::char_;
+    using x3::lexeme;
+    using x3::double_;
+
+    x3::rule<class value> const value = "value";
+    x3::rule<class object> const object = "object";
+    x3::rule<class array> const array = "array";
+    x3::rule<class string> const string = "string";
+
+    auto const value_def =
+            object
+        |   array
+        |   string
+        |   double_
+        |   lit("true")
+        |   lit("false")
+        |   lit("null")
+        ;
+
+    auto const object_def =
+        '{' >> -((string >> ':' >> value) % ',') >> '}';
+
+    auto const array_def =
+        '[' >> -(value % ',') >> ']';
+
+    auto const string_def =
+        lexeme['"' >> *(('\\' >> char_) | ~char_('"')) >> '"'];
+
+    BOOST_SPIRIT_DEFINE(value, object, array, string);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace qi_json
+{
+    typedef char const* iterator_type;
+
+    struct grammar : qi::grammar<iterator_type, qi::space_type>
+    {
+        grammar() : grammar::base_type(value)
+        {
+            using qi::lit;
+            using qi::char_;
+            using qi::lexeme;
+            using qi::double_;
+
+            value =
+                    object
+                |   array
+                |   string
+                |   double_
+                |   lit("true")
+                |   lit("false")
+                |   lit("null")
+                ;
+
+            object = '{' >> -((string >> ':' >> value) % ',') >> '}';
+            array = '[' >> -(value % ',') >> ']';
+            string = lexeme['"' >> *(('\\' >> char_) | ~char_('"')) >> '"'];
+        }
+
+        qi::rule<iterator_type, qi::space_type> value, object, array;
+        qi::rule<iterator_type> string;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hand_written_json
+{
+    class parser
+    {
+    public:
+        parser(char const* first, char const* last)
+          : first(first), last(last) {}
+
+        bool parse_document()
+        {
+            return value() && (skip(), first == last);
+        }
+
+    private:
+        void skip()
+        {
+            while (first != last && (*first == ' ' || *first == '\n' ||
+                    *first == '\t' || *first == '\r'))
+            {
+                ++first;
+            }
+        }
+
+        bool expect(char ch)
+        {
+            skip();
+            if (first == last || *first != ch)
+                return false;
+            ++first;
+            return true;
+        }
+
+        bool peek(char ch)
+        {
+            skip();
+            return first != last && *first == ch;
+        }
+
+        bool value()
+        {
+            skip();
+            if (first == last)
+                return false;
+
+            switch (*first)
+            {
+            case '{': return object();
+            case '[': return array();
+            case '"': return string();
+            case 't': return literal("true");
+            case 'f': return literal("false");
+            case 'n': return literal("null");
+            default: return number();
+            }
+        }
+
+        bool object()
+        {
+            ++first;
+            if (peek('}'))
+                return ++first, true;
+            do
+            {
+                skip();
+                if (!string() || !expect(':') || !value())
+                    return false;
+            }
+            while (expect(','));
+            return expect('}');
+        }
+
+        bool array()
+        {
+            ++first;
+            if (peek(']'))
+                return ++first, true;
+            do
+            {
+                if (!value())
+                    return false;
+            }
+            while (expect(','));
+            return expect(']');
+        }
+
+        bool string()
+        {
+            if (first == last || *first != '"')
+                return false;
+            for (++first; first != last; ++first)
+            {
+                if (*first == '"')
+                    return ++first, true;
+                if (*first == '\\' && ++first == last)
+                    break;
+            }
+            return false;
+        }
+
+        bool literal(char const* s)
+        {
+            std::size_t n = std::strlen(s);
+            if (std::size_t(last - first) < n || std::strncmp(first, s, n) != 0)
+                return false;
+            first += n;
+            return true;
+        }
+
+        bool number()
+        {
+            // the document is followed by a '\0', so strtod stops in time
+            char* end = 0;
+            std::strtod(first, &end);
+            if (end == first)
+                return false;
+            first = end;
+            return true;
+        }
+
+        char const* first;
+        char const* last;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(hand_written_json, "json", "baseline")
+{
+    std::string const& s = suite::json();
+    hand_written_json::parser p(s.data(), s.data() + s.size());
+    state.checksum += p.parse_document();
+    state.bytes += s.size();
+    state.items += 1;
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_json, "json", "x3")
+{
+    std::string const& s = suite::json();
+    char const* first = s.data();
+    char const* last = first + s.size();
+    state.checksum +=
+        x3::phrase_parse(first, last, x3_json::value, x3::space) &&
+        first == last;
+    state.bytes += s.size();
+    state.items += 1;
+}
+
+BOOST_SPIRIT_BENCHMARK(qi_json, "json", "qi")
+{
+    static qi_json::grammar const g;
+    std::string const& s = suite::json();
+    char const* first = s.data();
+    char const* last = first + s.size();
+    state.checksum +=
+        qi::phrase_parse(first, last, g, qi::space) && first == last;
+    state.bytes += s.size();
+    state.items += 1;
+}
@@ -0,0 +1,266 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+///////////////////////////////////////////////////////////////////////////////
+//  Tokenizing C-like source text: the lexertl tokenisers driven directly,
+//  a Spirit.Lex lexer and a hand-written scanner for the same tokens.
+//  Building the DFAs of a lexer with many states, serially and in parallel.
+///////////////////////////////////////////////////////////////////////////////
+#include "suite.hpp"
+#include "corpus.hpp"
+
+#include <boost/spirit/include/lex_lexertl.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/iterator_tokenizer.hpp>
+#include <boost/spirit/home/lex/lexer/lexertl/packed_iterator_tokenizer.hpp>
+#include <boost/spirit/home/support/detail/lexer/generator.hpp>
+#include <boost/spirit/home/support/detail/lexer/rules.hpp>
+#include <boost/spirit/home/support/detail/lexer/state_machine.hpp>
+#include <sstream>
+#include <string>
+
+namespace lex = boost::spirit::lex;
+
+namespace
+{
+    enum token_ids
+    {
+        id_identifier = 1,
+        id_number,
+        id_operator,
+        id_whitespace,
+        id_comment
+    };
+
+    char const* const identifier = "[a-zA-Z_][a-zA-Z0-9_]*";
+    char const* const number = "[0-9]+";
+    char const* const operator_ = "==|<=|[-+*/=<(){};,]";
+    char const* const whitespace = "[ \\t\\n]+";
+    char const* const comment = "\\/\\*[^*]*\\*+([^/*][^*]*\\*+)*\\/";
+
+    boost::lexer::basic_state_machine<char> const& state_machine()
+    {
+        static boost::lexer::basic_state_machine<char> sm;
+        if (sm.empty())
+        {
+            boost::lexer::basic_rules<char> rules;
+            rules.add(identifier, id_identifier);
+            rules.add(number, id_number);
+            rules.add(operator_, id_operator);
+            rules.add(whitespace, id_whitespace);
+            rules.add(comment, id_comment);
+            boost::lexer::basic_generator<char>::build(rules, sm);
+            boost::lexer::basic_generator<char>::minimise(sm);
+        }
+        return sm;
+    }
+
+    template <typename Tokeniser, typename StateMachine>
+    void tokenize_all(StateMachine const& sm, suite::state& state)
+    {
+        std::string const& s = suite::source();
+        char const* first = s.data();
+        char const* last = first + s.size();
+        bool bol = true;
+        std::size_t unique_id = 0;
+        while (true)
+        {
+            std::size_t id = Tokeniser::next(sm, bol, first, last, unique_id);
+            if (id == 0 || id == boost::lexer::npos)
+                break;
+            state.checksum += id;
+            ++state.items;
+        }
+        state.bytes += s.size();
+    }
+
+    template <typename Lexer>
+    struct source_tokens : lex::lexer<Lexer>
+    {
+        source_tokens()
+        {
+            this->self.add
+                (identifier, id_identifier)
+                (number, id_number)
+                (operator_, id_operator)
+                (whitespace, id_whitespace)
+                (comment, id_comment)
+            ;
+        }
+    };
+
+    // A lexer with 24 states (think of the modes of a templating language),
+    // each with its own keywords and large character class unions.
+    boost::lexer::basic_rules<char> const& large_rules()
+    {
+        static boost::lexer::basic_rules<char> rules;
+        if (rules.statemap().size() == 1)
+        {
+            std::size_t const states = 24;
+            for (std::size_t i = 1; i != states; ++i)
+            {
+                std::ostringstream name;
+                name << "MODE" << i;
+                rules.add_state(name.str().c_str());
+            }
+            for (std::size_t i = 0; i != states; ++i)
+            {
+                std::ostringstream name, next, keywords, word;
+                if (i == 0)
+                    name << "INITIAL";
+                else
+                    name << "MODE" << i;
+                next << "MODE" << (i + 1) % states;
+                if ((i + 1) % states == 0)
+                    next.str("INITIAL");
+
+                for (std::size_t k = 0; k != 40; ++k)
+                    keywords << (k ? "|" : "") << "k" << i << "_" << k << "x";
+                word << "[a-zA-Z_\\x80-\\xff" << char('!' + i % 10)
+                    << "][a-zA-Z0-9_\\x80-\\xff-]{0," << 8 + i % 8 << "}";
+
+                std::string const state = name.str();
+                rules.add(state.c_str(), keywords.str(), 100 + i, ".");
+                rules.add(state.c_str(), word.str(), id_identifier, ".");
+                rules.add(state.c_str(), "[0-9]+(\\.[0-9]+)?([eE][-+]?[0-9]+)?"
+                  , id_number, ".");
+                rules.add(state.c_str(), operator_, id_operator, ".");
+                rules.add(state.c_str(), whitespace, id_whitespace, ".");
+                rules.add(state.c_str(), comment, id_comment, ".");
+                rules.add(state.c_str(), "\\{%", id_operator
+                  , next.str().c_str());
+            }
+        }
+        return rules;
+    }
+
+    void count_states(boost::lexer::basic_state_machine<char> const& sm
+      , suite::state& state)
+    {
+        std::size_t const dfas = sm.data()._dfa->size();
+        for (std::size_t i = 0; i != dfas; ++i)
+            state.checksum += sm.data()._dfa[i]->size();
+        state.items += dfas;
+    }
+
+    struct count_token
+    {
+        count_token(suite::state& state) : state(state) {}
+
+        template <typename Token>
+        bool operator()(Token const& t) const
+        {
+            state.checksum += t.id();
+            ++state.items;
+            return true;
+        }
+
+        suite::state& state;
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(hand_written_scanner, "lex", "baseline")
+{
+    std::string const& s = suite::source();
+    char const* first = s.data();
+    char const* last = first + s.size();
+    while (first != last)
+    {
+        char const ch = *first;
+        std::size_t id = 0;
+        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_')
+        {
+            while (++first != last && ((*first >= 'a' && *first <= 'z') ||
+                (*first >= 'A' && *first <= 'Z') ||
+                (*first >= '0' && *first <= '9') || *first == '_'))
+            {
+            }
+            id = id_identifier;
+        }
+        else if (ch >= '0' && ch <= '9')
+        {
+            while (++first != last && *first >= '0' && *first <= '9')
+            {
+            }
+            id = id_number;
+        }
+        else if (ch == ' ' || ch == '\t' || ch == '\n')
+        {
+            while (++first != last &&
+                (*first == ' ' || *first == '\t' || *first == '\n'))
+            {
+            }
+            id = id_whitespace;
+        }
+        else if (ch == '/' && last - first > 1 && first[1] == '*')
+        {
+            first += 2;
+            while (first != last &&
+                !(*first == '*' && last - first > 1 && first[1] == '/'))
+            {
+                ++first;
+            }
+            if (first == last)
+                break;
+            first += 2;
+            id = id_comment;
+        }
+        else
+        {
+            if ((ch == '=' || ch == '<') && last - first > 1 && first[1] == '=')
+                ++first;
+            ++first;
+            id = id_operator;
+        }
+        state.checksum += id;
+        ++state.items;
+    }
+    state.bytes += s.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(lexertl_tokeniser, "lex", "lex")
+{
+    tokenize_all<lex::lexertl::basic_iterator_tokeniser<char const*> >(
+        state_machine(), state);
+}
+
+BOOST_SPIRIT_BENCHMARK(lexertl_packed_tokeniser, "lex", "lex")
+{
+    static lex::lexertl::packed_state_machine const sm(state_machine());
+    tokenize_all<lex::lexertl::basic_packed_iterator_tokeniser<char const*> >(
+        sm, state);
+}
+
+BOOST_SPIRIT_BENCHMARK(lex_lexer, "lex", "lex")
+{
+    typedef lex::lexertl::token<char const*, lex::omit, boost::mpl::false_>
+        token_type;
+    typedef lex::lexertl::lexer<token_type> lexer_type;
+
+    static source_tokens<lexer_type> const tokens;
+    std::string const& s = suite::source();
+    char const* first = s.data();
+    lex::tokenize(first, first + s.size(), tokens, count_token(state));
+    state.bytes += s.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(lexertl_build_serial, "lex_build", "lex")
+{
+    boost::lexer::basic_state_machine<char> sm;
+    boost::lexer::basic_generator<char>::build(large_rules(), sm);
+    boost::lexer::basic_generator<char>::minimise(sm);
+    count_states(sm, state);
+}
+
+BOOST_SPIRIT_BENCHMARK(lexertl_build_parallel, "lex_build", "lex")
+{
+    boost::lexer::basic_state_machine<char> sm;
+    boost::lexer::basic_generator<char>::build_parallel(large_rules(), sm
+      , true);
+    count_states(sm, state);
+}
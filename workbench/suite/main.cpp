@@ -0,0 +1,292 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+///////////////////////////////////////////////////////////////////////////////
+//  The benchmark suite driver. Usage:
+//
+//      benchmark [--format=text|csv|json] [--filter=substring]
+//                [--min-time=seconds]
+//
+//  Each benchmark is run once untimed (which also builds its corpus), then
+//  repeatedly for at least --min-time seconds. The results are reported per
+//  call: time, throughput and the number and size of heap allocations.
+///////////////////////////////////////////////////////////////////////////////
+#include "suite.hpp"
+#include "../high_resolution_timer.hpp"
+
+#include <boost/config.hpp>
+#include <boost/version.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+//  Allocation counting, operator new is also called from the threads of
+//  the parallel benchmarks. The replacements are not inlined, so that the
+//  compiler does not pair their std::free with the callers' new.
+namespace
+{
+    std::atomic<std::size_t> allocation_count(0);
+    std::atomic<std::size_t> allocation_bytes(0);
+}
+
+BOOST_NOINLINE void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+BOOST_NOINLINE void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+BOOST_NOINLINE void operator delete(void* p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+BOOST_NOINLINE void operator delete[](void* p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+BOOST_NOINLINE void operator delete(void* p, std::size_t)
+    BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+BOOST_NOINLINE void operator delete[](void* p, std::size_t)
+    BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+#endif
+
+namespace suite
+{
+    std::size_t allocations()
+    {
+        return allocation_count.load(std::memory_order_relaxed);
+    }
+
+    std::size_t allocated_bytes()
+    {
+        return allocation_bytes.load(std::memory_order_relaxed);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace
+{
+    struct result
+    {
+        suite::benchmark b;
+        std::size_t iterations;
+        double seconds;                 // per iteration
+        double bytes;                   // per iteration
+        double items;                   // per iteration
+        double allocations;             // per iteration
+        double allocated_bytes;         // per iteration
+        std::size_t checksum;
+    };
+
+    result run(suite::benchmark const& b, double min_time)
+    {
+        suite::state warm_up;
+        b.f(warm_up);
+
+        suite::state total;
+        std::size_t iterations = 0;
+        std::size_t const allocations = suite::allocations();
+        std::size_t const allocated_bytes = suite::allocated_bytes();
+
+        util::high_resolution_timer time;
+        double elapsed = 0;
+        do
+        {
+            b.f(total);
+            ++iterations;
+            elapsed = time.elapsed();
+        }
+        while (elapsed < min_time);
+
+        double const n = double(iterations);
+        result r;
+        r.b = b;
+        r.iterations = iterations;
+        r.seconds = elapsed / n;
+        r.bytes = double(total.bytes) / n;
+        r.items = double(total.items) / n;
+        r.allocations = double(suite::allocations() - allocations) / n;
+        r.allocated_bytes =
+            double(suite::allocated_bytes() - allocated_bytes) / n;
+        r.checksum = total.checksum;
+        return r;
+    }
+
+    bool less(suite::benchmark const& a, suite::benchmark const& b)
+    {
+        int c = std::strcmp(a.family, b.family);
+        if (c == 0)
+            c = std::strcmp(a.library, b.library);
+        if (c == 0)
+            c = std::strcmp(a.name, b.name);
+        return c < 0;
+    }
+
+    double per_second(double amount, double seconds)
+    {
+        return seconds > 0 ? amount / seconds : 0;
+    }
+
+    void print_text_header()
+    {
+        std::printf("%-28s %-11s %-9s %12s %10s %12s %10s %12s\n"
+          , "name", "family", "library", "time [us]", "MB/s", "items/s"
+          , "allocs", "alloc bytes");
+    }
+
+    void print_text(result const& r)
+    {
+        std::printf("%-28s %-11s %-9s %12.1f %10.1f %12.4g %10.1f %12.1f\n"
+          , r.b.name, r.b.family, r.b.library, r.seconds * 1e6
+          , per_second(r.bytes, r.seconds) / 1e6
+          , per_second(r.items, r.seconds)
+          , r.allocations, r.allocated_bytes);
+        std::fflush(stdout);
+    }
+
+    void print_csv(std::vector<result> const& results)
+    {
+        std::printf("name,family,library,iterations,seconds_per_iteration,"
+            "bytes_per_second,items_per_second,allocations_per_iteration,"
+            "allocated_bytes_per_iteration,checksum\n");
+        for (std::size_t i = 0; i != results.size(); ++i)
+        {
+            result const& r = results[i];
+            std::printf("%s,%s,%s,%lu,%.9g,%.9g,%.9g,%.9g,%.9g,%lu\n"
+              , r.b.name, r.b.family, r.b.library
+              , static_cast<unsigned long>(r.iterations), r.seconds
+              , per_second(r.bytes, r.seconds)
+              , per_second(r.items, r.seconds)
+              , r.allocations, r.allocated_bytes
+              , static_cast<unsigned long>(r.checksum));
+        }
+    }
+
+    void print_json(std::vector<result> const& results)
+    {
+        std::printf("{\n  \"context\": {\n");
+        std::printf("    \"compiler\": \"%s\",\n", BOOST_COMPILER);
+        std::printf("    \"boost_version\": %d\n", BOOST_VERSION);
+        std::printf("  },\n  \"benchmarks\": [");
+        for (std::size_t i = 0; i != results.size(); ++i)
+        {
+            result const& r = results[i];
+            std::printf("%s\n    {\"name\": \"%s\", \"family\": \"%s\", "
+                "\"library\": \"%s\", \"iterations\": %lu, "
+                "\"seconds_per_iteration\": %.9g, "
+                "\"bytes_per_second\": %.9g, \"items_per_second\": %.9g, "
+                "\"allocations_per_iteration\": %.9g, "
+                "\"allocated_bytes_per_iteration\": %.9g, "
+                "\"checksum\": %lu}"
+              , i ? "," : ""
+              , r.b.name, r.b.family, r.b.library
+              , static_cast<unsigned long>(r.iterations), r.seconds
+              , per_second(r.bytes, r.seconds)
+              , per_second(r.items, r.seconds)
+              , r.allocations, r.allocated_bytes
+              , static_cast<unsigned long>(r.checksum));
+        }
+        std::printf("\n  ]\n}\n");
+    }
+
+    bool option(char const* arg, char const* name, std::string& value)
+    {
+        std::size_t const n = std::strlen(name);
+        if (std::strncmp(arg, name, n) != 0 || arg[n] != '=')
+            return false;
+        value = arg + n + 1;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string format = "text";
+    std::string filter;
+    double min_time = 0.5;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (option(argv[i], "--format", value))
+        {
+            format = value;
+        }
+        else if (option(argv[i], "--filter", value))
+        {
+            filter = value;
+        }
+        else if (option(argv[i], "--min-time", value))
+        {
+            min_time = std::atof(value.c_str());
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--format=text|csv|json]"
+                " [--filter=substring] [--min-time=seconds]" << std::endl;
+            return -1;
+        }
+    }
+
+    if (format != "text" && format != "csv" && format != "json")
+    {
+        std::cerr << "unknown format: " << format << std::endl;
+        return -1;
+    }
+
+    std::vector<suite::benchmark> benchmarks = suite::registry();
+    std::sort(benchmarks.begin(), benchmarks.end(), less);
+
+    if (format == "text")
+        print_text_header();
+
+    std::vector<result> results;
+    for (std::size_t i = 0; i != benchmarks.size(); ++i)
+    {
+        suite::benchmark const& b = benchmarks[i];
+        std::string const id =
+            std::string(b.family) + "/" + b.library + "/" + b.name;
+        if (!filter.empty() && id.find(filter) == std::string::npos)
+            continue;
+
+        results.push_back(run(b, min_time));
+        if (format == "text")
+            print_text(results.back());
+    }
+
+    if (format == "csv")
+        print_csv(results);
+    else if (format == "json")
+        print_json(results);
+
+    return 0;
+}
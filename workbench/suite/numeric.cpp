@@ -0,0 +1,114 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+///////////////////////////////////////////////////////////////////////////////
+//  Parsing of single integers and floating point numbers
+///////////////////////////////////////////////////////////////////////////////
+#include "suite.hpp"
+#include "corpus.hpp"
+
+#include <boost/spirit/include/qi.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <cstdlib>
+
+namespace qi = boost::spirit::qi;
+namespace x3 = boost::spirit::x3;
+
+namespace
+{
+    template <typename Parser, typename T>
+    void parse_all(suite::corpus const& c, Parser const& p, T& sum
+      , suite::state& state)
+    {
+        for (std::size_t i = 0; i != c.items.size(); ++i)
+        {
+            char const* first = c.items[i].first;
+            T n = 0;
+            x3::parse(first, c.items[i].second, p, n);
+            sum += n;
+        }
+        state.bytes += c.text.size();
+        state.items += c.items.size();
+    }
+
+    template <typename Parser, typename T>
+    void qi_parse_all(suite::corpus const& c, Parser const& p, T& sum
+      , suite::state& state)
+    {
+        for (std::size_t i = 0; i != c.items.size(); ++i)
+        {
+            char const* first = c.items[i].first;
+            T n = 0;
+            qi::parse(first, c.items[i].second, p, n);
+            sum += n;
+        }
+        state.bytes += c.text.size();
+        state.items += c.items.size();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(strtol_int, "int", "baseline")
+{
+    suite::corpus const& c = suite::ints();
+    long sum = 0;
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+        sum += std::strtol(c.items[i].first, 0, 10);
+    state.checksum += static_cast<std::size_t>(sum);
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_int, "int", "x3")
+{
+    int sum = 0;
+    parse_all(suite::ints(), x3::int_, sum, state);
+    state.checksum += static_cast<std::size_t>(sum);
+}
+
+BOOST_SPIRIT_BENCHMARK(qi_int, "int", "qi")
+{
+    int sum = 0;
+    qi_parse_all(suite::ints(), qi::int_, sum, state);
+    state.checksum += static_cast<std::size_t>(sum);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(strtod_real, "real", "baseline")
+{
+    suite::corpus const& c = suite::reals();
+    double sum = 0;
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+        sum += std::strtod(c.items[i].first, 0);
+    state.checksum += sum != 0;
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_double, "real", "x3")
+{
+    double sum = 0;
+    parse_all(suite::reals(), x3::double_, sum, state);
+    state.checksum += sum != 0;
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_double_fast, "real", "x3")
+{
+    x3::real_parser<double, x3::fast_real_policies<double> > const
+        fast_double = {};
+    double sum = 0;
+    parse_all(suite::reals(), fast_double, sum, state);
+    state.checksum += sum != 0;
+}
+
+BOOST_SPIRIT_BENCHMARK(qi_double, "real", "qi")
+{
+    double sum = 0;
+    qi_parse_all(suite::reals(), qi::double_, sum, state);
+    state.checksum += sum != 0;
+}
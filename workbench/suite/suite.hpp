@@ -0,0 +1,81 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+#if !defined(BOOST_SPIRIT_WORKBENCH_SUITE_HPP)
+#define BOOST_SPIRIT_WORKBENCH_SUITE_HPP
+
+#include <boost/preprocessor/cat.hpp>
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+//  A small registry of benchmarks shared by all the translation units of the
+//  suite. A benchmark processes its whole corpus once per call and reports
+//  what it did through the state object:
+//
+//      BOOST_SPIRIT_BENCHMARK(x3_int, "int", "x3")
+//      {
+//          for (...)
+//              state.checksum += parse_one(...);
+//          state.bytes += corpus.size();
+//          state.items += count;
+//      }
+//
+//  The runner in main.cpp times repeated calls and counts the heap
+//  allocations made by them.
+///////////////////////////////////////////////////////////////////////////////
+namespace suite
+{
+    struct state
+    {
+        state() : bytes(0), items(0), checksum(0) {}
+
+        std::size_t bytes;      // input consumed or output produced
+        std::size_t items;      // numbers, tokens, values, ...
+        std::size_t checksum;   // keeps the optimizer honest
+    };
+
+    typedef void (*function_type)(state&);
+
+    struct benchmark
+    {
+        char const* name;
+        char const* family;     // what is measured: "int", "json", ...
+        char const* library;    // "x3", "qi", "karma", "lex" or "baseline"
+        function_type f;
+    };
+
+    inline std::vector<benchmark>& registry()
+    {
+        static std::vector<benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct registrar
+    {
+        registrar(char const* name, char const* family, char const* library
+          , function_type f)
+        {
+            benchmark b = { name, family, library, f };
+            registry().push_back(b);
+        }
+    };
+
+    // Heap allocations since program start, counted by the replacement
+    // operator new in main.cpp.
+    std::size_t allocations();
+    std::size_t allocated_bytes();
+}
+
+#define BOOST_SPIRIT_BENCHMARK(name, family, library)                       \
+    static void BOOST_PP_CAT(benchmark_, name)(suite::state&);              \
+    static suite::registrar const BOOST_PP_CAT(registrar_, name)(           \
+        #name, family, library, &BOOST_PP_CAT(benchmark_, name));           \
+    static void BOOST_PP_CAT(benchmark_, name)(suite::state& state)         \
+    /***/
+
+#endif
@@ -0,0 +1,209 @@
+/*=============================================================================
+    Copyright (c) 2001-2010 Joel de Guzman
+    Copyright (c) 2001-2010 Hartmut Kaiser
+
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+///////////////////////////////////////////////////////////////////////////////
+//  Symbol table lookups and quoted string parsing
+///////////////////////////////////////////////////////////////////////////////
+#include "suite.hpp"
+#include "corpus.hpp"
+
+#include <boost/spirit/include/qi.hpp>
+#include <boost/spirit/home/x3.hpp>
+#include <boost/spirit/home/x3/string/frozen_tst.hpp>
+#include <map>
+#include <string>
+
+namespace qi = boost::spirit::qi;
+namespace x3 = boost::spirit::x3;
+
+namespace
+{
+    // Parse every word of the symbols corpus with p, the longest matching
+    // keyword must cover the whole word.
+    template <typename Symbols>
+    void x3_lookup_all(Symbols const& sym, suite::state& state)
+    {
+        suite::corpus const& c = suite::symbols();
+        for (std::size_t i = 0; i != c.items.size(); ++i)
+        {
+            char const* first = c.items[i].first;
+            int n = 0;
+            if (x3::parse(first, c.items[i].second, sym, n) &&
+                first == c.items[i].second)
+            {
+                state.checksum += n;
+            }
+        }
+        state.bytes += c.text.size();
+        state.items += c.items.size();
+    }
+
+    // Adds the keywords to sym, returns true for use in static initializers
+    // (qi::symbols overloads the comma operator).
+    template <typename Symbols>
+    bool fill(Symbols& sym)
+    {
+        std::vector<std::string> const& kw = suite::keywords();
+        for (std::size_t i = 0; i != kw.size(); ++i)
+            sym.add(kw[i], int(i));
+        return true;
+    }
+
+    template <typename Symbols>
+    bool fill_and_freeze(Symbols& sym)
+    {
+        fill(sym);
+        sym.freeze();
+        return true;
+    }
+
+    x3::symbols<int> const& x3_symbols()
+    {
+        static x3::symbols<int> sym;
+        static bool filled = fill(sym);
+        (void)filled;
+        return sym;
+    }
+
+    typedef x3::symbols_parser<boost::spirit::char_encoding::standard
+      , int, x3::frozen_tst<char, int> > frozen_symbols;
+
+    frozen_symbols const& x3_frozen_symbols()
+    {
+        static frozen_symbols sym;
+        static bool filled = fill_and_freeze(sym);
+        (void)filled;
+        return sym;
+    }
+
+    qi::symbols<char, int> const& qi_symbols()
+    {
+        static qi::symbols<char, int> sym;
+        static bool filled = fill(sym);
+        (void)filled;
+        return sym;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BOOST_SPIRIT_BENCHMARK(std_map_symbols, "symbols", "baseline")
+{
+    static std::map<std::string, int> table;
+    if (table.empty())
+    {
+        std::vector<std::string> const& kw = suite::keywords();
+        for (std::size_t i = 0; i != kw.size(); ++i)
+            table[kw[i]] = int(i);
+    }
+
+    // the lookup key is built in a reused buffer to not count allocations
+    // of the key against the table
+    suite::corpus const& c = suite::symbols();
+    std::string key;
+    key.reserve(64);
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+    {
+        key.assign(c.items[i].first, c.items[i].second);
+        std::map<std::string, int>::const_iterator it = table.find(key);
+        if (it != table.end())
+            state.checksum += it->second;
+    }
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_symbols, "symbols", "x3")
+{
+    x3_lookup_all(x3_symbols(), state);
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_symbols_frozen, "symbols", "x3")
+{
+    x3_lookup_all(x3_frozen_symbols(), state);
+}
+
+BOOST_SPIRIT_BENCHMARK(qi_symbols, "symbols", "qi")
+{
+    qi::symbols<char, int> const& sym = qi_symbols();
+    suite::corpus const& c = suite::symbols();
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+    {
+        char const* first = c.items[i].first;
+        int n = 0;
+        if (qi::parse(first, c.items[i].second, sym, n) &&
+            first == c.items[i].second)
+        {
+            state.checksum += n;
+        }
+    }
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//  Quoted strings with \" and \\ escapes, unescaped into a reused std::string
+BOOST_SPIRIT_BENCHMARK(hand_written_string, "string", "baseline")
+{
+    suite::corpus const& c = suite::strings();
+    std::string s;
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+    {
+        char const* first = c.items[i].first;
+        char const* last = c.items[i].second;
+        s.clear();
+        if (first == last || *first != '"')
+            continue;
+        for (++first; first != last && *first != '"'; ++first)
+        {
+            if (*first == '\\' && ++first == last)
+                break;
+            s += *first;
+        }
+        state.checksum += s.size();
+    }
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(x3_string, "string", "x3")
+{
+    using x3::char_;
+    using x3::lexeme;
+
+    suite::corpus const& c = suite::strings();
+    std::string s;
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+    {
+        char const* first = c.items[i].first;
+        s.clear();
+        x3::parse(first, c.items[i].second
+          , lexeme['"' >> *(('\\' >> char_) | ~char_('"')) >> '"'], s);
+        state.checksum += s.size();
+    }
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}
+
+BOOST_SPIRIT_BENCHMARK(qi_string, "string", "qi")
+{
+    using qi::char_;
+    using qi::lexeme;
+
+    suite::corpus const& c = suite::strings();
+    std::string s;
+    for (std::size_t i = 0; i != c.items.size(); ++i)
+    {
+        char const* first = c.items[i].first;
+        s.clear();
+        qi::parse(first, c.items[i].second
+          , lexeme['"' >> *(('\\' >> char_) | ~char_('"')) >> '"'], s);
+        state.checksum += s.size();
+    }
+    state.bytes += c.text.size();
+    state.items += c.items.size();
+}